@@ -0,0 +1,96 @@
+# 
+# The MIT License
+# 
+# Copyright (c) 2021 Sebastian Bauer
+# 
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+# 
+# Finds the number of constexpr steps of every case in constexpr_steps.cpp, i.e. the lowest
+# -fconstexpr-ops-limit (gcc) or -fconstexpr-steps (clang) the case still compiles with.
+#
+# cmake -DCXX=<compiler> -DCXX_ID=<GNU|Clang> -DINCLUDE_DIR=<dir> -DSOURCE=<file> [-DOUTPUT=<file>] -P constexpr_steps.cmake
+cmake_minimum_required(VERSION 3.15)
+
+set(case_names penalty_score_v1 qr_v1_char qr_v1_module qr_auto_version micro_qr_m2)
+
+if (CXX_ID STREQUAL "GNU")
+    set(limit_flag "-fconstexpr-ops-limit=")
+    set(extra_flags "-fconstexpr-depth=9999999")
+elseif (CXX_ID MATCHES "Clang")
+    set(limit_flag "-fconstexpr-steps=")
+    set(extra_flags "")
+else ()
+    message(FATAL_ERROR "constexpr step counts are only known for gcc and clang")
+endif ()
+
+function(compiles case limit result)
+    execute_process(
+        COMMAND ${CXX} -std=c++20 -fsyntax-only -w ${extra_flags} ${limit_flag}${limit}
+            -I${INCLUDE_DIR} -DQRCODE_CONSTEXPR_CASE=${case} ${SOURCE}
+        RESULT_VARIABLE exit_code
+        OUTPUT_QUIET ERROR_QUIET)
+    if (exit_code EQUAL 0)
+        set(${result} TRUE PARENT_SCOPE)
+    else ()
+        set(${result} FALSE PARENT_SCOPE)
+    endif ()
+endfunction()
+
+# doubles the limit until the case compiles, then bisects down to 1% of the limit
+function(count_steps case result)
+    set(high 65536)
+    compiles(${case} ${high} ok)
+    while (NOT ok)
+        math(EXPR high "${high} * 2")
+        if (high GREATER 4000000000)
+            set(${result} "failed" PARENT_SCOPE)
+            return()
+        endif ()
+        compiles(${case} ${high} ok)
+    endwhile ()
+
+    math(EXPR low "${high} / 2")
+    math(EXPR gap "${high} - ${low}")
+    math(EXPR precision "${high} / 100")
+    while (gap GREATER precision)
+        math(EXPR middle "(${low} + ${high}) / 2")
+        compiles(${case} ${middle} ok)
+        if (ok)
+            set(high ${middle})
+        else ()
+            set(low ${middle})
+        endif ()
+        math(EXPR gap "${high} - ${low}")
+    endwhile ()
+    set(${result} ${high} PARENT_SCOPE)
+endfunction()
+
+set(report "")
+list(LENGTH case_names case_count)
+math(EXPR last_case "${case_count} - 1")
+foreach (case RANGE ${last_case})
+    list(GET case_names ${case} name)
+    count_steps(${case} steps)
+    message(STATUS "${name}: ${steps} steps")
+    string(APPEND report "${name} ${steps}\n")
+endforeach ()
+
+if (OUTPUT)
+    file(WRITE ${OUTPUT} ${report})
+endif ()
@@ -0,0 +1,49 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// every case is a single constant evaluation, selected by QRCODE_CONSTEXPR_CASE;
+// constexpr_steps.cmake compiles this file with decreasing step limits to find its cost
+
+#include <string_view>
+
+#include <qrcode/qrcode.h>
+
+using namespace std::literals;
+using namespace qrcode;
+
+#if QRCODE_CONSTEXPR_CASE == 0
+constexpr auto evaluated = qr::penalty_score(structure::matrix<char>{{21,21}, '+'});
+#elif QRCODE_CONSTEXPR_CASE == 1
+constexpr auto evaluated = qr::make_symbol<char>("01234567"sv, qr::symbol_version{1}, qr::error_correction::level_M);
+#elif QRCODE_CONSTEXPR_CASE == 2
+constexpr auto evaluated = qr::make_symbol("01234567"sv, qr::symbol_version{1}, qr::error_correction::level_M);
+#elif QRCODE_CONSTEXPR_CASE == 3
+constexpr auto evaluated = qr::make_symbol<char>("HELLO WORLD 0123456789 ABCDEFGHIJ"sv, qr::error_correction::level_Q);
+#elif QRCODE_CONSTEXPR_CASE == 4
+constexpr auto evaluated = micro_qr::make_symbol<char>("0123456789"sv, micro_qr::symbol_version::M2, micro_qr::error_correction::level_L);
+#endif
+
+int main()
+{
+}
@@ -0,0 +1,276 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "perf_counters.h"
+
+namespace qrcode::bench
+{
+    using bench_clock = std::chrono::steady_clock;
+
+    // keeps the compiler from dropping work whose result is otherwise unused
+    template<class T>
+    inline auto keep(T const& value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r"(&value) : "memory");
+#else
+        static auto volatile sink = static_cast<void const*>(nullptr);
+        sink = &value;
+#endif
+    }
+
+    struct stage_statistics
+    {
+        std::int64_t min_ns = 0;
+        std::int64_t median_ns = 0;
+        std::int64_t mean_ns = 0;
+        counter_values counters = {};
+    };
+
+    // the hardware counters are optional, they are read around every single run of a stage
+    struct measurement
+    {
+        int iterations = 1;
+        perf_counters* counters = nullptr;
+    };
+
+    [[nodiscard]] inline auto make_statistics(std::vector<std::int64_t> samples)
+    {
+        if (samples.empty())
+            return stage_statistics{};
+
+        std::ranges::sort(samples);
+        auto sum = std::int64_t{0};
+        for (auto i : samples)
+            sum += i;
+
+        return stage_statistics{
+            .min_ns = samples.front(),
+            .median_ns = samples[samples.size() / 2],
+            .mean_ns = sum / static_cast<std::int64_t>(samples.size())
+        };
+    }
+
+    // runs a stage the given number of times, every run starts from a fresh copy of the input
+    // made outside of the measurement; returns the output of the last run
+    template<class Input, class Stage>
+    [[nodiscard]] auto measure(
+        measurement const& setup, Input const& input, Stage stage, stage_statistics& statistics)
+    {
+        auto samples = std::vector<std::int64_t>{};
+        samples.reserve(static_cast<std::size_t>(setup.iterations));
+
+        for (auto i = 1; ; ++i)
+        {
+            auto copy = input;
+            if (setup.counters)
+                setup.counters->start();
+            auto const begin = bench_clock::now();
+            auto output = stage(std::move(copy));
+            auto const end = bench_clock::now();
+            if (setup.counters)
+                setup.counters->stop();
+            keep(output);
+
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+            if (i >= setup.iterations)
+            {
+                statistics = make_statistics(std::move(samples));
+                if (setup.counters)
+                    statistics.counters = setup.counters->take();
+                return output;
+            }
+        }
+    }
+
+    struct stage_result
+    {
+        std::string_view stage;
+        stage_statistics statistics;
+    };
+
+    struct case_result
+    {
+        std::string_view symbol;
+        std::string version;
+        std::string_view error_level;
+        std::string_view mode;
+        std::string_view module;
+        std::size_t message_length = 0;
+        std::size_t data_bits = 0;
+        std::vector<stage_result> stages;
+    };
+
+    [[nodiscard]] inline auto has_counters(counter_values const& values) noexcept
+    {
+        return std::ranges::any_of(values, [](auto const& value) { return value.has_value(); });
+    }
+
+    inline auto write_counters(std::ostream& stream, counter_values const& values)
+    {
+        stream << "{";
+        for (auto i = std::size_t{0}; i != counters.size(); ++i)
+        {
+            stream << (i == 0 ? "\"" : ", \"") << name(counters[i]) << "\": ";
+            if (values[i])
+                stream << static_cast<std::int64_t>(*values[i]);
+            else
+                stream << "null";
+        }
+        stream << "}";
+    }
+
+    inline auto write_statistics(std::ostream& stream, stage_statistics const& statistics)
+    {
+        stream 
+            << "{\"min_ns\": " << statistics.min_ns 
+            << ", \"median_ns\": " << statistics.median_ns 
+            << ", \"mean_ns\": " << statistics.mean_ns;
+        if (has_counters(statistics.counters))
+        {
+            stream << ", \"counters\": ";
+            write_counters(stream, statistics.counters);
+        }
+        stream << "}";
+    }
+
+    // the counters of all cases of a symbol version, averaged per stage
+    struct version_table
+    {
+        struct row
+        {
+            std::string_view stage;
+            std::array<double, counters.size()> sums = {};
+            std::array<int, counters.size()> samples = {};
+        };
+
+        std::string_view symbol;
+        std::string version;
+        std::vector<row> rows;
+    };
+
+    [[nodiscard]] inline auto make_version_tables(std::vector<case_result> const& results)
+    {
+        auto tables = std::vector<version_table>{};
+        for (auto const& result : results)
+        {
+            auto table = std::ranges::find_if(tables, [&](auto const& t) 
+            { 
+                return t.symbol == result.symbol && t.version == result.version; 
+            });
+            if (table == tables.end())
+                table = tables.insert(tables.end(), version_table{result.symbol, result.version, {}});
+
+            for (auto const& [stage, statistics] : result.stages)
+            {
+                auto row = std::ranges::find(table->rows, stage, &version_table::row::stage);
+                if (row == table->rows.end())
+                    row = table->rows.insert(table->rows.end(), version_table::row{.stage = stage});
+
+                for (auto i = std::size_t{0}; i != counters.size(); ++i)
+                    if (statistics.counters[i])
+                    {
+                        row->sums[i] += *statistics.counters[i];
+                        ++row->samples[i];
+                    }
+            }
+        }
+        return tables;
+    }
+
+    inline auto write_version_tables(std::ostream& stream, std::vector<case_result> const& results)
+    {
+        auto const tables = make_version_tables(results);
+
+        stream << ",\n  \"version_tables\": [";
+        for (auto i = std::size_t{0}; i != tables.size(); ++i)
+        {
+            stream 
+                << (i == 0 ? "\n" : ",\n")
+                << "    {\"symbol\": \"" << tables[i].symbol 
+                << "\", \"version\": \"" << tables[i].version 
+                << "\", \"stages\": {";
+
+            for (auto j = std::size_t{0}; j != tables[i].rows.size(); ++j)
+            {
+                auto const& row = tables[i].rows[j];
+                auto means = counter_values{};
+                for (auto k = std::size_t{0}; k != counters.size(); ++k)
+                    if (row.samples[k] != 0)
+                        means[k] = row.sums[k] / row.samples[k];
+
+                stream << (j == 0 ? "" : ", ") << "\"" << row.stage << "\": ";
+                write_counters(stream, means);
+            }
+            stream << "}}";
+        }
+        stream << "\n  ]";
+    }
+
+    // names are plain identifiers, nothing needs to be escaped
+    inline auto write_json(std::ostream& stream, int iterations, std::vector<case_result> const& results)
+    {
+        stream << "{\n  \"library\": \"libqrcode\",\n  \"iterations\": " << iterations << ",\n  \"results\": [";
+        for (auto i = std::size_t{0}; i != results.size(); ++i)
+        {
+            auto const& result = results[i];
+            stream 
+                << (i == 0 ? "\n" : ",\n")
+                << "    {\"symbol\": \"" << result.symbol 
+                << "\", \"version\": \"" << result.version 
+                << "\", \"error_level\": \"" << result.error_level 
+                << "\", \"mode\": \"" << result.mode 
+                << "\", \"module\": \"" << result.module 
+                << "\", \"message_length\": " << result.message_length 
+                << ", \"data_bits\": " << result.data_bits 
+                << ", \"stages\": {";
+
+            for (auto j = std::size_t{0}; j != result.stages.size(); ++j)
+            {
+                stream << (j == 0 ? "" : ", ") << "\"" << result.stages[j].stage << "\": ";
+                write_statistics(stream, result.stages[j].statistics);
+            }
+            stream << "}}";
+        }
+        stream << "\n  ]";
+
+        auto const counted = std::ranges::any_of(results, [](auto const& result)
+        {
+            return std::ranges::any_of(result.stages, [](auto const& s) { return has_counters(s.statistics.counters); });
+        });
+        if (counted)
+            write_version_tables(stream, results);
+        stream << "\n}\n";
+    }
+}
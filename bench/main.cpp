@@ -0,0 +1,417 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <qrcode/qrcode.h>
+#include <qrcode/svg.h>
+
+#include "harness.h"
+
+using namespace qrcode;
+using namespace qrcode::bench;
+
+namespace
+{
+    enum class data_mode { numeric, alphanumeric, byte, kanji };
+
+    inline constexpr auto data_modes = std::array{
+        data_mode::numeric, data_mode::alphanumeric, data_mode::byte, data_mode::kanji};
+
+    [[nodiscard]] constexpr auto name(data_mode mode) noexcept -> std::string_view
+    {
+        switch (mode)
+        {
+        case data_mode::numeric: return "numeric";
+        case data_mode::alphanumeric: return "alphanumeric";
+        case data_mode::byte: return "byte";
+        case data_mode::kanji: return "kanji";
+        }
+        return "";
+    }
+
+    template<class Module> inline constexpr auto module_name = std::string_view{"module"};
+    template<> inline constexpr auto module_name<char> = std::string_view{"char"};
+    template<> inline constexpr auto module_name<int> = std::string_view{"int"};
+
+    [[nodiscard]] constexpr auto name(qr::error_correction level) noexcept -> std::string_view
+    {
+        constexpr auto names = std::array<std::string_view, 4>{"L", "M", "Q", "H"};
+        return names[static_cast<std::size_t>(number(level))];
+    }
+
+    [[nodiscard]] constexpr auto name(std::optional<micro_qr::error_correction> level) noexcept -> std::string_view
+    {
+        constexpr auto names = std::array<std::string_view, 3>{"L", "M", "Q"};
+        return level ? names[static_cast<std::size_t>(number(*level))] : "-";
+    }
+
+    // every character of a message belongs to the same mode, so the optimizer picks a single segment;
+    // kanji characters are two bytes of shift jis
+    [[nodiscard]] auto make_message(data_mode mode, std::size_t length)
+    {
+        auto message = std::string{};
+        for (auto i = std::size_t{0}; i != length; ++i)
+        {
+            switch (mode)
+            {
+            case data_mode::numeric: message.push_back(static_cast<char>('0' + i % 10)); break;
+            case data_mode::alphanumeric: message.push_back(static_cast<char>('A' + i % 26)); break;
+            case data_mode::byte: message.push_back(static_cast<char>('a' + i % 26)); break;
+            case data_mode::kanji: message.append("\x93\x5F"); break;
+            }
+        }
+        return message;
+    }
+
+    // starts at the number of characters the data bits would hold without any header
+    // and removes characters until the message fits
+    template<class Fits>
+    [[nodiscard]] auto fill_message(data_mode mode, int data_bits, Fits fits)
+    {
+        auto const bits = static_cast<std::size_t>(data_bits);
+        auto length = [&]
+        {
+            switch (mode)
+            {
+            case data_mode::numeric: return bits * 3 / 10;
+            case data_mode::alphanumeric: return bits * 2 / 11;
+            case data_mode::byte: return bits / 8;
+            case data_mode::kanji: return bits / 13;
+            }
+            return std::size_t{0};
+        }();
+
+        for (; length != 0; --length)
+        {
+            auto message = make_message(mode, length);
+            if (fits(message))
+                return message;
+        }
+        return std::string{};
+    }
+
+    template<std::ranges::input_range Bits>
+    [[nodiscard]] auto collect(Bits&& bits)
+    {
+        auto collected = std::vector<bool>{};
+        for (bool i : bits)
+            collected.push_back(i);
+        return collected;
+    }
+
+    template<class Symbol>
+    [[nodiscard]] auto render_svg(Symbol const& symbol)
+    {
+        auto stream = std::ostringstream{};
+        svg(stream, symbol);
+        return std::move(stream).str();
+    }
+
+    // the stages of make_symbol one after another, each one fed with the output of the one before
+    template<class Encode, class Code_Bits>
+    [[nodiscard]] auto run_code_stages(
+        measurement const& setup, case_result& result, std::string const& message, Encode encode, Code_Bits make_code_bits)
+    {
+        auto statistics = stage_statistics{};
+
+        auto const stream = measure(setup, message, encode, statistics);
+        result.stages.push_back({"encode_data", statistics});
+
+        auto const data_bits = collect(stream.get());
+        result.data_bits = data_bits.size();
+
+        auto bits = measure(setup, data_bits, make_code_bits, statistics);
+        result.stages.push_back({"code_bits", statistics});
+        return bits;
+    }
+
+    template<class Place, class Finalize>
+    [[nodiscard]] auto run_symbol_stages(
+        measurement const& setup, case_result& result, std::vector<bool> const& bits, Place place, Finalize finalize)
+    {
+        auto statistics = stage_statistics{};
+
+        auto const raw_code = measure(setup, bits, place, statistics);
+        result.stages.push_back({"make_raw_code", statistics});
+
+        auto symbol = measure(setup, raw_code, finalize, statistics);
+        result.stages.push_back({"finalize", statistics});
+        return symbol;
+    }
+
+    template<class Symbol, class Score>
+    auto run_output_stages(measurement const& setup, case_result& result, Symbol const& symbol, Score score)
+    {
+        auto statistics = stage_statistics{};
+
+        [[maybe_unused]] auto const penalty = measure(setup, modules(symbol), score, statistics);
+        result.stages.push_back({"penalty_score", statistics});
+
+        [[maybe_unused]] auto const document = measure(
+            setup, symbol, [](auto symbol) { return render_svg(symbol); }, statistics);
+        result.stages.push_back({"svg", statistics});
+    }
+
+    // int modules hold no more than the color, so data, function and free modules cannot be told apart;
+    // placement and masking are not possible, the finished symbol is converted instead
+    template<class Designator>
+    [[nodiscard]] auto as_int_symbol(symbol<char, Designator> const& symbol)
+    {
+        using qrcode::structure::module_traits;
+
+        auto code = matrix<int>{size(symbol)};
+        for (auto i : views::horizontal({0,0}, size(symbol)))
+            element_at(code, i) = module_traits<int>::make_data(module_traits<char>::is_set(element_at(modules(symbol), i)));
+        return qrcode::symbol<int, Designator>{designator(symbol), mask_pattern(symbol), std::move(code)};
+    }
+
+    // placement and masking run with char modules for int symbols, their timings are left out
+    template<class Module, class Place, class Finalize, class Score>
+    auto run_module_stages(
+        measurement const& setup, case_result& result, std::vector<bool> const& bits, 
+        Place place, Finalize finalize, Score score)
+    {
+        if constexpr (std::same_as<Module, int>)
+        {
+            auto ignored = case_result{};
+            auto const symbol = run_symbol_stages(measurement{}, ignored, bits, place, finalize);
+            run_output_stages(setup, result, as_int_symbol(symbol), score);
+        }
+        else
+        {
+            auto const symbol = run_symbol_stages(setup, result, bits, place, finalize);
+            run_output_stages(setup, result, symbol, score);
+        }
+    }
+
+    template<class Module>
+    [[nodiscard]] auto run_qr_case(
+        measurement const& setup, qr::symbol_version version, qr::error_correction level, data_mode mode)
+        -> std::optional<case_result>
+    {
+        using namespace qrcode::qr;
+        using qrcode::structure::matrix;
+
+        auto const designator = symbol_designator{version, level};
+        auto const category = make_version_category(version);
+        auto const capacity = make_code_capacity(designator);
+
+        auto const message = fill_message(mode, total_data_bits(capacity), [&](auto const& message)
+        {
+            return data_length(message, category) <= total_data_bits(capacity);
+        });
+        if (message.empty())
+            return std::nullopt;
+
+        auto result = case_result{
+            .symbol = "qr", 
+            .version = std::to_string(version.number), 
+            .error_level = name(level), 
+            .mode = name(mode), 
+            .module = module_name<Module>, 
+            .message_length = message.size(),
+            .stages = {}
+        };
+        using build_module = std::conditional_t<std::same_as<Module, int>, char, Module>;
+        auto const bits = run_code_stages(setup, result, message,
+            [&](std::string message) { return encode_data(message, category); },
+            [&](std::vector<bool> bits) { return collect(code_bits(bits, capacity)); });
+        run_module_stages<Module>(setup, result, bits,
+            [&](std::vector<bool> bits) { return make_raw_code<build_module>(version, bits); },
+            [&](matrix<build_module> code) { return finalize(std::move(code), designator); },
+            [](matrix<Module> code) { return penalty_score(code); });
+        return result;
+    }
+
+    template<class Module>
+    [[nodiscard]] auto run_micro_qr_case(
+        measurement const& setup, 
+        micro_qr::symbol_version version, 
+        std::optional<micro_qr::error_correction> level, 
+        data_mode mode) -> std::optional<case_result>
+    {
+        using namespace qrcode::micro_qr;
+        using qrcode::data::bit_stream;
+        using qrcode::structure::matrix;
+
+        // versions without a designator of their own for the missing error level are skipped
+        auto const designator = make_designator(version, level);
+        if (!designator || error_level(*designator) != level)
+            return std::nullopt;
+
+        auto const encoders = available_encoders(version);
+        auto const capacity = make_code_capacity(*designator);
+
+        auto const message = fill_message(mode, total_data_bits(capacity), [&](auto const& message)
+        {
+            auto const length = qrcode::data::best_fit::data_length(encoders, message);
+            return length && *length <= total_data_bits(capacity);
+        });
+        if (message.empty())
+            return std::nullopt;
+
+        auto result = case_result{
+            .symbol = "micro_qr", 
+            .version = "M" + std::to_string(number(version) + 1), 
+            .error_level = name(level), 
+            .mode = name(mode), 
+            .module = module_name<Module>, 
+            .message_length = message.size(),
+            .stages = {}
+        };
+        using build_module = std::conditional_t<std::same_as<Module, int>, char, Module>;
+        auto const bits = run_code_stages(setup, result, message,
+            [&](std::string message) 
+            { 
+                auto stream = bit_stream{};
+                [[maybe_unused]] auto const success = qrcode::data::best_fit::encode_data(stream, encoders, message);
+                return stream; 
+            },
+            [&](std::vector<bool> bits) { return collect(code_bits(bits, capacity)); });
+        run_module_stages<Module>(setup, result, bits,
+            [&](std::vector<bool> bits) { return make_raw_code<build_module>(version, bits); },
+            [&](matrix<build_module> code) { return finalize(std::move(code), *designator); },
+            [](matrix<Module> code) { return penalty_score(code); });
+        return result;
+    }
+
+    template<class Module>
+    auto run_cases(measurement const& setup, std::vector<case_result>& results)
+    {
+        constexpr auto qr_levels = std::array{
+            qr::error_correction::level_L, qr::error_correction::level_M, 
+            qr::error_correction::level_Q, qr::error_correction::level_H};
+        constexpr auto micro_qr_levels = std::array{
+            std::optional<micro_qr::error_correction>{}, 
+            std::optional{micro_qr::error_correction::level_L}, 
+            std::optional{micro_qr::error_correction::level_M}, 
+            std::optional{micro_qr::error_correction::level_Q}};
+
+        std::cerr << "module type " << module_name<Module> << "\n";
+        for (auto version : micro_qr::versions())
+        for (auto level : micro_qr_levels)
+        for (auto mode : data_modes)
+            if (auto result = run_micro_qr_case<Module>(setup, version, level, mode))
+                results.push_back(std::move(*result));
+
+        for (auto number = 1; number <= 40; ++number)
+        {
+            for (auto level : qr_levels)
+            for (auto mode : data_modes)
+                if (auto result = run_qr_case<Module>(setup, qr::symbol_version{number}, level, mode))
+                    results.push_back(std::move(*result));
+            std::cerr << "  version " << number << " done\n";
+        }
+    }
+
+    struct arguments
+    {
+        int iterations = 5;
+        bool counters = false;
+        std::optional<std::string> output_file;
+    };
+
+    [[nodiscard]] auto print_usage(std::ostream& stream, std::string_view program_name)
+    {
+        stream << "usage: " << program_name << " [--iterations <count>] [--counters] [--output <file>]\n";
+    }
+
+    [[nodiscard]] auto parse_arguments(int argc, char** argv) -> std::optional<arguments>
+    {
+        auto options = arguments{};
+        for (auto i = 1; i < argc; ++i)
+        {
+            auto const option = std::string_view{argv[i]};
+            if (option == "--counters")
+            {
+                options.counters = true;
+                continue;
+            }
+            if (i + 1 == argc)
+                return std::nullopt;
+
+            auto const value = std::string_view{argv[++i]};
+            if (option == "--iterations")
+            {
+                auto const [end, error] = std::from_chars(value.data(), value.data() + value.size(), options.iterations);
+                if (error != std::errc{} || end != value.data() + value.size() || options.iterations < 1)
+                    return std::nullopt;
+            }
+            else if (option == "--output")
+                options.output_file = std::string{value};
+            else
+                return std::nullopt;
+        }
+        return options;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    auto const options = parse_arguments(argc, argv);
+    if (!options)
+    {
+        print_usage(std::cerr, argv[0]);
+        return 1;
+    }
+
+    auto counters = std::optional<perf_counters>{};
+    if (options->counters)
+    {
+        counters.emplace();
+        if (!failure(*counters).empty())
+            std::cerr << "hardware counters " << (available(*counters) ? "partly" : "not") 
+                << " available (" << failure(*counters) << ")\n";
+    }
+
+    auto const setup = measurement{
+        .iterations = options->iterations, 
+        .counters = counters && available(*counters) ? &*counters : nullptr
+    };
+    auto results = std::vector<case_result>{};
+    run_cases<char>(setup, results);
+    run_cases<int>(setup, results);
+    run_cases<structure::module>(setup, results);
+
+    if (!options->output_file)
+    {
+        write_json(std::cout, options->iterations, results);
+        return 0;
+    }
+
+    auto file = std::ofstream{*options->output_file};
+    write_json(file, options->iterations, results);
+    return file ? 0 : 1;
+}
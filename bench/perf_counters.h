@@ -0,0 +1,217 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace qrcode::bench
+{
+    enum class counter { cycles, instructions, branch_misses, l1d_misses, llc_misses };
+
+    inline constexpr auto counters = std::array{
+        counter::cycles, counter::instructions, counter::branch_misses, counter::l1d_misses, counter::llc_misses};
+
+    [[nodiscard]] constexpr auto name(counter c) noexcept -> std::string_view
+    {
+        switch (c)
+        {
+        case counter::cycles: return "cycles";
+        case counter::instructions: return "instructions";
+        case counter::branch_misses: return "branch_misses";
+        case counter::l1d_misses: return "l1d_misses";
+        case counter::llc_misses: return "llc_misses";
+        }
+        return "";
+    }
+
+    // mean counts per run, counters the machine does not provide stay empty
+    using counter_values = std::array<std::optional<double>, counters.size()>;
+
+    // user space counts of the calling thread; counters which cannot be opened, e.g. inside
+    // of containers or with a restrictive perf_event_paranoid setting, are left out
+    class perf_counters
+    {
+    public:
+        perf_counters() noexcept
+        {
+#if defined(__linux__)
+            for (auto i = std::size_t{0}; i != counters.size(); ++i)
+            {
+                descriptors[i] = open_counter(counters[i]);
+                if (descriptors[i] < 0 && failure.empty())
+                    failure = std::string{name(counters[i])} + ": " + std::strerror(errno);
+            }
+#else
+            failure = "hardware counters are only supported on linux";
+#endif
+        }
+
+        perf_counters(perf_counters const&) = delete;
+        auto operator=(perf_counters const&) -> perf_counters& = delete;
+
+        ~perf_counters()
+        {
+#if defined(__linux__)
+            for (auto descriptor : descriptors)
+                if (descriptor >= 0)
+                    close(descriptor);
+#endif
+        }
+
+        auto start() noexcept -> void
+        {
+#if defined(__linux__)
+            for (auto descriptor : descriptors)
+                if (descriptor >= 0)
+                {
+                    ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+                    ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+                }
+#endif
+        }
+
+        auto stop() noexcept -> void
+        {
+#if defined(__linux__)
+            for (auto descriptor : descriptors)
+                if (descriptor >= 0)
+                    ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+
+            for (auto i = std::size_t{0}; i != counters.size(); ++i)
+                if (descriptors[i] >= 0)
+                {
+                    auto const value = read_scaled(descriptors[i]);
+                    totals[i] += value.value_or(0.0);
+                    lost[i] = lost[i] || !value;
+                }
+            ++runs;
+#endif
+        }
+
+        // the means since the last call
+        [[nodiscard]] auto take() noexcept -> counter_values
+        {
+            auto values = counter_values{};
+            for (auto i = std::size_t{0}; i != counters.size(); ++i)
+                if (descriptors[i] >= 0 && runs != 0 && !lost[i])
+                    values[i] = totals[i] / static_cast<double>(runs);
+
+            totals = {};
+            lost = {};
+            runs = 0;
+            return values;
+        }
+
+        [[nodiscard]] friend auto available(perf_counters const& c) noexcept
+        {
+            for (auto descriptor : c.descriptors)
+                if (descriptor >= 0)
+                    return true;
+            return false;
+        }
+
+        // why the first counter could not be opened, empty if all of them are available
+        [[nodiscard]] friend auto failure(perf_counters const& c) noexcept -> std::string const&
+        {
+            return c.failure;
+        }
+
+    private:
+#if defined(__linux__)
+        [[nodiscard]] static auto open_counter(counter c) noexcept -> int
+        {
+            auto attributes = perf_event_attr{};
+            attributes.size = sizeof(attributes);
+            attributes.disabled = 1;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            auto const cache_miss = [](std::uint64_t cache) 
+            {
+                return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            };
+
+            switch (c)
+            {
+            case counter::cycles: 
+                attributes.type = PERF_TYPE_HARDWARE;
+                attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case counter::instructions: 
+                attributes.type = PERF_TYPE_HARDWARE;
+                attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case counter::branch_misses: 
+                attributes.type = PERF_TYPE_HARDWARE;
+                attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            case counter::l1d_misses: 
+                attributes.type = PERF_TYPE_HW_CACHE;
+                attributes.config = cache_miss(PERF_COUNT_HW_CACHE_L1D);
+                break;
+            case counter::llc_misses: 
+                attributes.type = PERF_TYPE_HW_CACHE;
+                attributes.config = cache_miss(PERF_COUNT_HW_CACHE_LL);
+                break;
+            }
+            return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+        }
+
+        // counts are extrapolated when the kernel multiplexed the counter, 
+        // nothing is known about a counter which was enabled but never ran
+        [[nodiscard]] static auto read_scaled(int descriptor) noexcept -> std::optional<double>
+        {
+            auto values = std::array<std::uint64_t, 3>{};
+            if (read(descriptor, values.data(), sizeof(values)) != static_cast<ssize_t>(sizeof(values)))
+                return std::nullopt;
+
+            auto const [value, enabled, running] = values;
+            if (running == 0)
+                return enabled == 0 ? std::optional{0.0} : std::nullopt;
+            return static_cast<double>(value) * static_cast<double>(enabled) / static_cast<double>(running);
+        }
+#endif
+
+        std::array<int, counters.size()> descriptors = {-1, -1, -1, -1, -1};
+        std::array<double, counters.size()> totals = {};
+        std::array<bool, counters.size()> lost = {};
+        int runs = 0;
+        std::string failure;
+    };
+}
@@ -1,22 +1,51 @@
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <ranges>
 #include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include <qrcode/qrcode.h>
+#include <qrcode/pbm.h>
 #include <qrcode/svg.h>
+#include <qrcode/pipeline/worker_thread.h>
 
 using namespace qrcode;
 using namespace qrcode::qr;
 
 namespace
 {
+    enum class output_format { svg, pbm, packed };
+
     struct arguments
     {
         error_correction error_level = error_correction::level_L;
         std::optional<symbol_version> version = std::nullopt;
         std::optional<eci::assignment_number> eci_number;
         std::string_view message;
+
+        std::optional<std::string_view> batch_file;
+        char delimiter = '\n';
+        output_format format = output_format::svg;
+        std::optional<std::string_view> output_directory;
+        int thread_count = 0;
     };
 
     [[nodiscard]] auto print_designator(std::ostream& stream, arguments const& options)
@@ -60,7 +89,12 @@ namespace
             << "usage: "
             << "echo \"Hello World\" | "
             << program_name
-            << "<error correction level> [<symbol version> <eci_number>]\n";
+            << "<error correction level> [<symbol version> <eci_number>]\n"
+            << "       "
+            << program_name
+            << " --batch <file> [--delimiter newline|nul] [--format svg|pbm|packed]"
+            << " [--output <directory>] [--threads <count>]"
+            << " [--error_level <level>] [--symbol_version <version>] [--eci_number <number>]\n";
     }
 
     [[nodiscard]] auto print_error(std::ostream& stream, error_code error)
@@ -137,13 +171,92 @@ namespace
         return std::pair{current, options};
     }
 
-    [[nodiscard]] auto read_message(std::istream& in)
+    using input_view = std::ranges::basic_istream_view<
+        char, std::istream::char_type, std::istream::traits_type>;
+
+    [[nodiscard]] constexpr auto batch_option(arguments options, char** current, char** next)
+        -> std::optional<std::pair<char**, arguments>>
+    {
+        if (next == nullptr)
+            return std::nullopt;
+
+        options.batch_file = std::string_view{*next};
+        ++current;
+        return std::pair{current, options};
+    }
+
+    [[nodiscard]] constexpr auto delimiter_option(arguments options, char** current, char** next)
+        -> std::optional<std::pair<char**, arguments>>
+    {
+        using namespace std::literals;
+
+        if (next == nullptr)
+            return std::nullopt;
+
+        auto const delimiter = std::string_view{*next};
+        if (delimiter == "newline"sv)
+            options.delimiter = '\n';
+        else if (delimiter == "nul"sv)
+            options.delimiter = '\0';
+        else
+            return std::nullopt;
+
+        ++current;
+        return std::pair{current, options};
+    }
+
+    [[nodiscard]] constexpr auto format_option(arguments options, char** current, char** next)
+        -> std::optional<std::pair<char**, arguments>>
+    {
+        using namespace std::literals;
+
+        if (next == nullptr)
+            return std::nullopt;
+
+        auto const format = std::string_view{*next};
+        if (format == "svg"sv)
+            options.format = output_format::svg;
+        else if (format == "pbm"sv)
+            options.format = output_format::pbm;
+        else if (format == "packed"sv)
+            options.format = output_format::packed;
+        else
+            return std::nullopt;
+
+        ++current;
+        return std::pair{current, options};
+    }
+
+    [[nodiscard]] constexpr auto output_option(arguments options, char** current, char** next)
+        -> std::optional<std::pair<char**, arguments>>
+    {
+        if (next == nullptr)
+            return std::nullopt;
+
+        options.output_directory = std::string_view{*next};
+        ++current;
+        return std::pair{current, options};
+    }
+
+    [[nodiscard]] constexpr auto threads_option(arguments options, char** current, char** next)
+        -> std::optional<std::pair<char**, arguments>>
     {
-        using view = std::ranges::basic_istream_view<
-            char, std::istream::char_type, std::istream::traits_type>;
+        if (next == nullptr)
+            return std::nullopt;
 
+        auto const thread_count = std::atoi(*next);
+        if (thread_count < 1 || thread_count > 1024)
+            return std::nullopt;
+
+        options.thread_count = thread_count;
+        ++current;
+        return std::pair{current, options};
+    }
+
+    [[nodiscard]] auto read_message(std::istream& in)
+    {
         auto message = cx::vector<char>{};
-        for (auto i : view{in})
+        for (auto i : input_view{in})
             message.push_back(i);
         return message;
     }
@@ -157,10 +270,15 @@ namespace
 
         auto options = arguments{};
 
-        auto const dispatch = std::array<std::pair<std::string_view, callback>, 3>{{
+        auto const dispatch = std::array<std::pair<std::string_view, callback>, 8>{{
             {"--error_level"sv, error_level_option},
             {"--symbol_version"sv, symbol_version_option},
-            {"--eci_number"sv, eci_number_option}
+            {"--eci_number"sv, eci_number_option},
+            {"--batch"sv, batch_option},
+            {"--delimiter"sv, delimiter_option},
+            {"--format"sv, format_option},
+            {"--output"sv, output_option},
+            {"--threads"sv, threads_option}
         }};
 
         for (auto i = argv, e = argv + argc; i != e; ++i)
@@ -169,9 +287,10 @@ namespace
                 dispatch, 
                 [current = std::string_view{*i}](auto i) { return i.first == current; });
 
+            auto const next = i+1 != e ? i+1 : nullptr;
             auto const result = found == end(dispatch) 
-                ? message_option(options, i, i+1)
-                : found->second(options, i, i+1);
+                ? message_option(options, i, next)
+                : found->second(options, i, next);
 
             if (!result)
                 return std::nullopt;
@@ -201,6 +320,331 @@ namespace
         
         return do_create_symbol(message, args.version, args.error_level);
     }
+
+    // without eci header the input is encoded while it is read
+    [[nodiscard]] auto create_symbol(arguments const& args, std::istream& in)
+    {
+        if (args.eci_number)
+        {
+            auto const message = read_message(in);
+            return create_symbol(args, std::string_view{cx::begin(message), cx::end(message)});
+        }
+
+        return do_create_symbol(input_view{in}, args.version, args.error_level);
+    }
+
+    // read-only view of a whole file, mapped into memory where the platform allows it
+    class mapped_file
+    {
+    public:
+        explicit mapped_file(char const* path)
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            auto const descriptor = ::open(path, O_RDONLY);
+            if (descriptor < 0)
+                return;
+
+            struct stat status{};
+            if (::fstat(descriptor, &status) == 0 && status.st_size > 0)
+            {
+                auto const length = static_cast<std::size_t>(status.st_size);
+                auto const address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                if (address != MAP_FAILED)
+                {
+                    ::madvise(address, length, MADV_SEQUENTIAL);
+                    content = std::string_view{static_cast<char const*>(address), length};
+                }
+            }
+            opened = status.st_size == 0 || !content.empty();
+            ::close(descriptor);
+#else
+            auto file = std::ifstream{path, std::ios::in | std::ios::binary};
+            opened = static_cast<bool>(file);
+            buffer.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+            content = buffer;
+#endif
+        }
+
+        mapped_file(mapped_file const&) = delete;
+        auto operator=(mapped_file const&) -> mapped_file& = delete;
+
+        ~mapped_file()
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            if (!content.empty())
+                ::munmap(const_cast<char*>(content.data()), content.size());
+#endif
+        }
+
+        [[nodiscard]] explicit operator bool() const noexcept { return opened; }
+        [[nodiscard]] auto view() const noexcept { return content; }
+
+    private:
+        bool opened = false;
+        std::string_view content;
+#if !(defined(__unix__) || defined(__APPLE__))
+        std::string buffer;
+#endif
+    };
+
+    [[nodiscard]] auto split_messages(std::string_view input, char delimiter)
+    {
+        auto messages = std::vector<std::string_view>{};
+        while (!input.empty())
+        {
+            auto const end = std::min(input.find(delimiter), input.size());
+            messages.push_back(input.substr(0, end));
+            input.remove_prefix(std::min(end + 1, input.size()));
+        }
+        return messages;
+    }
+
+    [[nodiscard]] constexpr auto file_extension(output_format format)
+    {
+        using namespace std::literals;
+        switch (format)
+        {
+            case output_format::pbm: return ".pbm"sv;
+            case output_format::packed: return ".bin"sv;
+            default: return ".svg"sv;
+        }
+    }
+
+    // packed: the symbol width as one byte followed by the rows, one bit per module
+    template<class Symbol>
+    [[nodiscard]] auto render(Symbol const& symbol, output_format format)
+    {
+        auto stream = std::ostringstream{};
+        switch (format)
+        {
+            case output_format::svg: 
+                svg(stream, symbol); 
+                break;
+            case output_format::pbm: 
+                pbm(stream, symbol); 
+                break;
+            case output_format::packed:
+                stream << static_cast<char>(width(size(modules(symbol))));
+                qrcode::detail::packed_rows(stream, modules(symbol));
+                break;
+        }
+        return stream.str();
+    }
+
+    using batch_clock = std::chrono::steady_clock;
+
+    struct stage_times
+    {
+        batch_clock::duration encode{};
+        batch_clock::duration render{};
+        batch_clock::duration write{};
+    };
+
+    // rendered symbols are handed over in input order, when they go to a single stream
+    class ordered_output
+    {
+    public:
+        explicit ordered_output(std::size_t count)
+        : slots(count), finished(count, false)
+        {}
+
+        // failed items are put without content, so the following ones are not held up
+        auto put(std::size_t index, std::optional<std::string> content)
+        {
+            {
+                auto const lock = std::scoped_lock{mutex};
+                slots[index] = std::move(content);
+                finished[index] = true;
+            }
+            available.notify_one();
+        }
+
+        template<class Function>
+        auto drain(Function&& write)
+        {
+            for (auto i = std::size_t{0}; i != slots.size(); ++i)
+            {
+                auto content = std::optional<std::string>{};
+                {
+                    auto lock = std::unique_lock{mutex};
+                    available.wait(lock, [&] { return finished[i]; });
+                    content = std::move(slots[i]);
+                }
+                if (content)
+                    write(*content);
+            }
+        }
+
+    private:
+        std::mutex mutex;
+        std::condition_variable available;
+        std::vector<std::optional<std::string>> slots;
+        std::vector<bool> finished;
+    };
+
+    [[nodiscard]] auto milliseconds(batch_clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>{duration}.count();
+    }
+
+    [[nodiscard]] auto print_statistics(
+        std::ostream& stream, 
+        std::vector<batch_clock::duration> latencies, 
+        stage_times const& stages,
+        batch_clock::duration split,
+        batch_clock::duration wall,
+        std::size_t input_size,
+        std::size_t failures,
+        int thread_count)
+    {
+        auto const count = latencies.size();
+        auto const seconds = std::chrono::duration<double>{wall}.count();
+        auto const percentile = [&](double p)
+        {
+            auto const rank = static_cast<std::size_t>(p * static_cast<double>(count) + 0.5);
+            return milliseconds(latencies[std::clamp<std::size_t>(rank, 1, count) - 1]);
+        };
+
+        stream << std::fixed << std::setprecision(3)
+            << "items            " << count << " (" << failures << " failed)\n"
+            << "threads          " << thread_count << "\n"
+            << "wall time        " << milliseconds(wall) << " ms\n";
+        if (count == 0 || seconds == 0)
+            return;
+
+        std::ranges::sort(latencies);
+        stream 
+            << "throughput       " << static_cast<double>(count) / seconds << " symbols/s, " 
+            << static_cast<double>(input_size) / seconds / 1e6 << " MB/s\n"
+            << "latency          p50 " << percentile(0.50) << " ms, p90 " << percentile(0.90) 
+            << " ms, p99 " << percentile(0.99) << " ms, max " << milliseconds(latencies.back()) << " ms\n"
+            << "stage split      " << milliseconds(split) << " ms\n"
+            << "stage encode     " << milliseconds(stages.encode) << " ms (summed over threads)\n"
+            << "stage render     " << milliseconds(stages.render) << " ms (summed over threads)\n"
+            << "stage write      " << milliseconds(stages.write) << " ms\n";
+    }
+
+    // messages are taken from a shared counter, so the workers balance themselves
+    [[nodiscard]] auto run_batch(arguments const& options) -> int
+    {
+        auto const started = batch_clock::now();
+        auto const file = mapped_file{std::string{*options.batch_file}.c_str()};
+        if (!file)
+        {
+            std::cerr << "cannot read " << *options.batch_file << "\n";
+            return 1;
+        }
+        auto const messages = split_messages(file.view(), options.delimiter);
+        auto const split = batch_clock::now() - started;
+
+        auto const directory = options.output_directory 
+            ? std::optional<std::filesystem::path>{*options.output_directory} 
+            : std::nullopt;
+        if (directory)
+        {
+            auto error = std::error_code{};
+            std::filesystem::create_directories(*directory, error);
+            if (error)
+            {
+                std::cerr << "cannot create " << directory->string() << ": " << error.message() << "\n";
+                return 1;
+            }
+        }
+
+        auto const thread_count = options.thread_count != 0 
+            ? options.thread_count 
+            : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+        auto next = std::atomic<std::size_t>{0};
+        auto failures = std::atomic<std::size_t>{0};
+        auto latencies = std::vector<batch_clock::duration>(messages.size());
+        auto worker_stages = std::vector<stage_times>(static_cast<std::size_t>(thread_count));
+        auto output = ordered_output{messages.size()};
+        auto report_mutex = std::mutex{};
+
+        auto const work = [&](stage_times& stages)
+        {
+            for (auto i = next++; i < messages.size(); i = next++)
+            {
+                auto const begin = batch_clock::now();
+                auto const symbol = create_symbol(options, messages[i]);
+                auto const encoded = batch_clock::now();
+                stages.encode += encoded - begin;
+
+                if (!symbol)
+                {
+                    ++failures;
+                    {
+                        auto const lock = std::scoped_lock{report_mutex};
+                        std::cerr << "item " << i << ": ";
+                        print_error(std::cerr, symbol.error());
+                    }
+                    if (!directory)
+                        output.put(i, std::nullopt);
+                    latencies[i] = encoded - begin;
+                    continue;
+                }
+
+                auto content = render(symbol.value(), options.format);
+                auto const rendered = batch_clock::now();
+                stages.render += rendered - encoded;
+
+                if (directory)
+                {
+                    auto name = std::to_string(i);
+                    name += file_extension(options.format);
+                    auto out = std::ofstream{*directory / name, std::ios::out | std::ios::binary};
+                    out.write(content.data(), static_cast<std::streamsize>(content.size()));
+                    if (!out)
+                    {
+                        ++failures;
+                        auto const lock = std::scoped_lock{report_mutex};
+                        std::cerr << "item " << i << ": cannot write " << (*directory / name).string() << "\n";
+                    }
+                }
+                else
+                    output.put(i, std::move(content));
+
+                auto const written = batch_clock::now();
+                stages.write += written - rendered;
+                latencies[i] = written - begin;
+            }
+        };
+
+        // every worker encodes symbols up to the highest version on its own stack
+        auto workers = std::vector<qrcode::pipeline::worker_thread>{};
+        workers.reserve(worker_stages.size());
+        for (auto& i : worker_stages)
+            workers.emplace_back([&work, &i] { work(i); }, qrcode::pipeline::default_stack_size);
+
+        auto stream_write = batch_clock::duration{};
+        if (!directory)
+        {
+            output.drain([&](std::string const& content)
+            {
+                auto const begin = batch_clock::now();
+                std::cout.write(content.data(), static_cast<std::streamsize>(content.size()));
+                stream_write += batch_clock::now() - begin;
+            });
+            std::cout.flush();
+        }
+
+        for (auto& i : workers)
+            i.join();
+
+        auto stages = stage_times{.encode = {}, .render = {}, .write = stream_write};
+        for (auto const& i : worker_stages)
+        {
+            stages.encode += i.encode;
+            stages.render += i.render;
+            stages.write += i.write;
+        }
+
+        print_statistics(
+            std::cerr, std::move(latencies), stages, split, batch_clock::now() - started, 
+            file.view().size(), failures, thread_count);
+        return failures == 0 ? 0 : 1;
+    }
 }
 
 int main(int argc, char** argv)
@@ -212,17 +656,18 @@ int main(int argc, char** argv)
         return 1;
     }
     print_options(std::cerr, *options);
+    if (options->batch_file)
+        return run_batch(*options);
     
-    auto message = options->message;
-    auto std_input = cx::vector<char>{};
-    if (empty(options->message))
-    {
-        std_input = read_message(std::cin);
-        message = std::string_view{cx::begin(std_input), cx::end(std_input)};
-    }
-    print_message(std::cerr, message);
-
-    auto const symbol = create_symbol(*options, message);
+    auto const from_input = empty(options->message);
+    if (from_input)
+        print_message(std::cerr, "(standard input)");
+    else
+        print_message(std::cerr, options->message);
+
+    auto const symbol = from_input 
+        ? create_symbol(*options, std::cin)
+        : create_symbol(*options, options->message);
     if (!symbol)
     {
         print_error(std::cerr, symbol.error());
@@ -20,3 +20,4 @@ class LibqrcodeConan(ConanFile):
         if not self.settings.os == "Windows":
             self.cpp_info.libs.append("stdc++")
             self.cpp_info.libs.append("m")
+            self.cpp_info.system_libs.append("pthread")
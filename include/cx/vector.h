@@ -29,11 +29,13 @@
 
 namespace cx
 {
+    // enough for the modules of the largest symbol
+    inline constexpr auto default_capacity = 40000;
+
     // poor man's constexpr stack-based vector
-    template<class T>
+    template<class T, int N = default_capacity>
     class vector
     {
-        static constexpr auto N = 40000;
         using container = std::array<T,N>;
 
     public:
@@ -167,8 +169,8 @@ namespace cx
     using std::ranges::size;
     using std::ranges::empty;
 
-    template<class T>
-    constexpr auto operator==(cx::vector<T> const& a, cx::vector<T> const& b) noexcept 
+    template<class T, int N>
+    constexpr auto operator==(cx::vector<T, N> const& a, cx::vector<T, N> const& b) noexcept 
     { 
         return std::equal(begin(a), end(a), begin(b), end(b));
     }
@@ -241,6 +243,12 @@ namespace cx::test
         static_assert(cx::vector<char>{}.max_size() == 40000);
     }
 
+    constexpr auto cx_vectors_can_be_given_a_smaller_capacity()
+    {
+        static_assert(cx::vector<char, 16>{}.max_size() == 16);
+        static_assert(size(cx::vector<char, 16>{'a','b'}) == 2);
+    }
+
     constexpr auto cx_vectors_can_be_asked_whether_they_are_empty()
     {
         static_assert(empty(cx::vector<int>{}));
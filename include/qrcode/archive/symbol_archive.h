@@ -0,0 +1,304 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include <qrcode/archive/symbol_record.h>
+#include <qrcode/archive/symbol_view.h>
+#include <qrcode/cache/fnv_hash.h>
+
+namespace qrcode::archive
+{
+    // layout of an archive, all numbers are little endian:
+    //
+    //  0  magic "QRSA"    4  format version (4 bytes)    8  number of symbols n (8 bytes)
+    // 16  id index:   n entries of record offset (8 bytes) and message hash (8 bytes)
+    //     hash index: n entries of message hash (8 bytes) and id (8 bytes), sorted by hash
+    //     records, each one starting at a multiple of 8
+    //
+    inline constexpr auto archive_magic = std::uint32_t{0x41535251}; // "QRSA"
+    inline constexpr auto archive_format_version = std::uint32_t{1};
+    inline constexpr auto archive_header_size = std::size_t{16};
+    inline constexpr auto index_entry_size = std::size_t{16};
+
+    template<std::ranges::input_range Message>
+    [[nodiscard]] constexpr auto message_hash(Message&& message) noexcept
+    {
+        return qrcode::cache::fnv_hash(std::forward<Message>(message));
+    }
+
+    // collects records and their index, ids are handed out in order of insertion
+    class archive_builder
+    {
+    public:
+        template<class Module, Symbol_Designator Designator>
+        constexpr auto add(symbol<Module, Designator> const& symbol, std::uint64_t hash)
+        {
+            auto const offset = records.size();
+            records.resize(offset + record_size(width(symbol)));
+            write_record(std::span{records}.subspan(offset), symbol);
+            entries.push_back({offset, hash});
+            return entries.size() - 1;
+        }
+
+        template<class Module, Symbol_Designator Designator, std::ranges::input_range Message>
+        constexpr auto add(symbol<Module, Designator> const& symbol, Message&& message)
+        {
+            return add(symbol, message_hash(std::forward<Message>(message)));
+        }
+
+        [[nodiscard]] friend constexpr auto size(archive_builder const& builder) noexcept
+        {
+            return builder.entries.size();
+        }
+
+        [[nodiscard]] constexpr auto build() const
+        {
+            using qrcode::archive::detail::store;
+
+            auto const count = entries.size();
+            auto const records_offset = archive_header_size + 2 * count * index_entry_size;
+
+            auto bytes = std::vector<std::byte>(records_offset + records.size());
+            store(bytes, 0, archive_magic);
+            store(bytes, 4, archive_format_version);
+            store(bytes, 8, static_cast<std::uint64_t>(count));
+
+            auto by_hash = std::vector<std::size_t>(count);
+            for (auto id = std::size_t{0}; id != count; ++id)
+            {
+                auto const at = archive_header_size + id * index_entry_size;
+                store(bytes, at, static_cast<std::uint64_t>(records_offset + entries[id].offset));
+                store(bytes, at + 8, entries[id].hash);
+                by_hash[id] = id;
+            }
+
+            // ids break ties, so equal hashes keep their order of insertion
+            std::ranges::sort(by_hash, [&](auto a, auto b) 
+            { 
+                return entries[a].hash != entries[b].hash ? entries[a].hash < entries[b].hash : a < b; 
+            });
+            for (auto i = std::size_t{0}; i != count; ++i)
+            {
+                auto const at = archive_header_size + (count + i) * index_entry_size;
+                store(bytes, at, entries[by_hash[i]].hash);
+                store(bytes, at + 8, static_cast<std::uint64_t>(by_hash[i]));
+            }
+
+            std::ranges::copy(records, bytes.begin() + static_cast<std::ptrdiff_t>(records_offset));
+            return bytes;
+        }
+
+    private:
+        struct entry
+        {
+            std::size_t offset;
+            std::uint64_t hash;
+        };
+
+        std::vector<std::byte> records;
+        std::vector<entry> entries;
+    };
+
+    // non owning view of an archive, e.g. of a memory mapped file shared by many processes;
+    // lookups never copy or allocate
+    class symbol_archive
+    {
+    public:
+        constexpr symbol_archive() noexcept = default;
+
+        friend constexpr auto make_symbol_archive(std::span<std::byte const> bytes) noexcept
+            -> std::optional<symbol_archive>;
+
+        [[nodiscard]] friend constexpr auto size(symbol_archive const& archive) noexcept
+        {
+            return archive.count;
+        }
+
+        [[nodiscard]] friend constexpr auto find(symbol_archive const& archive, std::size_t id) noexcept
+            -> std::optional<symbol_view>
+        {
+            using qrcode::archive::detail::load;
+
+            if (id >= archive.count)
+                return std::nullopt;
+            
+            auto const offset = load<std::uint64_t>(archive.bytes, archive_header_size + id * index_entry_size);
+            if (offset % 8 != 0 || offset >= archive.bytes.size())
+                return std::nullopt;
+            return make_symbol_view(archive.bytes.subspan(static_cast<std::size_t>(offset)));
+        }
+
+        // first symbol added with given hash, hashes of different messages may collide
+        [[nodiscard]] friend constexpr auto find_hash(symbol_archive const& archive, std::uint64_t hash) noexcept
+            -> std::optional<symbol_view>
+        {
+            using qrcode::archive::detail::load;
+
+            auto const hash_at = [&](std::size_t i)
+            {
+                return load<std::uint64_t>(archive.bytes, archive.hash_index + i * index_entry_size);
+            };
+
+            auto first = std::size_t{0};
+            auto last = archive.count;
+            while (first != last)
+            {
+                auto const middle = first + (last - first) / 2;
+                if (hash_at(middle) < hash)
+                    first = middle + 1;
+                else
+                    last = middle;
+            }
+
+            if (first == archive.count || hash_at(first) != hash)
+                return std::nullopt;
+            auto const id = load<std::uint64_t>(archive.bytes, archive.hash_index + first * index_entry_size + 8);
+            return find(archive, static_cast<std::size_t>(id));
+        }
+
+    private:
+        std::span<std::byte const> bytes;
+        std::size_t count = 0;
+        std::size_t hash_index = 0;
+    };
+
+    [[nodiscard]] constexpr auto make_symbol_archive(std::span<std::byte const> bytes) noexcept
+        -> std::optional<symbol_archive>
+    {
+        using qrcode::archive::detail::load;
+
+        if (bytes.size() < archive_header_size 
+            || load<std::uint32_t>(bytes, 0) != archive_magic 
+            || load<std::uint32_t>(bytes, 4) != archive_format_version)
+            return std::nullopt;
+
+        auto const count = load<std::uint64_t>(bytes, 8);
+        if (count > (bytes.size() - archive_header_size) / (2 * index_entry_size))
+            return std::nullopt;
+
+        auto archive = symbol_archive{};
+        archive.bytes = bytes;
+        archive.count = static_cast<std::size_t>(count);
+        archive.hash_index = archive_header_size + archive.count * index_entry_size;
+        return archive;
+    }
+
+    template<std::ranges::input_range Message>
+    [[nodiscard]] constexpr auto find_message(symbol_archive const& archive, Message&& message) noexcept
+    {
+        return find_hash(archive, message_hash(std::forward<Message>(message)));
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <array>
+#include <string_view>
+#include <qrcode/micro_qr/micro_qr.h>
+#include <qrcode/qr/qr.h>
+
+#if defined(__cpp_lib_constexpr_vector)
+namespace qrcode::archive::test
+{
+    constexpr auto archives_find_symbols_by_id_and_by_message()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            auto const first = qr::make_symbol<char>("HELLO WORLD"sv, qr::error_correction::level_Q).value();
+            auto const second = micro_qr::make_symbol<char>("12345"sv, micro_qr::error_correction::level_L).value();
+            auto const third = qr::make_symbol<char>("https://example.com/a/rather/long/path/to/something"sv, qr::error_correction::level_L).value();
+
+            auto builder = archive_builder{};
+            if (builder.add(first, "HELLO WORLD"sv) != 0 
+                || builder.add(second, "12345"sv) != 1 
+                || builder.add(third, "https://example.com/a/rather/long/path/to/something"sv) != 2)
+                return false;
+
+            auto const bytes = builder.build();
+            auto const archive = make_symbol_archive(bytes);
+            if (!archive || size(*archive) != 3)
+                return false;
+
+            return unpack<char, qr::symbol_designator>(*find(*archive, 0)) == first
+                && unpack<char, micro_qr::symbol_designator>(*find(*archive, 1)) == second
+                && unpack<char, qr::symbol_designator>(*find(*archive, 2)) == third
+                && !find(*archive, 3)
+                && unpack<char, micro_qr::symbol_designator>(*find_message(*archive, "12345"sv)) == second
+                && unpack<char, qr::symbol_designator>(*find_message(*archive, "https://example.com/a/rather/long/path/to/something"sv)) == third
+                && !find_message(*archive, "54321"sv);
+        };
+        static_assert(f());
+    }
+
+    constexpr auto records_of_an_archive_are_8_byte_aligned()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            auto builder = archive_builder{};
+            builder.add(micro_qr::make_symbol<char>("1"sv, micro_qr::error_correction::level_L).value(), "1"sv);
+            builder.add(micro_qr::make_symbol<char>("12345678"sv, micro_qr::error_correction::level_L).value(), "12345678"sv);
+            
+            auto const archive_bytes = builder.build();
+            auto const archive = *make_symbol_archive(archive_bytes);
+            auto const begin = archive_bytes.data();
+            return (bytes(*find(archive, 0)).data() - begin) % 8 == 0
+                && (bytes(*find(archive, 1)).data() - begin) % 8 == 0;
+        };
+        static_assert(f());
+    }
+
+    constexpr auto damaged_archives_are_rejected()
+    {
+        auto f = []
+        {
+            auto header = std::array<std::byte, archive_header_size>{};
+            detail::store(header, 0, archive_magic);
+            detail::store(header, 4, archive_format_version);
+
+            auto too_many_symbols = header;
+            detail::store(too_many_symbols, 8, std::uint64_t{1});
+
+            auto unknown_version = header;
+            detail::store(unknown_version, 4, archive_format_version + 1);
+
+            return make_symbol_archive(header) && size(*make_symbol_archive(header)) == 0
+                && !find_hash(*make_symbol_archive(header), 0)
+                && !make_symbol_archive(too_many_symbols)
+                && !make_symbol_archive(unknown_version)
+                && !make_symbol_archive(std::span{header}.first(8));
+        };
+        static_assert(f());
+    }
+}
+#endif
+#endif
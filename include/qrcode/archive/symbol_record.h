@@ -0,0 +1,222 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <qrcode/symbol.h>
+#include <qrcode/micro_qr/symbol_designator.h>
+#include <qrcode/qr/symbol_designator.h>
+#include <qrcode/structure/matrix.h>
+#include <qrcode/structure/module_traits.h>
+
+namespace qrcode::archive::detail
+{
+    template<std::unsigned_integral T>
+    constexpr auto store(std::span<std::byte> bytes, std::size_t offset, T value) noexcept
+    {
+        for (auto i = std::size_t{0}; i != sizeof(T); ++i)
+            bytes[offset + i] = static_cast<std::byte>(value >> (8 * i));
+    }
+
+    // little endian on every platform, compilers turn this into a single load where they can
+    template<std::unsigned_integral T>
+    [[nodiscard]] constexpr auto load(std::span<std::byte const> bytes, std::size_t offset) noexcept
+    {
+        auto value = T{0};
+        for (auto i = std::size_t{0}; i != sizeof(T); ++i)
+            value |= static_cast<T>(std::to_integer<T>(bytes[offset + i]) << (8 * i));
+        return value;
+    }
+}
+
+namespace qrcode::archive
+{
+    // layout of a symbol record, all numbers are little endian:
+    //
+    //  0  format version    1  symbol family    2  version number    3  error level + 1 (0: none)
+    //  4  mask pattern      5  width            6  reserved (2 bytes)
+    //  8  rows of 64 bit words, module x of a row is bit x % 64 of word x / 64
+    //
+    inline constexpr auto record_format_version = std::uint8_t{1};
+    inline constexpr auto record_header_size = std::size_t{8};
+
+    enum class symbol_family : std::uint8_t { qr = 1, micro_qr = 2 };
+
+    struct record_header
+    {
+        symbol_family family = symbol_family::qr;
+        std::uint8_t version = 0;
+        std::uint8_t error_level = 0;
+
+        [[nodiscard]] constexpr auto operator==(record_header const&) const noexcept -> bool = default;
+    };
+
+    [[nodiscard]] constexpr auto words_per_row(int width) noexcept
+    {
+        return static_cast<std::size_t>((width + 63) / 64);
+    }
+
+    // symbols are square, so the width determines the size of the record
+    [[nodiscard]] constexpr auto record_size(int width) noexcept
+    {
+        return record_header_size + static_cast<std::size_t>(width) * words_per_row(width) * 8;
+    }
+
+    [[nodiscard]] constexpr auto make_record_header(qr::symbol_designator const& designator) noexcept
+    {
+        return record_header{
+            symbol_family::qr, 
+            static_cast<std::uint8_t>(designator.version.number), 
+            static_cast<std::uint8_t>(number(designator.error_level) + 1)
+        };
+    }
+
+    [[nodiscard]] constexpr auto make_record_header(micro_qr::symbol_designator const& designator) noexcept
+    {
+        auto const level = error_level(designator);
+        return record_header{
+            symbol_family::micro_qr, 
+            static_cast<std::uint8_t>(number(version(designator))),
+            static_cast<std::uint8_t>(level ? number(*level) + 1 : 0)
+        };
+    }
+
+    template<Symbol_Designator Designator>
+    [[nodiscard]] constexpr auto make_designator(record_header const& header) noexcept 
+        -> std::optional<Designator>
+    {
+        if constexpr (std::same_as<Designator, qr::symbol_designator>)
+        {
+            if (header.family != symbol_family::qr || header.version < 1 || header.version > 40 
+                || header.error_level < 1 || header.error_level > 4)
+                return std::nullopt;
+            return qr::symbol_designator{
+                qr::symbol_version{header.version}, 
+                static_cast<qr::error_correction>(header.error_level - 1)
+            };
+        }
+        else
+        {
+            using micro_qr::error_correction;
+            if (header.family != symbol_family::micro_qr || header.version > 3 || header.error_level > 3)
+                return std::nullopt;
+            auto const level = header.error_level == 0 
+                ? std::optional<error_correction>{} 
+                : std::optional<error_correction>{static_cast<error_correction>(header.error_level - 1)};
+            return micro_qr::make_designator(static_cast<micro_qr::symbol_version>(header.version), level);
+        }
+    }
+
+    // false if given bytes cannot hold the record
+    template<class Module, Symbol_Designator Designator>
+    constexpr auto write_record(std::span<std::byte> bytes, symbol<Module, Designator> const& symbol) noexcept
+    {
+        using qrcode::archive::detail::store;
+        using qrcode::structure::module_traits;
+
+        auto const& code = modules(symbol);
+        auto const width = qrcode::width(symbol);
+        if (bytes.size() < record_size(width))
+            return false;
+
+        auto const header = make_record_header(designator(symbol));
+        store(bytes, 0, record_format_version);
+        store(bytes, 1, static_cast<std::uint8_t>(header.family));
+        store(bytes, 2, header.version);
+        store(bytes, 3, header.error_level);
+        store(bytes, 4, static_cast<std::uint8_t>(mask_pattern(symbol)));
+        store(bytes, 5, static_cast<std::uint8_t>(width));
+        store(bytes, 6, std::uint16_t{0});
+
+        auto const words = words_per_row(width);
+        for (auto y = 0; y != width; ++y)
+        for (auto word = std::size_t{0}; word != words; ++word)
+        {
+            auto value = std::uint64_t{0};
+            for (auto bit = 0; bit != 64; ++bit)
+            {
+                auto const x = static_cast<int>(word * 64) + bit;
+                if (x < width && module_traits<Module>::is_set(element_at(code, {x, y})))
+                    value |= std::uint64_t{1} << bit;
+            }
+            store(bytes, record_header_size + (static_cast<std::size_t>(y) * words + word) * 8, value);
+        }
+        return true;
+    }
+
+    template<class Module, Symbol_Designator Designator>
+    [[nodiscard]] auto serialize(symbol<Module, Designator> const& symbol)
+    {
+        auto bytes = std::vector<std::byte>(record_size(width(symbol)));
+        write_record(bytes, symbol);
+        return bytes;
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+namespace qrcode::archive::detail::test
+{
+    constexpr auto numbers_are_stored_little_endian()
+    {
+        auto f = []
+        {
+            auto bytes = std::array<std::byte, 8>{};
+            store(bytes, 0, std::uint64_t{0x0102030405060708u});
+            return bytes[0] == std::byte{0x08} && bytes[7] == std::byte{0x01}
+                && load<std::uint64_t>(bytes, 0) == 0x0102030405060708u
+                && load<std::uint16_t>(bytes, 6) == 0x0102u;
+        };
+        static_assert(f());
+    }
+}
+
+namespace qrcode::archive::test
+{
+    constexpr auto records_have_8_byte_aligned_rows()
+    {
+        static_assert(record_size(21) == 8 + 21 * 8);
+        static_assert(record_size(64) == 8 + 64 * 8);
+        static_assert(record_size(177) == 8 + 177 * 3 * 8);
+    }
+
+    constexpr auto record_headers_restore_the_designator()
+    {
+        constexpr auto any_qr = qr::symbol_designator{qr::symbol_version{17}, qr::error_correction::level_Q};
+        static_assert(make_designator<qr::symbol_designator>(make_record_header(any_qr)) == any_qr);
+
+        constexpr auto any_micro_qr = micro_qr::make_designator(micro_qr::symbol_version::M1, std::nullopt);
+        static_assert(make_designator<micro_qr::symbol_designator>(make_record_header(*any_micro_qr)) == any_micro_qr);
+
+        static_assert(!make_designator<micro_qr::symbol_designator>(make_record_header(any_qr)));
+        static_assert(!make_designator<qr::symbol_designator>(record_header{symbol_family::qr, 41, 1}));
+    }
+}
+#endif
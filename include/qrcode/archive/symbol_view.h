@@ -0,0 +1,225 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include <qrcode/archive/symbol_record.h>
+#include <qrcode/micro_qr/raw_code.h>
+#include <qrcode/qr/raw_code.h>
+#include <qrcode/structure/dimension.h>
+#include <qrcode/structure/position.h>
+
+namespace qrcode::archive
+{
+    using qrcode::structure::dimension;
+    using qrcode::structure::position;
+
+    // non owning view of a symbol record, reading a module never copies or allocates
+    class symbol_view
+    {
+    public:
+        constexpr symbol_view() noexcept = default;
+
+        friend constexpr auto make_symbol_view(std::span<std::byte const> bytes) noexcept
+            -> std::optional<symbol_view>;
+
+        [[nodiscard]] friend constexpr auto header(symbol_view const& view) noexcept 
+        { 
+            return view.info; 
+        }
+
+        [[nodiscard]] friend constexpr auto mask_pattern(symbol_view const& view) noexcept 
+        { 
+            return view.mask_id; 
+        }
+
+        [[nodiscard]] friend constexpr auto size(symbol_view const& view) noexcept 
+        { 
+            return dimension{view.width, view.width}; 
+        }
+
+        [[nodiscard]] friend constexpr auto bytes(symbol_view const& view) noexcept 
+        { 
+            return view.record; 
+        }
+
+        [[nodiscard]] friend constexpr auto is_set(symbol_view const& view, position index) noexcept
+        {
+            using qrcode::archive::detail::load;
+
+            auto const word_index = static_cast<std::size_t>(index.y) * words_per_row(view.width) 
+                + static_cast<std::size_t>(index.x / 64);
+            auto const word = load<std::uint64_t>(view.record, record_header_size + word_index * 8);
+            return ((word >> (index.x % 64)) & 1) != 0;
+        }
+
+    private:
+        std::span<std::byte const> record;
+        archive::record_header info;
+        int mask_id = 0;
+        int width = 0;
+    };
+
+    [[nodiscard]] constexpr auto make_symbol_view(std::span<std::byte const> bytes) noexcept 
+        -> std::optional<symbol_view>
+    {
+        using qrcode::archive::detail::load;
+
+        if (bytes.size() < record_header_size || load<std::uint8_t>(bytes, 0) != record_format_version)
+            return std::nullopt;
+
+        auto view = symbol_view{};
+        view.info = archive::record_header{
+            static_cast<symbol_family>(load<std::uint8_t>(bytes, 1)), 
+            load<std::uint8_t>(bytes, 2), 
+            load<std::uint8_t>(bytes, 3)
+        };
+        view.mask_id = load<std::uint8_t>(bytes, 4);
+        view.width = load<std::uint8_t>(bytes, 5);
+        if (bytes.size() < record_size(view.width) || view.mask_id > 7)
+            return std::nullopt;
+        
+        view.record = bytes.first(record_size(view.width));
+        return view;
+    }
+
+    template<Symbol_Designator Designator>
+    [[nodiscard]] constexpr auto designator(symbol_view const& view) noexcept
+    {
+        return make_designator<Designator>(header(view));
+    }
+
+    // function and data modules are told apart by the function layout of the designated version
+    template<class Module, Symbol_Designator Designator>
+    [[nodiscard]] constexpr auto unpack(symbol_view const& view) noexcept 
+        -> std::optional<symbol<Module, Designator>>
+    {
+        using qrcode::structure::module_traits;
+        using qrcode::qr::make_function_layout;
+        using qrcode::micro_qr::make_function_layout;
+
+        auto const symbol_designator = designator<Designator>(view);
+        if (!symbol_designator)
+            return std::nullopt;
+
+        auto code = make_function_layout<Module>(version(*symbol_designator));
+        if (size(code) != size(view))
+            return std::nullopt;
+
+        for (auto y = 0; y != height(size(code)); ++y)
+        for (auto x = 0; x != width(size(code)); ++x)
+        {
+            auto& module = element_at(code, {x, y});
+            auto const bit = is_set(view, {x, y});
+            module = module_traits<Module>::is_free(module) 
+                ? module_traits<Module>::make_data(bit) 
+                : module_traits<Module>::make_function(bit);
+        }
+        return symbol<Module, Designator>{*symbol_designator, mask_pattern(view), std::move(code)};
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <array>
+#include <qrcode/micro_qr/micro_qr.h>
+#include <qrcode/qr/qr.h>
+
+namespace qrcode::archive::test
+{
+    constexpr auto symbol_views_read_the_modules_of_a_record()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            constexpr auto any_error_level = qr::error_correction::level_M;
+            auto const any_symbol = qr::make_symbol<char>("01234567"sv, any_error_level).value();
+
+            auto record = std::array<std::byte, record_size(21)>{};
+            if (!write_record(record, any_symbol))
+                return false;
+
+            auto const view = make_symbol_view(record);
+            if (!view || size(*view) != dimension{21, 21} || mask_pattern(*view) != mask_pattern(any_symbol))
+                return false;
+
+            for (auto y = 0; y != 21; ++y)
+            for (auto x = 0; x != 21; ++x)
+                if (is_set(*view, {x, y}) != (element_at(modules(any_symbol), {x, y}) == '*' 
+                    || element_at(modules(any_symbol), {x, y}) == '+'))
+                    return false;
+            return true;
+        };
+        static_assert(f());
+    }
+
+    constexpr auto unpacking_a_record_restores_the_written_symbol()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            auto const any_symbol = qr::make_symbol<char>("HELLO WORLD"sv, qr::error_correction::level_Q).value();
+
+            auto record = std::array<std::byte, record_size(21)>{};
+            if (!write_record(record, any_symbol))
+                return false;
+            return unpack<char, qr::symbol_designator>(*make_symbol_view(record)) == any_symbol;
+        };
+        static_assert(f());
+
+        auto g = []
+        {
+            using namespace std::literals;
+            auto const any_symbol = micro_qr::make_symbol<char>("12345"sv, micro_qr::error_correction::level_L).value();
+
+            auto record = std::array<std::byte, record_size(17)>{};
+            if (!write_record(record, any_symbol))
+                return false;
+            return unpack<char, micro_qr::symbol_designator>(*make_symbol_view(record)) == any_symbol
+                && !unpack<char, qr::symbol_designator>(*make_symbol_view(record));
+        };
+        static_assert(g());
+    }
+
+    constexpr auto truncated_or_unknown_records_have_no_view()
+    {
+        auto f = []
+        {
+            auto record = std::array<std::byte, record_size(21)>{};
+            record[0] = std::byte{record_format_version};
+            record[5] = std::byte{21};
+            auto const truncated = std::span<std::byte const>{record}.first(record_size(21) - 1);
+
+            auto unknown = record;
+            unknown[0] = std::byte{record_format_version + 1};
+
+            return make_symbol_view(record) && !make_symbol_view(truncated) && !make_symbol_view(unknown);
+        };
+        static_assert(f());
+    }
+}
+#endif
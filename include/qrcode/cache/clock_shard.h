@@ -0,0 +1,188 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <ranges>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace qrcode::cache::detail
+{
+    // second chance: referenced slots are spared once, the hand stops at the first other one
+    template<std::ranges::random_access_range Slots>
+    [[nodiscard]] constexpr auto advance_clock(Slots& slots, int hand) noexcept
+    {
+        auto const slot_count = static_cast<int>(std::ranges::size(slots));
+        for (;; hand = (hand + 1) % slot_count)
+        {
+            if (!slots[hand].referenced)
+                return hand;
+            slots[hand].referenced = false;
+        }
+    }
+}
+
+namespace qrcode::cache
+{
+    // not synchronized: a shard is guarded by the cache which owns it
+    template<class Key, class Value, class Hash>
+    class clock_shard
+    {
+    public:
+        using value_pointer = std::shared_ptr<Value const>;
+
+        clock_shard() noexcept = default;
+
+        explicit clock_shard(std::size_t max_weight) noexcept
+        : capacity{max_weight}
+        {
+        }
+
+        [[nodiscard]] auto find(Key const& key) noexcept -> value_pointer
+        {
+            auto const i = index.find(key);
+            if (i == end(index))
+                return nullptr;
+
+            auto& slot = slots[i->second];
+            slot.referenced = true;
+            return slot.value;
+        }
+
+        // an entry which was inserted in between wins, so all callers share the same value
+        auto insert(Key key, value_pointer value, std::size_t weight) -> std::pair<value_pointer, int>
+        {
+            if (auto const i = index.find(key); i != end(index))
+                return {slots[i->second].value, 0};
+            if (weight > capacity)
+                return {std::move(value), 0};
+
+            auto evictions = 0;
+            for (; total_weight + weight > capacity; ++evictions)
+                evict();
+
+            auto const position = free_slot();
+            slots[position] = slot{key, value, weight, false};
+            index.emplace(std::move(key), position);
+            total_weight += weight;
+            return {std::move(value), evictions};
+        }
+
+        [[nodiscard]] friend auto weight(clock_shard const& shard) noexcept
+        {
+            return shard.total_weight;
+        }
+
+        [[nodiscard]] friend auto size(clock_shard const& shard) noexcept
+        {
+            return size(shard.index);
+        }
+
+    private:
+        struct slot
+        {
+            Key key;
+            value_pointer value;
+            std::size_t weight = 0;
+            bool referenced = false;
+        };
+
+        auto evict() -> void
+        {
+            using qrcode::cache::detail::advance_clock;
+
+            // free slots are never referenced, so the hand has to skip them here
+            for (;; hand = (hand + 1) % static_cast<int>(size(slots)))
+            {
+                hand = advance_clock(slots, hand);
+                if (slots[hand].value)
+                    break;
+            }
+
+            auto& victim = slots[hand];
+            index.erase(victim.key);
+            total_weight -= victim.weight;
+            victim = slot{};
+            free_slots.push_back(hand);
+            hand = (hand + 1) % static_cast<int>(size(slots));
+        }
+
+        [[nodiscard]] auto free_slot() -> int
+        {
+            if (free_slots.empty())
+            {
+                slots.emplace_back();
+                return static_cast<int>(size(slots)) - 1;
+            }
+            auto const position = free_slots.back();
+            free_slots.pop_back();
+            return position;
+        }
+
+        std::size_t capacity = 0;
+        std::size_t total_weight = 0;
+        int hand = 0;
+        std::vector<slot> slots;
+        std::vector<int> free_slots;
+        std::unordered_map<Key, int, Hash> index;
+    };
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <array>
+
+namespace qrcode::cache::detail::test
+{
+    struct slot_stub
+    {
+        bool referenced;
+    };
+
+    constexpr auto advance_clock_stops_at_the_first_slot_which_is_not_referenced()
+    {
+        auto f = [](auto slots, auto hand)
+        {
+            return advance_clock(slots, hand);
+        };
+        static_assert(f(std::array{slot_stub{false}, slot_stub{false}}, 0) == 0);
+        static_assert(f(std::array{slot_stub{false}, slot_stub{false}}, 1) == 1);
+        static_assert(f(std::array{slot_stub{true}, slot_stub{true}, slot_stub{false}}, 0) == 2);
+        static_assert(f(std::array{slot_stub{false}, slot_stub{true}, slot_stub{true}}, 1) == 0);
+    }
+
+    constexpr auto advance_clock_gives_referenced_slots_a_second_chance()
+    {
+        auto f = []
+        {
+            auto slots = std::array{slot_stub{true}, slot_stub{true}, slot_stub{true}};
+            auto const victim = advance_clock(slots, 1);
+            return victim == 1 && !slots[0].referenced && !slots[1].referenced && !slots[2].referenced;
+        };
+        static_assert(f());
+    }
+}
+#endif
@@ -0,0 +1,84 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+
+namespace qrcode::cache::detail
+{
+    template<class T>
+    [[nodiscard]] constexpr auto octet(T value) noexcept
+    {
+        if constexpr (std::same_as<T, std::byte>)
+            return std::to_integer<std::uint8_t>(value);
+        else
+            return static_cast<std::uint8_t>(value);
+    }
+}
+
+namespace qrcode::cache
+{
+    inline constexpr auto fnv_offset_basis = std::uint64_t{14695981039346656037ull};
+    inline constexpr auto fnv_prime = std::uint64_t{1099511628211ull};
+
+    // fnv-1a: not cryptographic, but fast and well spread for short keys like urls
+    template<std::ranges::input_range Bytes>
+    [[nodiscard]] constexpr auto fnv_hash(Bytes&& bytes, std::uint64_t seed = fnv_offset_basis) noexcept
+    {
+        using qrcode::cache::detail::octet;
+
+        auto hash = seed;
+        for (auto i : bytes)
+            hash = (hash ^ octet(i)) * fnv_prime;
+        return hash;
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <array>
+#include <string_view>
+
+namespace qrcode::cache::test
+{
+    constexpr auto fnv_hash_returns_the_fnv_1a_hash_of_given_bytes()
+    {
+        using namespace std::literals;
+
+        static_assert(fnv_hash(""sv) == fnv_offset_basis);
+        static_assert(fnv_hash("a"sv) == 0xaf63dc4c8601ec8cull);
+        static_assert(fnv_hash("foobar"sv) == 0x85944171f73967e8ull);
+        static_assert(fnv_hash(std::array{std::byte{'a'}}) == fnv_hash("a"sv));
+    }
+
+    constexpr auto fnv_hash_continues_from_given_seed()
+    {
+        using namespace std::literals;
+
+        static_assert(fnv_hash("bar"sv, fnv_hash("foo"sv)) == fnv_hash("foobar"sv));
+    }
+}
+#endif
@@ -0,0 +1,121 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include <qrcode/cache/clock_shard.h>
+
+namespace qrcode::cache
+{
+    struct cache_statistics
+    {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+        std::size_t entries = 0;
+        std::size_t weight = 0;
+    };
+
+    // lock striping: every shard has its own mutex, so only lookups of the same shard contend
+    template<class Key, class Value, class Hash, int Shard_Count = 16>
+    requires (Shard_Count > 0)
+    class sharded_cache
+    {
+    public:
+        using value_pointer = std::shared_ptr<Value const>;
+
+        explicit sharded_cache(std::size_t max_weight) noexcept
+        {
+            for (auto& shard : shards)
+                shard.entries = clock_shard<Key, Value, Hash>{max_weight / Shard_Count};
+        }
+
+        sharded_cache(sharded_cache const&) = delete;
+        auto operator=(sharded_cache const&) -> sharded_cache& = delete;
+
+        [[nodiscard]] auto find(Key const& key) -> value_pointer
+        {
+            auto& shard = shard_of(key);
+            auto value = [&]
+            {
+                auto const lock = std::scoped_lock{shard.lock};
+                return shard.entries.find(key);
+            }();
+
+            (value ? hits : misses).fetch_add(1, std::memory_order_relaxed);
+            return value;
+        }
+
+        auto insert(Key key, value_pointer value, std::size_t weight) -> value_pointer
+        {
+            auto& shard = shard_of(key);
+            auto const lock = std::scoped_lock{shard.lock};
+            auto [shared, eviction_count] = shard.entries.insert(std::move(key), std::move(value), weight);
+            evictions.fetch_add(static_cast<std::uint64_t>(eviction_count), std::memory_order_relaxed);
+            return shared;
+        }
+
+        // counters are relaxed, the sum of all shards is no snapshot while other threads insert
+        [[nodiscard]] friend auto statistics(sharded_cache const& cache) noexcept
+        {
+            auto result = cache_statistics{
+                .hits = cache.hits.load(std::memory_order_relaxed),
+                .misses = cache.misses.load(std::memory_order_relaxed),
+                .evictions = cache.evictions.load(std::memory_order_relaxed)
+            };
+            for (auto& shard : cache.shards)
+            {
+                auto const lock = std::scoped_lock{shard.lock};
+                result.entries += size(shard.entries);
+                result.weight += weight(shard.entries);
+            }
+            return result;
+        }
+
+    private:
+        struct shard_type
+        {
+            mutable std::mutex lock;
+            clock_shard<Key, Value, Hash> entries;
+        };
+
+        // the buckets of a shard use the low bits of the hash, fibonacci hashing spreads the high ones
+        [[nodiscard]] auto shard_of(Key const& key) noexcept -> shard_type&
+        {
+            auto const hash = static_cast<std::uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ull;
+            return shards[(hash >> 32) % Shard_Count];
+        }
+
+        std::array<shard_type, Shard_Count> shards;
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> misses{0};
+        std::atomic<std::uint64_t> evictions{0};
+    };
+}
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 #include <array>
 #include <algorithm>
@@ -31,6 +32,7 @@
 #include <concepts>
 #include <iterator>
 #include <optional>
+#include <limits>
 
 namespace qrcode::code::detail
 {
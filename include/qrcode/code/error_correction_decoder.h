@@ -0,0 +1,372 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ranges>
+#include <utility>
+
+#include <cx/vector.h>
+
+#include <qrcode/code/gf2p8.h>
+#include <qrcode/code/polynomial.h>
+#include <qrcode/code/power_table.h>
+#include <qrcode/code/sequence_blocks.h>
+#include <qrcode/code/sequence_description.h>
+#include <qrcode/code/syndrome.h>
+
+namespace qrcode::code::detail
+{
+    // reed-solomon blocks over gf(2^8) hold at most 255 codewords
+    inline constexpr auto max_block_size = 255;
+
+    [[nodiscard]] constexpr auto coefficient_at(polynomial<gf2p8>& p, int index) noexcept -> gf2p8&
+    {
+        return *(begin(p) + index);
+    }
+
+    // polynomials are stored lowest degree first
+    [[nodiscard]] constexpr auto evaluate_polynomial(polynomial<gf2p8> const& p, gf2p8 x) noexcept
+    {
+        auto result = 0_gf;
+        for (auto i = rbegin(p); i != rend(p); ++i)
+            result = result * x + *i;
+        return result;
+    }
+
+    [[nodiscard]] constexpr auto formal_derivative(polynomial<gf2p8> const& p) noexcept
+    {
+        // in characteristic 2, only the odd powers survive the derivation
+        auto result = polynomial<gf2p8>(std::max(degree(p)-1, 0), 0_gf);
+        for (auto i = 1; i < size(p); i += 2)
+            coefficient_at(result, i-1) = coeffient(p, i);
+        return result;
+    }
+}
+
+namespace qrcode::code
+{
+    // berlekamp-massey: the shortest lfsr which generates the given syndromes
+    [[nodiscard]] constexpr auto error_locator(polynomial<gf2p8> const& syndromes) noexcept
+    {
+        using qrcode::code::detail::max_block_size;
+        using coefficients = std::array<gf2p8, max_block_size + 1>;
+
+        auto const n = size(syndromes);
+        assert(n <= max_block_size);
+
+        // the previous locator is updated in place into the next one when the length changes, so the
+        // two only swap their roles and are never copied
+        auto buffers = std::array<coefficients, 2>{};
+        auto* locator = &buffers[0];
+        auto* previous = &buffers[1];
+        (*locator)[0] = 1_gf;
+        (*previous)[0] = 1_gf;
+
+        auto length = 0;
+        auto shift = 1;
+        auto previous_discrepancy = 1_gf;
+
+        for (auto i = 0; i != n; ++i, ++shift)
+        {
+            auto discrepancy = coeffient(syndromes, i);
+            for (auto j = 1; j <= length; ++j)
+                discrepancy += (*locator)[j] * coeffient(syndromes, i-j);
+
+            if (discrepancy == 0_gf)
+                continue;
+
+            auto const scale = discrepancy * reciprocal(previous_discrepancy);
+            if (2 * length <= i)
+            {
+                // shift is positive, running downwards reads every coefficient of previous before it is replaced
+                for (auto j = n; j >= 0; --j)
+                    (*previous)[j] = (*locator)[j] + (j >= shift ? scale * (*previous)[j-shift] : 0_gf);
+                std::swap(locator, previous);
+
+                length = i + 1 - length;
+                previous_discrepancy = discrepancy;
+                shift = 0;
+            }
+            else
+            {
+                for (auto j = shift; j <= n; ++j)
+                    (*locator)[j] += scale * (*previous)[j-shift];
+            }
+        }
+
+        return polynomial<gf2p8>{std::ranges::subrange{begin(*locator), begin(*locator) + length + 1}};
+    }
+
+    // chien search: an error at degree p of the received polynomial is a root 2^-p of the locator
+    [[nodiscard]] constexpr auto error_positions(
+        polynomial<gf2p8> const& locator, int codeword_count) noexcept
+    {
+        using qrcode::code::detail::powers;
+        using qrcode::code::detail::max_block_size;
+
+        // the terms of the locator are kept as logarithms, every step advances them by -j
+        auto terms = cx::vector<int, max_block_size + 1>{};
+        for (auto i : locator)
+            terms.push_back(i == 0_gf ? -1 : logarithm(i));
+
+        auto positions = cx::vector<int, max_block_size>{};
+        for (auto p = 0; p != codeword_count; ++p)
+        {
+            auto sum = std::uint8_t{0};
+            for (auto j = 0; j != static_cast<int>(size(terms)); ++j)
+            {
+                if (terms[j] < 0)
+                    continue;
+                sum ^= powers.exponential[terms[j]];
+                terms[j] = (terms[j] + 255 - j) % 255;
+            }
+            if (sum == 0)
+                positions.push_back(p);
+        }
+        return positions;
+    }
+
+    [[nodiscard]] constexpr auto error_evaluator(
+        polynomial<gf2p8> const& syndromes, polynomial<gf2p8> const& locator) noexcept
+    {
+        using qrcode::code::detail::coefficient_at;
+
+        // omega = syndromes * locator mod x^n
+        auto const n = size(syndromes);
+        auto result = polynomial<gf2p8>(n-1, 0_gf);
+        for (auto i = 0; i != n; ++i)
+            for (auto j = 0; j <= i && j < size(locator); ++j)
+                coefficient_at(result, i) += coeffient(locator, j) * coeffient(syndromes, i-j);
+        return result;
+    }
+
+    // forney algorithm for generator polynomials with roots 2^0, 2^1, ..., 2^(n-1)
+    [[nodiscard]] constexpr auto error_magnitude(
+        polynomial<gf2p8> const& evaluator, polynomial<gf2p8> const& derivative, int position) noexcept
+    {
+        using qrcode::code::detail::evaluate_polynomial;
+
+        auto const x = power(position);
+        auto const x_inverse = power(-position);
+        return x * evaluate_polynomial(evaluator, x_inverse) 
+            * reciprocal(evaluate_polynomial(derivative, x_inverse));
+    }
+
+    // corrects given block in place (highest degree first) and returns the number of corrected errors
+    template<std::ranges::random_access_range Codewords>
+    requires std::convertible_to<std::ranges::range_value_t<Codewords>, gf2p8>
+    [[nodiscard]] constexpr auto correct_errors(Codewords&& block, int error_size) noexcept
+    {
+        using qrcode::code::detail::formal_derivative;
+        using qrcode::code::detail::evaluate_polynomial;
+        using value_type = std::ranges::range_value_t<Codewords>;
+        using std::ranges::begin;
+        using std::ranges::size;
+        using result_type = std::optional<int>;
+
+        // blocks without errors are the common case, they are told apart without a syndrome polynomial
+        if (is_error_free(block, error_size))
+            return result_type{0};
+
+        auto const codeword_count = static_cast<int>(size(block));
+        auto const s = syndromes(block, error_size);
+
+        auto const locator = error_locator(s);
+        auto const error_count = degree(locator);
+        if (2 * error_count > error_size)
+            return result_type{};
+
+        auto const positions = error_positions(locator, codeword_count);
+        if (static_cast<int>(size(positions)) != error_count)
+            return result_type{};
+
+        auto const evaluator = error_evaluator(s, locator);
+        auto const derivative = formal_derivative(locator);
+        for (auto p : positions)
+        {
+            auto& codeword = *(begin(block) + (codeword_count - 1 - p));
+            codeword = static_cast<value_type>(gf2p8{codeword} + error_magnitude(evaluator, derivative, p));
+        }
+        return result_type{error_count};
+    }
+
+    struct corrected_sequence
+    {
+        cx::vector<std::byte> data{};
+        int error_count = 0;
+    };
+
+    // received codewords are interleaved, corrected data codewords are returned in block order
+    template<std::ranges::random_access_range Codewords>
+    requires std::same_as<std::ranges::range_value_t<Codewords>, std::byte>
+    [[nodiscard]] constexpr auto correct_sequence(
+        sequence_description const& description, Codewords const& received) noexcept
+    {
+        using std::ranges::subrange;
+        using result_type = std::optional<corrected_sequence>;
+
+        auto blocks = deinterleave(description, received);
+        auto const error_size = description.error_size;
+
+        auto result = corrected_sequence{};
+        for (auto b = 0, offset = 0; b != total_blocks(description); ++b)
+        {
+            auto const data_size = block_data_size(description, b);
+            auto const block = subrange{begin(blocks) + offset, begin(blocks) + offset + data_size + error_size};
+
+            auto const errors = correct_errors(block, error_size);
+            if (!errors)
+                return result_type{};
+
+            result.error_count += *errors;
+            for (auto i : block | std::views::take(data_size))
+                result.data.push_back(i);
+
+            offset += data_size + error_size;
+        }
+        return result_type{std::move(result)};
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <qrcode/code/sequence.h>
+
+namespace qrcode::code::detail::test
+{
+    constexpr auto formal_derivative_keeps_only_the_odd_powers()
+    {
+        // (x^3 + 3x^2 + 2x + 5)' = x^2 + 2
+        static_assert(formal_derivative(polynomial{{5_gf, 2_gf, 3_gf, 1_gf}}) == polynomial{{2_gf, 0_gf, 1_gf}});
+        static_assert(formal_derivative(polynomial{{5_gf}}) == polynomial{{0_gf}});
+    }
+}
+
+namespace qrcode::code::test
+{
+    // 1-M example from ISO/IEC 18004 annex I: 16 data and 10 error correction codewords
+    constexpr auto any_codeword = std::array{
+        std::byte{0x10}, std::byte{0x20}, std::byte{0x0C}, std::byte{0x56}, 
+        std::byte{0x61}, std::byte{0x80}, std::byte{0xEC}, std::byte{0x11}, 
+        std::byte{0xEC}, std::byte{0x11}, std::byte{0xEC}, std::byte{0x11}, 
+        std::byte{0xEC}, std::byte{0x11}, std::byte{0xEC}, std::byte{0x11},
+        std::byte{0xA5}, std::byte{0x24}, std::byte{0xD4}, std::byte{0xC1}, 
+        std::byte{0xED}, std::byte{0x36}, std::byte{0xC7}, std::byte{0x87}, 
+        std::byte{0x2C}, std::byte{0x55}
+    };
+
+    constexpr auto error_locator_of_a_single_error_has_its_position_as_root()
+    {
+        // syndromes of error e at degree p: e * 2^(p*j)
+        constexpr auto locator = error_locator(polynomial{{7_gf, 7_gf * power(5), 7_gf * power(10), 7_gf * power(15)}});
+
+        static_assert(degree(locator) == 1);
+        static_assert(std::ranges::equal(error_positions(locator, 26), std::array{5}));
+    }
+
+    constexpr auto correct_errors_leaves_blocks_without_errors_untouched()
+    {
+        auto f = []
+        {
+            auto block = any_codeword;
+            auto const errors = correct_errors(block, 10);
+            return errors == 0 && block == any_codeword;
+        };
+        static_assert(f());
+    }
+
+    constexpr auto correct_errors_corrects_up_to_half_the_error_correction_codewords()
+    {
+        auto f = [](auto... positions)
+        {
+            auto block = any_codeword;
+            auto value = 1;
+            ((block[positions] ^= std::byte{static_cast<unsigned char>(0x5A + value++)}), ...);
+
+            auto const errors = correct_errors(block, 10);
+            return errors == static_cast<int>(sizeof...(positions)) && block == any_codeword;
+        };
+        static_assert(f(0));
+        static_assert(f(25));
+        static_assert(f(3, 17));
+        static_assert(f(0, 9, 13, 20, 25));
+        static_assert(f(1, 2, 3, 4, 5));
+    }
+
+    constexpr auto correct_errors_refuses_blocks_with_too_many_errors()
+    {
+        auto f = []
+        {
+            auto block = any_codeword;
+            for (auto i : {0, 3, 6, 9, 12, 15})
+                block[i] ^= std::byte{0xFF};
+            return !correct_errors(block, 10);
+        };
+        static_assert(f());
+    }
+
+    constexpr auto correct_sequence_returns_the_corrected_data_codewords_in_block_order()
+    {
+        auto f = []
+        {
+            auto const any_description = sequence_description{{2,1}, {3,1}, 2};
+            // blocks 1 2 | 3 4 5 with generator x^2 + 3x + 2 
+            auto const generator = std::array{1_gf, 3_gf, 2_gf};
+            auto encode = [&](auto... data)
+            {
+                // remainder of data * x^2 divided by the generator
+                auto remainder = std::array{0_gf, 0_gf};
+                for (auto d : {gf2p8{static_cast<std::uint8_t>(data)}...})
+                {
+                    auto const factor = d + remainder[0];
+                    remainder[0] = remainder[1] + factor * generator[1];
+                    remainder[1] = factor * generator[2];
+                }
+                return remainder;
+            };
+            auto const first = encode(1, 2);
+            auto const second = encode(3, 4, 5);
+
+            auto interleaved = sequence<std::byte>{any_description};
+            interleaved.next(std::array{std::byte{1}, std::byte{2}}, std::array{static_cast<std::byte>(first[0]), static_cast<std::byte>(first[1])});
+            interleaved.next(std::array{std::byte{3}, std::byte{4}, std::byte{5}}, std::array{static_cast<std::byte>(second[0]), static_cast<std::byte>(second[1])});
+
+            auto received = interleaved.get();
+            received[1] ^= std::byte{0x42};
+
+            auto const corrected = correct_sequence(any_description, received);
+            return corrected 
+                && corrected->error_count == 1
+                && std::ranges::equal(corrected->data, std::array{std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}, std::byte{5}});
+        };
+        static_assert(f());
+    }
+}
+#endif
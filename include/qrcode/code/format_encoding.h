@@ -23,7 +23,9 @@
  */
 #pragma once
 
+#include <bit>
 #include <cstdint>
+#include <utility>
 
 #include <qrcode/code/lfsr.h>
 #include <qrcode/code/error_correction_code.h>
@@ -72,6 +74,32 @@ namespace qrcode::code
     {
         return masked_format{static_cast<std::uint16_t>(format_information.data ^ mask.pattern)};
     }
+
+    [[nodiscard]] constexpr auto unmasked(
+        masked_format format_information, format_mask mask) noexcept
+    {
+        return encoded_format{static_cast<std::uint16_t>(format_information.data ^ mask.pattern)};
+    }
+
+    [[nodiscard]] constexpr auto distance(encoded_format a, encoded_format b) noexcept
+    {
+        return std::popcount(static_cast<std::uint16_t>(a.data ^ b.data));
+    }
+
+    [[nodiscard]] constexpr auto nearest_format(
+        encoded_format received, error_correcting_code code) noexcept
+    {
+        // format information carries only a few data bits, trying all of them is cheap
+        auto nearest = std::make_pair(raw_format{0}, code.total_size + 1);
+        for (auto i = 0; i != (1 << code.data_size); ++i)
+        {
+            auto const candidate = raw_format{static_cast<std::uint16_t>(i)};
+            auto const d = distance(received, encode(candidate, code));
+            if (d < nearest.second)
+                nearest = std::make_pair(candidate, d);
+        }
+        return nearest;
+    }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
@@ -121,5 +149,23 @@ namespace qrcode::code::test
         static_assert(masked(encoded_format{0b1100'1010'0101'1011}, format_mask{0b1100'1010'0101'1011}) == masked_format{0b0000'0000'0000'0000});
         static_assert(masked(encoded_format{0b1100'1010'0101'1011}, format_mask{0b1111'1111'1111'1111}) == masked_format{0b0011'0101'1010'0100});
     }
+
+    constexpr auto unmasked_reverts_masked_by_xoring_bitwise()
+    {
+        constexpr auto any_mask = format_mask{0b101'0100'0001'0010};
+        constexpr auto any_format = encoded_format{0b1100'1010'0101'1011};
+
+        static_assert(unmasked(masked(any_format, any_mask), any_mask) == any_format);
+    }
+
+    constexpr auto nearest_format_returns_the_raw_format_whose_codeword_has_the_least_distance()
+    {
+        constexpr auto code = error_correcting_code{15, 5, 0b101'0011'0111};
+
+        static_assert(nearest_format(encoded_format{0b01001'1011100001}, code) == std::make_pair(raw_format{0b01001}, 0));
+        static_assert(nearest_format(encoded_format{0b01001'1011100110}, code) == std::make_pair(raw_format{0b01001}, 3));
+        static_assert(nearest_format(encoded_format{0b11101'0110010001}, code) == std::make_pair(raw_format{0b11101}, 0));
+        static_assert(nearest_format(encoded_format{0b10101'0110010001}, code) == std::make_pair(raw_format{0b11101}, 1));
+    }
 }
 #endif
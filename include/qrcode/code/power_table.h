@@ -0,0 +1,121 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <qrcode/code/gf2p8.h>
+
+namespace qrcode::code::detail
+{
+    struct power_tables
+    {
+        std::array<std::uint8_t, 2*255> exponential{};
+        std::array<int, 256> logarithm{};
+    };
+
+    [[nodiscard]] constexpr auto make_power_tables() noexcept
+    {
+        auto tables = power_tables{};
+        auto element = 1_gf;
+        for (auto i = 0; i != 255; ++i, element *= gf2p8::primitive_element())
+        {
+            auto const value = std::to_integer<std::uint8_t>(static_cast<std::byte>(element));
+            tables.exponential[i] = tables.exponential[i + 255] = value;
+            tables.logarithm[value] = i;
+        }
+        return tables;
+    }
+
+    inline constexpr auto powers = make_power_tables();
+}
+
+namespace qrcode::code
+{
+    [[nodiscard]] constexpr auto power(int exponent) noexcept
+    {
+        using qrcode::code::detail::powers;
+        constexpr auto order = 255;
+        return gf2p8{powers.exponential[(exponent % order + order) % order]};
+    }
+
+    // only defined for non-zero elements
+    [[nodiscard]] constexpr auto logarithm(gf2p8 element) noexcept
+    {
+        using qrcode::code::detail::powers;
+        return powers.logarithm[std::to_integer<std::uint8_t>(static_cast<std::byte>(element))];
+    }
+
+    // only defined for non-zero elements
+    [[nodiscard]] constexpr auto reciprocal(gf2p8 element) noexcept
+    {
+        return power(-logarithm(element));
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+namespace qrcode::code::detail::test
+{
+    constexpr auto power_tables_map_exponents_to_field_elements_and_back()
+    {
+        static_assert(powers.exponential[0] == 1);
+        static_assert(powers.exponential[1] == 2);
+        static_assert(powers.exponential[8] == 0x1D);
+        static_assert(powers.exponential[255] == 1);
+        static_assert(powers.logarithm[1] == 0);
+        static_assert(powers.logarithm[0x1D] == 8);
+        static_assert(powers.logarithm[powers.exponential[200]] == 200);
+    }
+}
+
+namespace qrcode::code::test
+{
+    constexpr auto power_returns_the_given_power_of_the_primitive_element()
+    {
+        static_assert(power(0) == 1_gf);
+        static_assert(power(1) == 2_gf);
+        static_assert(power(8) == 0x1D_gf);
+        static_assert(power(255) == 1_gf);
+        static_assert(power(-1) == power(254));
+    }
+
+    constexpr auto logarithm_returns_the_exponent_of_given_element()
+    {
+        static_assert(logarithm(1_gf) == 0);
+        static_assert(logarithm(2_gf) == 1);
+        static_assert(logarithm(0x1D_gf) == 8);
+        static_assert(logarithm(power(123)) == 123);
+    }
+
+    constexpr auto reciprocal_returns_the_multiplicative_inverse_of_given_element()
+    {
+        static_assert(reciprocal(1_gf) == 1_gf);
+        static_assert(reciprocal(2_gf) * 2_gf == 1_gf);
+        static_assert(reciprocal(0x53_gf) * 0x53_gf == 1_gf);
+        static_assert(reciprocal(0xFF_gf) * 0xFF_gf == 1_gf);
+    }
+}
+#endif
@@ -25,6 +25,7 @@
 
 #include <ranges>
 #include <algorithm>
+#include <cx/vector.h>
 #include <qrcode/code/sequence_permutation.h>
 
 namespace qrcode::code::detail
@@ -70,7 +71,7 @@ namespace qrcode::code::detail
 
 namespace qrcode::code
 {
-    template<class T>
+    template<class T, int Capacity = cx::default_capacity>
     class sequence
     {
     public:
@@ -97,7 +98,7 @@ namespace qrcode::code
         }
         
     private:
-        cx::vector<T> output;
+        cx::vector<T, Capacity> output;
 
         using output_iterator = typename decltype(output)::iterator;
 
@@ -0,0 +1,125 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <ranges>
+
+#include <cx/vector.h>
+
+#include <qrcode/code/sequence_description.h>
+
+namespace qrcode::code
+{   
+    [[nodiscard]] constexpr auto block_data_size(
+        sequence_description const& description, int block) noexcept
+    {
+        return block < description.short_block.block_count 
+            ? description.short_block.data_size 
+            : description.normal_block.data_size;
+    }
+
+    // inverse of sequence: every block is followed by its error codewords
+    template<std::ranges::random_access_range Codewords>
+    [[nodiscard]] constexpr auto deinterleave(
+        sequence_description const& description, Codewords const& codewords)
+    {
+        using value_type = std::ranges::range_value_t<Codewords>;
+
+        // codewords are interleaved column by column, only normal blocks have a last column
+        auto const block_count = total_blocks(description);
+        auto const short_count = description.short_block.block_count;
+        auto const common_size = short_count > 0 
+            ? description.short_block.data_size 
+            : description.normal_block.data_size;
+        auto const error_offset = total_data_codewords(description);
+        auto const error_size = description.error_size;
+
+        auto blocks = cx::vector<value_type>{};
+        for (auto b = 0; b != block_count; ++b)
+        {
+            for (auto i = 0; i != block_data_size(description, b); ++i)
+                blocks.push_back(codewords[i < common_size 
+                    ? i * block_count + b 
+                    : common_size * block_count + b - short_count]);
+
+            for (auto i = 0; i != error_size; ++i)
+                blocks.push_back(codewords[error_offset + i * block_count + b]);
+        }
+        return blocks;
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <array>
+#include <qrcode/code/sequence.h>
+
+namespace qrcode::code::test
+{
+    constexpr auto block_data_size_returns_the_data_size_of_short_blocks_before_normal_ones()
+    {
+        constexpr auto any_sequence = sequence_description{{2,1}, {3,2}, 6};
+
+        static_assert(block_data_size(any_sequence, 0) == 2);
+        static_assert(block_data_size(any_sequence, 1) == 3);
+        static_assert(block_data_size(any_sequence, 2) == 3);
+    }
+
+    constexpr auto deinterleave_restores_the_blocks_stored_in_a_sequence()
+    {
+        auto f = []
+        {
+            auto const any_sequence = sequence_description{{2,1}, {3,2}, 2};
+
+            auto interleaved = sequence<int>{any_sequence};
+            interleaved.next(std::array{0,1}, std::array{10,11});
+            interleaved.next(std::array{2,3,4}, std::array{12,13});
+            interleaved.next(std::array{5,6,7}, std::array{14,15});
+
+            return std::ranges::equal(
+                deinterleave(any_sequence, interleaved.get()),
+                std::array{0,1,10,11, 2,3,4,12,13, 5,6,7,14,15}
+            );
+        };
+        static_assert(f());
+    }
+
+    constexpr auto deinterleave_restores_sequences_without_normal_blocks()
+    {
+        auto f = []
+        {
+            auto const any_sequence = sequence_description{{3,2}, {4,0}, 1};
+
+            auto interleaved = sequence<int>{any_sequence};
+            interleaved.next(std::array{0,1,2}, std::array{10});
+            interleaved.next(std::array{3,4,5}, std::array{11});
+
+            return std::ranges::equal(
+                deinterleave(any_sequence, interleaved.get()),
+                std::array{0,1,2,10, 3,4,5,11}
+            );
+        };
+        static_assert(f());
+    }
+}
+#endif
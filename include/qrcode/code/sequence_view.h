@@ -32,7 +32,7 @@
 
 namespace qrcode::code
 {
-    template<std::ranges::viewable_range Range>
+    template<int Capacity = cx::default_capacity, std::ranges::viewable_range Range>
     requires std::is_same_v<
         std::ranges::range_value_t<Range>, 
         code_block<typename std::ranges::range_value_t<Range>::value_type>
@@ -43,7 +43,7 @@ namespace qrcode::code
         using std::ranges::reverse_view;
         using value_type = std::ranges::range_value_t<Range>::value_type;
 
-        auto code_sequence = sequence<value_type>{description};
+        auto code_sequence = sequence<value_type, Capacity>{description};
 
         auto space_left = total_blocks(description);
         for (auto i = begin(range); i != end(range) && space_left > 0; ++i, --space_left)
@@ -62,25 +62,28 @@ namespace qrcode::code
 
 namespace qrcode::code::views::detail
 {
+    template<int Capacity>
     struct sequence_view_adaptor
     {
         sequence_description description;
     };
 
-    template<std::ranges::viewable_range Range>
-    [[nodiscard]] constexpr auto operator|(Range&& range, sequence_view_adaptor adaptor) noexcept
+    template<std::ranges::viewable_range Range, int Capacity>
+    [[nodiscard]] constexpr auto operator|(Range&& range, sequence_view_adaptor<Capacity> adaptor) noexcept
     {
-        return sequence_view(std::forward<Range>(range), adaptor.description);
+        return sequence_view<Capacity>(std::forward<Range>(range), adaptor.description);
     }
 }
 
 namespace qrcode::code::views
 {
-    inline constexpr auto sequence = [](sequence_description description)
+    // the capacity bounds the codewords of the symbol, it is copied along with the view
+    template<int Capacity = cx::default_capacity>
+    [[nodiscard]] constexpr auto sequence(sequence_description description) noexcept
     {
         using qrcode::code::views::detail::sequence_view_adaptor;
-        return sequence_view_adaptor{std::move(description)};
-    };
+        return sequence_view_adaptor<Capacity>{std::move(description)};
+    }
 }
 
 namespace qrcode::views
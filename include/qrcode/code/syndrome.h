@@ -0,0 +1,206 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <concepts>
+
+#include <qrcode/code/gf2p8.h>
+#include <qrcode/code/polynomial.h>
+#include <qrcode/code/power_table.h>
+
+namespace qrcode::code::detail
+{
+    // horner scheme in the logarithmic domain: x is given by its exponent of the primitive element
+    template<std::ranges::input_range Codewords>
+    [[nodiscard]] constexpr auto evaluate_at_power(Codewords&& received, int exponent) noexcept
+    {
+        auto result = std::uint8_t{0};
+        for (auto i : received)
+        {
+            auto const codeword = std::to_integer<std::uint8_t>(static_cast<std::byte>(gf2p8{i}));
+            result = result == 0 
+                ? codeword
+                : static_cast<std::uint8_t>(powers.exponential[powers.logarithm[result] + exponent] ^ codeword);
+        }
+        return gf2p8{result};
+    }
+
+    // qr symbols use at most 30 error correction codewords per block
+    inline constexpr auto max_syndrome_count = 30;
+
+    using multiplication_table = std::array<std::array<std::uint8_t, 256>, max_syndrome_count>;
+
+    // the products of every field element with 2^j
+    [[nodiscard]] constexpr auto make_power_multiples() noexcept
+    {
+        auto tables = multiplication_table{};
+        for (auto j = 0; j != max_syndrome_count; ++j)
+            for (auto x = 1; x != 256; ++x)
+                tables[j][x] = powers.exponential[powers.logarithm[x] + j];
+        return tables;
+    }
+
+    inline constexpr auto power_multiples = make_power_multiples();
+
+    // all syndromes in a single pass, every codeword costs one lookup per syndrome
+    template<std::ranges::input_range Codewords>
+    [[nodiscard]] constexpr auto evaluate_at_powers(Codewords&& received, int count) noexcept
+    {
+        auto results = std::array<std::uint8_t, max_syndrome_count>{};
+        for (auto i : received)
+        {
+            auto const codeword = std::to_integer<std::uint8_t>(static_cast<std::byte>(gf2p8{i}));
+            for (auto j = 0; j != count; ++j)
+                results[j] = power_multiples[j][results[j]] ^ codeword;
+        }
+        return results;
+    }
+}
+
+namespace qrcode::code
+{
+    // received codewords are ordered as transmitted: highest degree first
+    template<std::ranges::input_range Codewords>
+    requires std::convertible_to<std::ranges::range_value_t<Codewords>, gf2p8>
+    [[nodiscard]] constexpr auto evaluate(Codewords&& received, gf2p8 x) noexcept
+    {
+        auto result = 0_gf;
+        for (auto i : received)
+            result = result * x + gf2p8{i};
+        return result;
+    }
+
+    template<std::ranges::forward_range Codewords>
+    requires std::convertible_to<std::ranges::range_value_t<Codewords>, gf2p8>
+    [[nodiscard]] constexpr auto syndromes(Codewords&& received, int error_size) noexcept
+    {
+        using qrcode::code::detail::evaluate_at_power;
+        using qrcode::code::detail::evaluate_at_powers;
+        using qrcode::code::detail::max_syndrome_count;
+
+        // the roots of the generator polynomial are 2^0, 2^1, ..., 2^(n-1)
+        auto result = polynomial<gf2p8>(error_size-1, 0_gf);
+        if (error_size <= max_syndrome_count)
+        {
+            auto const values = evaluate_at_powers(received, error_size);
+            std::ranges::transform(values | std::views::take(error_size), begin(result), 
+                [](auto v) { return gf2p8{v}; });
+            return result;
+        }
+
+        auto exponent = 0;
+        for (auto& i : result)
+            i = evaluate_at_power(received, exponent++);
+        return result;
+    }
+
+    template<std::ranges::forward_range Codewords>
+    requires std::convertible_to<std::ranges::range_value_t<Codewords>, gf2p8>
+    [[nodiscard]] constexpr auto is_error_free(Codewords&& received, int error_size) noexcept
+    {
+        using qrcode::code::detail::evaluate_at_power;
+        using qrcode::code::detail::evaluate_at_powers;
+        using qrcode::code::detail::max_syndrome_count;
+
+        if (error_size <= max_syndrome_count)
+            return std::ranges::all_of(
+                evaluate_at_powers(received, error_size), [](auto v) { return v == 0; });
+
+        for (auto i = 0; i != error_size; ++i)
+            if (evaluate_at_power(received, i) != 0_gf)
+                return false;
+        return true;
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+namespace qrcode::code::detail::test
+{
+    constexpr auto evaluate_at_power_agrees_with_evaluate_at_the_corresponding_element()
+    {
+        constexpr auto any_codewords = std::array{0x10_gf, 0x20_gf, 0x0C_gf, 0x56_gf, 0x61_gf, 0x80_gf};
+
+        static_assert(evaluate_at_power(any_codewords, 0) == evaluate(any_codewords, 1_gf));
+        static_assert(evaluate_at_power(any_codewords, 1) == evaluate(any_codewords, 2_gf));
+        static_assert(evaluate_at_power(any_codewords, 8) == evaluate(any_codewords, 0x1D_gf));
+    }
+
+    constexpr auto evaluate_at_powers_agrees_with_evaluate_at_power_for_every_exponent()
+    {
+        constexpr auto any_codewords = std::array{0x10_gf, 0x20_gf, 0x0C_gf, 0x56_gf, 0x61_gf, 0x80_gf};
+        constexpr auto values = evaluate_at_powers(any_codewords, max_syndrome_count);
+
+        static_assert(gf2p8{values[0]} == evaluate_at_power(any_codewords, 0));
+        static_assert(gf2p8{values[7]} == evaluate_at_power(any_codewords, 7));
+        static_assert(gf2p8{values[29]} == evaluate_at_power(any_codewords, 29));
+    }
+}
+
+namespace qrcode::code::test
+{
+    constexpr auto evaluate_computes_the_value_of_given_codewords_as_polynomial_at_given_point()
+    {
+        static_assert(evaluate(std::array<gf2p8,0>{}, 2_gf) == 0_gf);
+        static_assert(evaluate(std::array{7_gf}, 2_gf) == 7_gf);
+        static_assert(evaluate(std::array{1_gf, 0_gf}, 2_gf) == 2_gf);
+        static_assert(evaluate(std::array{1_gf, 1_gf, 0_gf}, 2_gf) == 6_gf);
+        static_assert(evaluate(std::array{1_gf, 0_gf, 0_gf, 0_gf, 0_gf, 0_gf, 0_gf, 0_gf, 0_gf}, 2_gf) == 0x1D_gf);
+    }
+
+    constexpr auto syndromes_of_codewords_without_errors_are_zero()
+    {
+        // x^2 + 3x + 2, the generator polynomial of degree 2, is a valid codeword itself
+        constexpr auto any_codeword = std::array{1_gf, 3_gf, 2_gf};
+        
+        static_assert(syndromes(any_codeword, 2) == polynomial{{0_gf, 0_gf}});
+        static_assert(is_error_free(any_codeword, 2));
+    }
+
+    constexpr auto syndromes_of_codewords_with_errors_are_not_zero()
+    {
+        constexpr auto any_corrupted_codeword = std::array{1_gf, 3_gf, 3_gf};
+        
+        static_assert(syndromes(any_corrupted_codeword, 2) == polynomial{{1_gf, 1_gf}});
+        static_assert(!is_error_free(any_corrupted_codeword, 2));
+    }
+
+    constexpr auto syndromes_of_codewords_of_the_iso_example_are_zero()
+    {
+        // 1-M example from ISO/IEC 18004 annex I: 16 data and 10 error correction codewords
+        constexpr auto any_codeword = std::array{
+            0x10_gf, 0x20_gf, 0x0C_gf, 0x56_gf, 0x61_gf, 0x80_gf, 0xEC_gf, 0x11_gf, 
+            0xEC_gf, 0x11_gf, 0xEC_gf, 0x11_gf, 0xEC_gf, 0x11_gf, 0xEC_gf, 0x11_gf,
+            0xA5_gf, 0x24_gf, 0xD4_gf, 0xC1_gf, 0xED_gf, 0x36_gf, 0xC7_gf, 0x87_gf, 
+            0x2C_gf, 0x55_gf
+        };
+
+        static_assert(is_error_free(any_codeword, 10));
+    }
+}
+#endif
@@ -0,0 +1,144 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <qrcode/packed_symbol.h>
+#include <qrcode/result.h>
+
+#include <qrcode/cache/fnv_hash.h>
+#include <qrcode/eci/view.h>
+#include <qrcode/micro_qr/error_correction.h>
+#include <qrcode/micro_qr/symbol_designator.h>
+#include <qrcode/micro_qr/symbol_version.h>
+#include <qrcode/qr/error_correction.h>
+#include <qrcode/qr/symbol_designator.h>
+#include <qrcode/qr/symbol_version.h>
+#include <qrcode/structure/module.h>
+
+// The templates of make_symbol are instantiated for every message type anew, each one a full copy of
+// optimizer, encoders, error correction, placement and masking. The functions below are compiled only once,
+// in the qrcode_core library (cmake option QRCODE_CORE_ENABLED), and the range templates merely hand their
+// bytes over. Symbols come back packed, so the module type costs no copy of the core either.
+namespace qrcode::core
+{
+    using qr_symbol = packed_symbol<qr::symbol_designator>;
+    using micro_qr_symbol = packed_symbol<micro_qr::symbol_designator>;
+
+    [[nodiscard]] auto make_qr_symbol(
+        std::span<std::byte const> message, 
+        std::optional<std::int32_t> eci_assignment_number,
+        qr::error_correction error_level,
+        std::optional<qr::symbol_version> version = std::nullopt) -> result<qr_symbol>;
+
+    [[nodiscard]] auto make_micro_qr_symbol(
+        std::span<std::byte const> message, 
+        std::optional<micro_qr::error_correction> error_level,
+        std::optional<micro_qr::symbol_version> version = std::nullopt) -> result<micro_qr_symbol>;
+}
+
+namespace qrcode::core::detail
+{
+    template<class Message>
+    concept Byte_Message = std::ranges::input_range<Message> 
+        && sizeof(std::ranges::range_value_t<Message>) == 1
+        && (std::integral<std::ranges::range_value_t<Message>> 
+            || std::same_as<std::ranges::range_value_t<Message>, std::byte>);
+
+    // contiguous messages are passed on as they are, any other range is copied once
+    template<Byte_Message Message, class Use>
+    [[nodiscard]] auto with_bytes(Message&& message, Use use)
+    {
+        using qrcode::cache::detail::octet;
+
+        if constexpr (std::ranges::contiguous_range<Message> && std::ranges::sized_range<Message>)
+        {
+            auto const size = static_cast<std::size_t>(std::ranges::size(message));
+            return use(std::as_bytes(std::span{std::ranges::data(message), size}));
+        }
+        else
+        {
+            auto bytes = std::vector<std::byte>{};
+            for (auto i : message)
+                bytes.push_back(std::byte{octet(i)});
+            return use(std::span<std::byte const>{bytes});
+        }
+    }
+
+    template<class Module, Symbol_Designator Designator>
+    [[nodiscard]] auto unpack_result(result<packed_symbol<Designator>> const& packed)
+    {
+        using symbol_type = symbol<Module, Designator>;
+        if (!packed)
+            return result<symbol_type>{packed.error()};
+        return result<symbol_type>{unpack<Module>(packed.value())};
+    }
+}
+
+namespace qrcode::core
+{
+    using qrcode::structure::module;
+
+    template<class Module = module, detail::Byte_Message Message>
+    [[nodiscard]] auto make_qr_symbol(
+        Message&& message, 
+        qr::error_correction error_level, 
+        std::optional<qr::symbol_version> version = std::nullopt)
+    {
+        using qrcode::core::detail::unpack_result;
+        using qrcode::core::detail::with_bytes;
+
+        auto eci_assignment_number = std::optional<std::int32_t>{};
+        if constexpr (is_eci_view_v<std::remove_cvref_t<Message>>)
+            eci_assignment_number = header(message).eci_assignment_number.value;
+
+        return unpack_result<Module>(with_bytes(std::forward<Message>(message), [&](auto bytes)
+        {
+            return make_qr_symbol(bytes, eci_assignment_number, error_level, version);
+        }));
+    }
+
+    template<class Module = module, detail::Byte_Message Message>
+    [[nodiscard]] auto make_micro_qr_symbol(
+        Message&& message, 
+        std::optional<micro_qr::error_correction> error_level = std::nullopt,
+        std::optional<micro_qr::symbol_version> version = std::nullopt)
+    {
+        using qrcode::core::detail::unpack_result;
+        using qrcode::core::detail::with_bytes;
+
+        return unpack_result<Module>(with_bytes(std::forward<Message>(message), [&](auto bytes)
+        {
+            return make_micro_qr_symbol(bytes, error_level, version);
+        }));
+    }
+}
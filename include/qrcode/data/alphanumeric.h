@@ -57,15 +57,20 @@ namespace qrcode::data
         return result;
     }
 
-    [[nodiscard]] constexpr auto make_alphanumeric(char symbol) noexcept 
+    [[nodiscard]] constexpr auto alphanumeric_characters() noexcept 
     {
-        constexpr auto set = std::array{
+        return std::array{
             '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 
             'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 
             'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 
             'U', 'V', 'W', 'X', 'Y', 'Z', ' ', '$', '%', '*', 
             '+', '-', '.', '/', ':'
         };
+    }
+
+    [[nodiscard]] constexpr auto make_alphanumeric(char symbol) noexcept 
+    {
+        constexpr auto set = alphanumeric_characters();
 
         auto const found = std::ranges::find(set, symbol);
 
@@ -74,6 +79,11 @@ namespace qrcode::data
             : std::optional<alphanumeric>{static_cast<alphanumeric>(std::distance(begin(set), found))};
     }
 
+    [[nodiscard]] constexpr auto ascii(alphanumeric character) noexcept 
+    {
+        return alphanumeric_characters()[number(character)];
+    }
+
     template<std::ranges::forward_range Message>
     requires std::convertible_to<std::ranges::range_value_t<Message>, char>
     [[nodiscard]] constexpr auto all_alphanumerics(Message&& message) noexcept
@@ -257,5 +267,14 @@ namespace qrcode::data::test
         static_assert(all_alphanumerics("ABC123"sv));
         static_assert(!all_alphanumerics("ABC&23"sv));
     }
+
+    constexpr auto alphanumerics_can_be_converted_back_to_their_ascii_symbols()
+    {
+        static_assert(ascii(alphanumeric::code_0) == '0');
+        static_assert(ascii(alphanumeric::code_Z) == 'Z');
+        static_assert(ascii(alphanumeric::code_space) == ' ');
+        static_assert(ascii(alphanumeric::code_colon) == ':');
+        static_assert(ascii(*make_alphanumeric('%')) == '%');
+    }
 }
 #endif
@@ -27,6 +27,9 @@
 #include <cassert>
 
 #include <qrcode/data/alphanumeric_encoding.h>
+#include <cx/vector.h>
+
+#include <qrcode/data/bit_reader.h>
 #include <qrcode/data/bit_stream.h>
 #include <qrcode/data/indicator.h>
 
@@ -71,7 +74,25 @@ namespace qrcode::data
             encode(stream, count, alphanumeric_character_count(message));
             encode_alphanumerics(stream, alphanumerics); 
         }
-        
+
+        template<int N>
+        [[nodiscard]] constexpr auto read_segment(bit_reader& reader, cx::vector<char, N>& message) const noexcept
+        {
+            using qrcode::data::decode;
+            auto const character_count = decode(reader, count);
+            return character_count && decode_alphanumerics(reader, *character_count, message);
+        }
+
+        [[nodiscard]] friend constexpr auto mode(alphanumeric_encoder const& encoder) noexcept
+        {
+            return encoder.mode;
+        }
+
+        [[nodiscard]] friend constexpr auto count(alphanumeric_encoder const& encoder) noexcept
+        {
+            return encoder.count;
+        }
+
     private:
         mode_indicator mode;
         count_indicator count;
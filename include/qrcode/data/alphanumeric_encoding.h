@@ -25,7 +25,10 @@
 
 #include <ranges>
 
+#include <cx/vector.h>
+
 #include <qrcode/data/alphanumeric.h>
+#include <qrcode/data/bit_reader.h>
 #include <qrcode/data/bit_stream.h>
 
 namespace qrcode::data::detail
@@ -51,6 +54,25 @@ namespace qrcode::data::detail
     {
         stream.add(number(symbol), alphanumeric_single_size());
     }
+
+    template<int N>
+    [[nodiscard]] constexpr auto decode_alphanumeric_group(
+        bit_reader& reader, number_bits size, int character_count, cx::vector<char, N>& message) noexcept
+    {
+        constexpr auto set_size = 45;
+
+        auto const code = reader.read(size);
+        auto limit = 1;
+        for (auto i = 0; i != character_count; ++i)
+            limit *= set_size;
+
+        if (!code || *code >= limit)
+            return false;
+
+        for (limit /= set_size; limit != 0; limit /= set_size)
+            message.push_back(ascii(static_cast<alphanumeric>(*code / limit % set_size)));
+        return true;
+    }
 }
 
 namespace qrcode::data
@@ -77,6 +99,24 @@ namespace qrcode::data
             single_alphanumeric(stream, *current);
     }
 
+    template<int N>
+    [[nodiscard]] constexpr auto decode_alphanumerics(
+        bit_reader& reader, int character_count, cx::vector<char, N>& message) noexcept
+    {
+        using qrcode::data::detail::decode_alphanumeric_group;
+        using qrcode::data::detail::alphanumeric_single_size;
+        using qrcode::data::detail::alphanumeric_pair_size;
+
+        auto valid = true;
+        for (; valid && character_count >= 2; character_count -= 2)
+            valid = decode_alphanumeric_group(reader, alphanumeric_pair_size(), 2, message);
+
+        if (valid && character_count != 0)
+            valid = decode_alphanumeric_group(reader, alphanumeric_single_size(), 1, message);
+
+        return valid;
+    }
+
     template<std::ranges::sized_range Message>
     [[nodiscard]] static constexpr auto alphanumeric_character_count(Message&& message) noexcept
     {
@@ -219,5 +259,27 @@ namespace qrcode::data::test
         static_assert(alphanumeric_bit_count("ABCDE"sv) == (11+11+6));
         static_assert(alphanumeric_bit_count("ABCDEF"sv) == (11+11+11));
     }
+
+    constexpr auto decode_alphanumerics_restores_the_characters_of_encoded_alphanumerics()
+    {
+        auto f = [](auto message)
+        {
+            auto stream = bit_stream{};
+            encode_alphanumerics(stream, message | std::views::transform([](auto c){ return *make_alphanumeric(c); }));
+
+            auto const bits = stream.get();
+            auto reader = bit_reader{bits};
+            auto decoded = cx::vector<char>{};
+            return decode_alphanumerics(reader, alphanumeric_character_count(message), decoded)
+                && std::ranges::equal(decoded, message)
+                && reader.remaining() == 0;
+        };
+
+        using namespace std::literals;
+        static_assert(f(""sv));
+        static_assert(f("A"sv));
+        static_assert(f("AC-42"sv));
+        static_assert(f("HELLO WORLD $%*+-./:"sv));
+    }
 }
 #endif
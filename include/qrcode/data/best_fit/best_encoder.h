@@ -28,6 +28,7 @@
 #include <ranges>
 #include <variant>
 #include <qrcode/data/encoders.h>
+#include <qrcode/data/best_fit/character_classes.h>
 
 namespace qrcode::data::best_fit::detail
 {
@@ -50,48 +51,33 @@ namespace qrcode::data::best_fit::detail
 
 namespace qrcode::data::best_fit
 {
-    template<std::ranges::forward_range Message, bool encodersNullable>
+    template<bool encodersNullable>
     [[nodiscard]] constexpr auto best_encoder(
-        Message&& message, encoders<encodersNullable> const& encoders) noexcept
+        character_classes const& classes, encoders<encodersNullable> const& encoders) noexcept
     {
-        using message_value_type = std::ranges::range_value_t<Message>;
-        constexpr auto can_numeric = 
-            std::convertible_to<message_value_type, char> ||
-            std::same_as<message_value_type, numeric>;
-
-        constexpr auto can_alphanumeric = 
-            std::convertible_to<message_value_type, char> ||
-            std::same_as<message_value_type, alphanumeric>;
-
-        constexpr auto can_kanji = 
-            std::convertible_to<message_value_type, std::uint8_t> || 
-            std::same_as<message_value_type, std::byte>;
-
         using encoder = std::variant<
             numeric_encoder, alphanumeric_encoder, byte_encoder, kanji_encoder
         >;
         using qrcode::data::best_fit::detail::make_variant;
         
-        if constexpr (can_numeric)
-        {
-            if (all_numerics(message))
-                return make_variant<encoder>(encoders.numeric);
-        }
+        if (classes.numeric)
+            return make_variant<encoder>(encoders.numeric);
 
-        if constexpr (can_alphanumeric)
-        {
-            if (all_alphanumerics(message))
-                return make_variant<encoder>(encoders.alphanumeric);
-        }
+        if (classes.alphanumeric)
+            return make_variant<encoder>(encoders.alphanumeric);
 
-        if constexpr (can_kanji)
-        {
-            if (all_kanjis(message))
-                return make_variant<encoder>(encoders.kanji);
-        }
+        if (classes.kanji)
+            return make_variant<encoder>(encoders.kanji);
 
         return make_variant<encoder>(encoders.byte);
     }
+
+    template<std::ranges::forward_range Message, bool encodersNullable>
+    [[nodiscard]] constexpr auto best_encoder(
+        Message&& message, encoders<encodersNullable> const& encoders) noexcept
+    {
+        return best_encoder(classify(message), encoders);
+    }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
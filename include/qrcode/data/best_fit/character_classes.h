@@ -0,0 +1,128 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+
+#include <qrcode/data/alphanumeric.h>
+#include <qrcode/data/kanji.h>
+#include <qrcode/data/numeric.h>
+
+namespace qrcode::data::best_fit
+{
+    // which modes are able to encode the whole message,
+    // gathered once so that every symbol version can reuse it
+    struct character_classes
+    {
+        bool numeric = false;
+        bool alphanumeric = false;
+        bool kanji = false;
+
+        [[nodiscard]] constexpr auto operator==(character_classes const&) const noexcept -> bool = default;
+        [[nodiscard]] constexpr auto operator!=(character_classes const&) const noexcept -> bool = default;
+    };
+
+    // same results as all_numerics, all_alphanumerics and all_kanjis, but in a single pass
+    template<std::ranges::forward_range Message>
+    [[nodiscard]] constexpr auto classify(Message&& message) noexcept
+    {
+        using message_value_type = std::ranges::range_value_t<Message>;
+        constexpr auto can_numeric = 
+            std::convertible_to<message_value_type, char> ||
+            std::same_as<message_value_type, numeric>;
+
+        constexpr auto can_alphanumeric = 
+            std::convertible_to<message_value_type, char> ||
+            std::same_as<message_value_type, alphanumeric>;
+
+        constexpr auto can_kanji = 
+            std::convertible_to<message_value_type, std::uint8_t> || 
+            std::same_as<message_value_type, std::byte>;
+
+        auto classes = character_classes{can_numeric, can_alphanumeric, can_kanji};
+        [[maybe_unused]] auto leading = message_value_type{};
+        auto length = 0;
+
+        for (auto const& c : message)
+        {
+            if constexpr (can_numeric)
+                classes.numeric = classes.numeric && is_numeric(c);
+
+            if constexpr (can_alphanumeric)
+                classes.alphanumeric = classes.alphanumeric && is_alphanumeric(c);
+
+            if constexpr (can_kanji)
+            {
+                if (length % 2 == 0)
+                    leading = c;
+                else
+                    classes.kanji = classes.kanji && is_kanji(leading, static_cast<message_value_type>(c));
+            }
+            ++length;
+        }
+
+        classes.kanji = classes.kanji && length % 2 == 0;
+        return classes;
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <array>
+#include <string_view>
+
+namespace qrcode::data::best_fit::test
+{
+    constexpr auto classify_tells_which_modes_can_encode_the_whole_message()
+    {
+        using namespace std::literals;
+        static_assert(classify(""sv) == character_classes{true, true, true});
+        static_assert(classify("31415"sv) == character_classes{true, true, false});
+        static_assert(classify("HELLO WORLD"sv) == character_classes{false, true, false});
+        static_assert(classify("hello"sv) == character_classes{false, false, false});
+        static_assert(classify("\x93\x5F\xE4\xAA"sv) == character_classes{false, false, true});
+        static_assert(classify("\x93\x5F\xE4"sv) == character_classes{false, false, false});
+    }
+
+    constexpr auto classify_agrees_with_the_separate_checks()
+    {
+        auto f = [](auto text)
+        {
+            auto const classes = classify(text);
+            return classes.numeric == all_numerics(text)
+                && classes.alphanumeric == all_alphanumerics(text)
+                && classes.kanji == all_kanjis(text);
+        };
+
+        using namespace std::literals;
+        static_assert(f("0123"sv));
+        static_assert(f("AB:C"sv));
+        static_assert(f("\x93\x5F"sv));
+        static_assert(f("\x93\x5Fx"sv));
+        static_assert(f("x\x93\x5F"sv));
+    }
+}
+#endif
@@ -32,9 +32,10 @@ namespace qrcode::data::best_fit
 {
     template<class Message>
     [[nodiscard]] constexpr auto encode_data(
-        bit_stream& stream, nullable_encoders const& encoders, Message&& message) noexcept
+        bit_stream& stream, nullable_encoders const& encoders, 
+        Message&& message, character_classes const& classes) noexcept
     {
-        auto const encoder = best_encoder(message, encoders);
+        auto const encoder = best_encoder(classes, encoders);
         if (!encoder)
            return false;
 
@@ -42,6 +43,13 @@ namespace qrcode::data::best_fit
         return true;
     }
 
+    template<class Message>
+    [[nodiscard]] constexpr auto encode_data(
+        bit_stream& stream, nullable_encoders const& encoders, Message&& message) noexcept
+    {
+        return encode_data(stream, encoders, message, classify(message));
+    }
+
     template<class Message>
     [[nodiscard]] constexpr auto encode_data(
         bit_stream& stream, nonull_encoders const& encoders, Message&& message) noexcept
@@ -27,19 +27,23 @@
 
 namespace qrcode::data::best_fit
 {
+    // the message is only asked for its size, the modes are taken from given classes
     template<class Message>
     [[nodiscard]] constexpr auto data_length(
-        nullable_encoders const& encoders, Message&& message) noexcept
+        nullable_encoders const& encoders, Message&& message, character_classes const& classes) noexcept
     {
-        auto length = std::optional{0};
-        auto const encoder = best_encoder(message, encoders);
+        auto const encoder = best_encoder(classes, encoders);
         if (!encoder)
-            length = decltype(length){};
+            return std::optional<int>{};
 
-        if (length && encoder)
-            *length += std::visit([&](auto&& encoder){ return encoder.bit_count(message); }, *encoder);
+        return std::optional{std::visit([&](auto&& encoder){ return encoder.bit_count(message); }, *encoder)};
+    }
 
-        return length;
+    template<class Message>
+    [[nodiscard]] constexpr auto data_length(
+        nullable_encoders const& encoders, Message&& message) noexcept
+    {
+        return data_length(encoders, message, classify(message));
     }
 
     template<class Message>
@@ -50,4 +54,3 @@ namespace qrcode::data::best_fit
         return std::visit([&](auto&& encoder){ return encoder.bit_count(message); }, encoder);
     }
 }
-
@@ -0,0 +1,95 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <optional>
+#include <ranges>
+
+#include <cx/vector.h>
+
+#include <qrcode/data/bit_stream.h>
+
+namespace qrcode::data
+{
+    class bit_reader
+    {
+    public:
+        constexpr explicit bit_reader(cx::vector<bool> const& bits) noexcept
+        : stream{&bits}
+        {
+        }
+
+        [[nodiscard]] constexpr auto remaining() const noexcept
+        {
+            using std::ranges::size;
+            return static_cast<int>(size(*stream)) - position;
+        }
+
+        [[nodiscard]] constexpr auto read(number_bits size) noexcept -> std::optional<int>
+        {
+            if (size.value > remaining())
+                return std::optional<int>{};
+
+            auto data = 0;
+            for (auto i = 0; i != size.value; ++i)
+                data = data << 1 | ((*stream)[position++] ? 1 : 0);
+            return std::optional<int>{data};
+        }
+
+    private:
+        cx::vector<bool> const* stream;
+        int position = 0;
+    };
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+namespace qrcode::data::test
+{
+    constexpr auto bit_readers_return_integers_of_given_bit_count_msb_first()
+    {
+        auto f = []
+        {
+            auto const some_bits = bit_stream{}.add(0b110, 3_bits).add(0b00010, 5_bits).get();
+            auto reader = bit_reader{some_bits};
+
+            auto const first = reader.read(3_bits);
+            auto const second = reader.read(5_bits);
+            return first == 0b110 && second == 0b00010 && reader.remaining() == 0;
+        };
+        static_assert(f());
+    }
+
+    constexpr auto bit_readers_return_nothing_if_fewer_bits_remain_than_requested()
+    {
+        auto f = []
+        {
+            auto const some_bits = bit_stream{}.add(0b10, 2_bits).get();
+            auto reader = bit_reader{some_bits};
+
+            return !reader.read(3_bits) && reader.remaining() == 2 && reader.read(0_bits) == 0;
+        };
+        static_assert(f());
+    }
+}
+#endif
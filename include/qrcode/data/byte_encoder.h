@@ -26,6 +26,9 @@
 #include <cstddef>
 #include <ranges>
 
+#include <cx/vector.h>
+
+#include <qrcode/data/bit_reader.h>
 #include <qrcode/data/bit_stream.h>
 #include <qrcode/data/indicator.h>
 
@@ -68,6 +71,36 @@ namespace qrcode::data
                 stream.add(static_cast<std::uint8_t>(i), bits_in_byte());
         }
 
+        template<int N>
+        [[nodiscard]] constexpr auto read_segment(bit_reader& reader, cx::vector<char, N>& message) const noexcept
+        {
+            using qrcode::data::decode;
+            using qrcode::data::detail::bits_in_byte;
+
+            auto const byte_count = decode(reader, count);
+            if (!byte_count)
+                return false;
+
+            for (auto i = 0; i != *byte_count; ++i)
+            {
+                auto const byte = reader.read(bits_in_byte());
+                if (!byte)
+                    return false;
+                message.push_back(static_cast<char>(*byte));
+            }
+            return true;
+        }
+
+        [[nodiscard]] friend constexpr auto mode(byte_encoder const& encoder) noexcept
+        {
+            return encoder.mode;
+        }
+
+        [[nodiscard]] friend constexpr auto count(byte_encoder const& encoder) noexcept
+        {
+            return encoder.count;
+        }
+
     private:
         mode_indicator mode;
         count_indicator count;
@@ -115,5 +148,25 @@ namespace qrcode::data::detail::test
         };
         static_assert(f());
     }
+
+    constexpr auto byte_encoder_reads_back_the_bytes_of_a_segment_without_its_mode_indicator()
+    {
+        auto f = []
+        {
+            using namespace qrcode::data::literals;
+            auto const any_mode_indicator = mode_indicator{.value = 0b11, .bit_count = 2};
+            auto const any_count_indicator = count_indicator{.bit_count = 3};
+            auto const bits = bit_stream{}.add(0b010, 3_bits).add(0x41, 8_bits).add(0xFE, 8_bits).get();
+            auto reader = bit_reader{bits};
+            auto decoded = cx::vector<char>{};
+
+            auto const encoder = byte_encoder{any_mode_indicator, any_count_indicator};
+
+            return encoder.read_segment(reader, decoded)
+                && std::ranges::equal(decoded, std::array{'\x41', '\xFE'})
+                && mode(encoder) == any_mode_indicator;
+        };
+        static_assert(f());
+    }
 }
 #endif
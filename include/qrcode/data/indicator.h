@@ -23,6 +23,7 @@
  */
 #pragma once
 
+#include <qrcode/data/bit_reader.h>
 #include <qrcode/data/bit_stream.h>
 
 namespace qrcode::data
@@ -52,6 +53,11 @@ namespace qrcode::data
     {
         stream.add(character_count, number_bits{count.bit_count});
     }
+
+    [[nodiscard]] constexpr auto decode(bit_reader& reader, count_indicator const& count) noexcept
+    {
+        return reader.read(number_bits{count.bit_count});
+    }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
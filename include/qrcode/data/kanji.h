@@ -30,11 +30,18 @@ namespace qrcode::data::detail
 {
     [[nodiscard]] constexpr auto compress_kanji(std::uint16_t shift_jis) noexcept
     {
-        auto const base = shift_jis < 0x9FFCu ? 0x8140u : 0xC140u;
+        auto const base = shift_jis <= 0x9FFCu ? 0x8140u : 0xC140u;
         auto const intermediate = shift_jis - base;
         return static_cast<std::uint16_t>((intermediate >> 8) * 0xC0u + (intermediate & 0xFF));
     }
 
+    [[nodiscard]] constexpr auto decompress_kanji(std::uint16_t compressed) noexcept
+    {
+        auto const intermediate = (compressed / 0xC0u) << 8 | (compressed % 0xC0u);
+        auto const base = intermediate < 0x1F00u ? 0x8140u : 0xC140u;
+        return static_cast<std::uint16_t>(intermediate + base);
+    }
+
     [[nodiscard]] constexpr auto double_byte(std::uint8_t leading, std::uint8_t trailing) noexcept
     {
         return static_cast<std::uint16_t>(leading << 8 | trailing);
@@ -118,6 +125,16 @@ namespace qrcode::data::detail::test
         static_assert(compress_kanji(0xE4AAu) == 0x1AAA);
     }
 
+    constexpr auto decompress_kanji_restores_the_shift_jis_character_of_a_compact_13_bit_number()
+    {
+        static_assert(decompress_kanji(0xD9Fu) == 0x935Fu);
+        static_assert(decompress_kanji(0x1AAA) == 0xE4AAu);
+        static_assert(decompress_kanji(compress_kanji(0x8140u)) == 0x8140u);
+        static_assert(decompress_kanji(compress_kanji(0x9FFCu)) == 0x9FFCu);
+        static_assert(decompress_kanji(compress_kanji(0xE040u)) == 0xE040u);
+        static_assert(decompress_kanji(compress_kanji(0xEBBFu)) == 0xEBBFu);
+    }
+
     constexpr auto double_byte_returns_a_16_bit_number_derived_from_given_upper_and_lower_byte()
     {
         static_assert(double_byte(0x00u, 0x00u) == 0x0000u);
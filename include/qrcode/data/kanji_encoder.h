@@ -25,6 +25,9 @@
 
 #include <ranges>
 
+#include <cx/vector.h>
+
+#include <qrcode/data/bit_reader.h>
 #include <qrcode/data/bit_stream.h>
 #include <qrcode/data/indicator.h>
 #include <qrcode/data/kanji_encoding.h>
@@ -42,7 +45,7 @@ namespace qrcode::data
         template<std::ranges::sized_range Message>
         [[nodiscard]] constexpr auto bit_count(Message&& message) const noexcept
         {
-            return kanji_bit_count(std::forward<Message>(message));
+            return mode.bit_count + count.bit_count + kanji_bit_count(std::forward<Message>(message));
         }
 
         template<std::ranges::forward_range Message>
@@ -56,6 +59,24 @@ namespace qrcode::data
             encode_kanjis(stream, std::forward<Message>(message));
         }
 
+        template<int N>
+        [[nodiscard]] constexpr auto read_segment(bit_reader& reader, cx::vector<char, N>& message) const noexcept
+        {
+            using qrcode::data::decode;
+            auto const character_count = decode(reader, count);
+            return character_count && decode_kanjis(reader, *character_count, message);
+        }
+
+        [[nodiscard]] friend constexpr auto mode(kanji_encoder const& encoder) noexcept
+        {
+            return encoder.mode;
+        }
+
+        [[nodiscard]] friend constexpr auto count(kanji_encoder const& encoder) noexcept
+        {
+            return encoder.count;
+        }
+
     private:
         mode_indicator mode;
         count_indicator count;
@@ -66,6 +87,20 @@ namespace qrcode::data
 
 namespace qrcode::data::test
 {
+    constexpr auto kanji_encoder_knows_how_many_bits_given_message_would_take_to_be_encoded()
+    {
+        auto f = []
+        {
+            constexpr auto any_message = std::array{0x93u, 0x5Fu, 0xE4u, 0xAAu};
+            auto const any_mode_indicator = mode_indicator{.value = 0b101, .bit_count = 3};
+            auto const any_count_indicator = count_indicator{.bit_count = 5};
+
+            auto const encoder = kanji_encoder{any_mode_indicator, any_count_indicator};
+            return encoder.bit_count(any_message) == (3+5+13+13);
+        };
+        static_assert(f());
+    }
+
     constexpr auto kanji_encoder_encodes_given_message()
     {
         auto f = []
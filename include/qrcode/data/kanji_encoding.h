@@ -26,6 +26,9 @@
 #include <ranges>
 #include <cassert>
 
+#include <cx/vector.h>
+
+#include <qrcode/data/bit_reader.h>
 #include <qrcode/data/bit_stream.h>
 #include <qrcode/data/kanji.h>
 
@@ -59,6 +62,31 @@ namespace qrcode::data
         }  
     }
 
+    template<int N>
+    [[nodiscard]] constexpr auto decode_kanjis(
+        bit_reader& reader, int character_count, cx::vector<char, N>& shift_jis) noexcept
+    {
+        using qrcode::data::detail::bits_per_kanji;
+        using qrcode::data::detail::decompress_kanji;
+
+        for (auto i = 0; i != character_count; ++i)
+        {
+            auto const compressed = reader.read(bits_per_kanji());
+            if (!compressed)
+                return false;
+
+            auto const double_byte = decompress_kanji(static_cast<std::uint16_t>(*compressed));
+            auto const leading = static_cast<std::uint8_t>(double_byte >> 8);
+            auto const trailing = static_cast<std::uint8_t>(double_byte & 0xFF);
+            if (!is_kanji(leading, trailing))
+                return false;
+
+            shift_jis.push_back(static_cast<char>(leading));
+            shift_jis.push_back(static_cast<char>(trailing));
+        }
+        return true;
+    }
+
     template<std::ranges::sized_range Message>
     [[nodiscard]] static constexpr auto kanji_character_count(Message&& message) noexcept
     {
@@ -151,5 +179,23 @@ namespace qrcode::data::test
         };
         static_assert(f());
     }
+
+    constexpr auto decode_kanjis_restores_the_shift_jis_bytes_of_encoded_kanjis()
+    {
+        auto f = []
+        {
+            constexpr auto any_message = std::array{0x93u, 0x5Fu, 0xE4u, 0xAAu};
+            auto stream = bit_stream{};
+            encode_kanjis(stream, any_message);
+
+            auto const bits = stream.get();
+            auto reader = bit_reader{bits};
+            auto decoded = cx::vector<char>{};
+            return decode_kanjis(reader, kanji_character_count(any_message), decoded)
+                && std::ranges::equal(decoded, any_message, {}, [](auto c){ return static_cast<std::uint8_t>(c); })
+                && reader.remaining() == 0;
+        };
+        static_assert(f());
+    }
 }
 #endif
\ No newline at end of file
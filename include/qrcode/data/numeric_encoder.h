@@ -26,6 +26,9 @@
 #include <ranges>
 #include <cassert>
 
+#include <cx/vector.h>
+
+#include <qrcode/data/bit_reader.h>
 #include <qrcode/data/bit_stream.h>
 #include <qrcode/data/numeric_encoding.h>
 
@@ -71,6 +74,24 @@ namespace qrcode::data
             encode_numerics(stream, numerics); 
         }
 
+        template<int N>
+        [[nodiscard]] constexpr auto read_segment(bit_reader& reader, cx::vector<char, N>& message) const noexcept
+        {
+            using qrcode::data::decode;
+            auto const character_count = decode(reader, count);
+            return character_count && decode_numerics(reader, *character_count, message);
+        }
+
+        [[nodiscard]] friend constexpr auto mode(numeric_encoder const& encoder) noexcept
+        {
+            return encoder.mode;
+        }
+
+        [[nodiscard]] friend constexpr auto count(numeric_encoder const& encoder) noexcept
+        {
+            return encoder.count;
+        }
+
     private:
         mode_indicator mode;
         count_indicator count;
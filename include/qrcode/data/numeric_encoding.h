@@ -24,6 +24,8 @@
 #pragma once
 
 #include <ranges>
+#include <cx/vector.h>
+#include <qrcode/data/bit_reader.h>
 #include <qrcode/data/bit_stream.h>
 #include <qrcode/data/numeric.h>
 
@@ -52,6 +54,24 @@ namespace qrcode::data::detail
     {
         stream.add(decimal_number(digits...), number_bits{bit_count(sizeof...(digits))}); 
     }
+
+    template<int N>
+    [[nodiscard]] constexpr auto decode_digits(
+        bit_reader& reader, int digit_count, cx::vector<char, N>& message) noexcept 
+    {
+        auto const decimal = reader.read(number_bits{bit_count(digit_count)});
+
+        auto power = 1;
+        for (auto i = 0; i != digit_count; ++i)
+            power *= 10;
+
+        if (!decimal || *decimal >= power)
+            return false;
+
+        for (power /= 10; power != 0; power /= 10)
+            message.push_back(static_cast<char>(0x30 + *decimal / power % 10));
+        return true;
+    }
 }
 
 namespace qrcode::data
@@ -81,6 +101,22 @@ namespace qrcode::data
             encode_digits(stream, *i, *(i+1));
     }
 
+    template<int N>
+    [[nodiscard]] constexpr auto decode_numerics(
+        bit_reader& reader, int character_count, cx::vector<char, N>& message) noexcept
+    {
+        using qrcode::data::detail::decode_digits;
+
+        auto valid = true;
+        for (; valid && character_count >= 3; character_count -= 3)
+            valid = decode_digits(reader, 3, message);
+
+        if (valid && character_count != 0)
+            valid = decode_digits(reader, character_count, message);
+
+        return valid;
+    }
+
     template<std::ranges::sized_range Message>
     [[nodiscard]] constexpr auto numeric_character_count(Message&& message) noexcept
     {
@@ -214,5 +250,40 @@ namespace qrcode::data::test
         static_assert(numeric_bit_count("12345678"sv) == (10+10+7));
         static_assert(numeric_bit_count("123456789"sv) == (10+10+10));
     }
+
+    constexpr auto decode_numerics_restores_the_digits_of_encoded_numerics()
+    {
+        auto f = [](auto message)
+        {
+            auto stream = bit_stream{};
+            encode_numerics(stream, message | std::views::transform([](auto c){ return *make_numeric(c); }));
+
+            auto const bits = stream.get();
+            auto reader = bit_reader{bits};
+            auto decoded = cx::vector<char>{};
+            return decode_numerics(reader, numeric_character_count(message), decoded)
+                && std::ranges::equal(decoded, message)
+                && reader.remaining() == 0;
+        };
+
+        using namespace std::literals;
+        static_assert(f(""sv));
+        static_assert(f("7"sv));
+        static_assert(f("07"sv));
+        static_assert(f("8675309"sv));
+        static_assert(f("01234567890"sv));
+    }
+
+    constexpr auto decode_numerics_rejects_digit_groups_exceeding_their_decimal_range()
+    {
+        auto f = []
+        {
+            auto const bits = bit_stream{}.add(1000, 10_bits).get();
+            auto reader = bit_reader{bits};
+            auto decoded = cx::vector<char>{};
+            return !decode_numerics(reader, 3, decoded);
+        };
+        static_assert(f());
+    }
 }
 #endif
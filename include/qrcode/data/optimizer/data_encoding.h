@@ -34,13 +34,13 @@ namespace qrcode::data::optimizer
     template<class Message>
     requires std::convertible_to<std::ranges::range_value_t<Message>, char>
     [[nodiscard]] constexpr auto encode_data(
-        bit_stream& stream, Message&& message, nonull_encoders const& encoders) noexcept
+        bit_stream& stream, Message&& message, nonull_encoders const& encoders, bool kanji_enabled = true) noexcept
     {
         auto write_segement = [&stream](auto const& range, auto const& encoder)
         {
             encoder.write_segment(stream, range);
         };
-        optimize(std::forward<Message>(message), encoders, write_segement);
+        optimize(std::forward<Message>(message), encoders, write_segement, kanji_enabled);
     }
 }
 
@@ -31,14 +31,14 @@ namespace qrcode::data::optimizer
     template<class Message>
     requires std::convertible_to<std::ranges::range_value_t<Message>, char>
     [[nodiscard]] constexpr auto data_length(
-        Message&& message, nonull_encoders const& encoders) noexcept
+        Message&& message, nonull_encoders const& encoders, bool kanji_enabled = true) noexcept
     {
         auto length = 0;
         auto calc_length = [&length](auto const& range, auto const& encoder)
         {
             length += encoder.bit_count(range);
         };
-        optimize(std::forward<Message>(message), encoders, calc_length);
+        optimize(std::forward<Message>(message), encoders, calc_length, kanji_enabled);
         return length;
     }
 }
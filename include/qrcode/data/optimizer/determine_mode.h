@@ -48,6 +48,12 @@ namespace qrcode::data::optimizer
 
         return mode::byte;
     }
+
+    [[nodiscard]] constexpr auto determine_mode(char value, bool kanji_enabled) noexcept
+    {
+        auto const selected = determine_mode(value);
+        return selected == mode::kanji && !kanji_enabled ? mode::byte : selected;
+    }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
@@ -62,5 +68,12 @@ namespace qrcode::data::optimizer::test
         static_assert(determine_mode('\x41') == mode::alphanumeric);
         static_assert(determine_mode('\x81') == mode::kanji);
     }
+
+    constexpr auto determine_mode_returns_byte_mode_for_potential_kanji_if_kanji_mode_is_disabled()
+    {
+        static_assert(determine_mode('\x81', true) == mode::kanji);
+        static_assert(determine_mode('\x81', false) == mode::byte);
+        static_assert(determine_mode('\x41', false) == mode::alphanumeric);
+    }
 }
 #endif
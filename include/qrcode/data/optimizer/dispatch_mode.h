@@ -35,11 +35,11 @@ namespace qrcode::data::optimizer
     }
 
     template<class Publish>
-    [[nodiscard]] constexpr auto on_numeric(Publish publish) noexcept
+    [[nodiscard]] constexpr auto on_numeric(Publish publish, bool kanji_enabled = true) noexcept
     {
         return [=](auto state, auto character)
         {
-            auto const current_mode = determine_mode(character);
+            auto const current_mode = determine_mode(character, kanji_enabled);
 
             if (current_mode == mode::numeric)
                 return state.advance();
@@ -55,11 +55,11 @@ namespace qrcode::data::optimizer
     }
 
     template<class Publish>
-    [[nodiscard]] constexpr auto on_alphanumeric(Publish publish) noexcept
+    [[nodiscard]] constexpr auto on_alphanumeric(Publish publish, bool kanji_enabled = true) noexcept
     {
         return [=](auto state, auto character)
         {
-            auto const current_mode = determine_mode(character);
+            auto const current_mode = determine_mode(character, kanji_enabled);
 
             if (current_mode == mode::alphanumeric || current_mode == mode::numeric)
                 return state.advance();
@@ -72,11 +72,11 @@ namespace qrcode::data::optimizer
     }
 
     template<class Publish>
-    [[nodiscard]] constexpr auto on_byte(Publish publish) noexcept
+    [[nodiscard]] constexpr auto on_byte(Publish publish, bool kanji_enabled = true) noexcept
     {
         return [=](auto state, auto character)
         {
-            auto const current_mode = determine_mode(character);
+            auto const current_mode = determine_mode(character, kanji_enabled);
             if (state.character_count() < consecutive_run() || current_mode == mode::byte)
                 return state.advance();
 
@@ -85,7 +85,7 @@ namespace qrcode::data::optimizer
     }
 
     template<class Publish>
-    [[nodiscard]] constexpr auto on_kanji(Publish publish) noexcept
+    [[nodiscard]] constexpr auto on_kanji(Publish publish, bool kanji_enabled = true) noexcept
     {
         return [=](auto state, auto character)
         {
@@ -105,27 +105,28 @@ namespace qrcode::data::optimizer
             if (state.character_count() < consecutive_run())
                 return state.advance(mode::byte);
 
-            return state.finalize(publish, determine_mode(character));
+            return state.finalize(publish, determine_mode(character, kanji_enabled));
         };
     }
 
-    [[nodiscard]] constexpr auto on_undefined() noexcept
+    [[nodiscard]] constexpr auto on_undefined(bool kanji_enabled = true) noexcept
     {
-        return [](auto state, auto character)
+        return [kanji_enabled](auto state, auto character)
         {
-            return state.advance(determine_mode(character));
+            return state.advance(determine_mode(character, kanji_enabled));
         };
     }
 
+    // without kanji mode, potential kanji are bytes, e.g. for messages in other character sets
     template<class Publish>
-    [[nodiscard]] constexpr auto dispatch_mode(Publish publish)
+    [[nodiscard]] constexpr auto dispatch_mode(Publish publish, bool kanji_enabled = true)
     {
         return [
-            undefined = on_undefined(),
-            alphanumeric = on_alphanumeric(publish),
-            numeric = on_numeric(publish),
-            byte = on_byte(publish),
-            kanji = on_kanji(publish)
+            undefined = on_undefined(kanji_enabled),
+            alphanumeric = on_alphanumeric(publish, kanji_enabled),
+            numeric = on_numeric(publish, kanji_enabled),
+            byte = on_byte(publish, kanji_enabled),
+            kanji = on_kanji(publish, kanji_enabled)
         ](auto state, auto character)
         {
             switch(state.encoder_type())
@@ -85,7 +85,7 @@ namespace qrcode::data::optimizer
     template<class Message, class Publish>
     requires std::convertible_to<std::ranges::range_value_t<Message>, char>
     [[nodiscard]] constexpr auto optimize(
-        Message&& message, nonull_encoders const& encoders, Publish publish) noexcept
+        Message&& message, nonull_encoders const& encoders, Publish publish, bool kanji_enabled = true) noexcept
     {
         using iterator = std::ranges::iterator_t<Message>;
         using sentinel = std::ranges::sentinel_t<Message>;
@@ -101,7 +101,7 @@ namespace qrcode::data::optimizer
         };
 
         auto merged_publish = publish_merged(&last_published, publish_with_encoder);
-        auto dispatch = dispatch_mode(merged_publish);
+        auto dispatch = dispatch_mode(merged_publish, kanji_enabled);
         auto state = optimizer_state<iterator>{mode::undefined, begin(message)};
 
         for (auto const& i : message)
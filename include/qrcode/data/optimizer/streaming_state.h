@@ -0,0 +1,171 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <optional>
+
+#include <qrcode/data/optimizer/dispatch_mode.h>
+#include <qrcode/data/optimizer/mode.h>
+
+namespace qrcode::data::optimizer
+{
+    // counterpart of optimizer_state for single pass ranges: instead of iterators into the message
+    // the characters are handed to a sink, which only has to hold them while their mode may change
+    template<class Sink>
+    class streaming_state
+    {
+    public:
+        constexpr streaming_state(mode encoder_type, Sink* character_sink) noexcept
+        : type{encoder_type}, sink{character_sink}, count{0}, last{}
+        {
+        }
+
+        [[nodiscard]] constexpr auto advance(
+            std::optional<mode> const& encoder_type = std::nullopt) const noexcept
+        {
+            auto copy = *this;
+            copy.type = encoder_type.value_or(type);
+            copy.last = std::optional{sink->current()};
+            ++copy.count;
+
+            sink->hold(*copy.last);
+            if (copy.is_settled())
+                sink->release(copy.type);
+            return copy;
+        }
+
+        [[nodiscard]] constexpr auto last_character() const noexcept
+        {
+            return last;
+        }
+
+        [[nodiscard]] constexpr auto encoder_type() const noexcept
+        {
+            return type;
+        }
+
+        [[nodiscard]] constexpr auto character_count() const noexcept
+        {
+            return count;
+        }
+
+        template<class Publish>
+        [[nodiscard]] constexpr auto finalize(Publish publish, mode new_type) const
+        {
+            publish(type);
+            return streaming_state{new_type, sink}.advance();
+        }
+
+        template<class Publish>
+        [[nodiscard]] constexpr auto finalize(Publish publish) const
+        {
+            publish(type);
+        }
+
+    private:
+        // see dispatch_mode: only runs of numerics or alphanumerics shorter than a consecutive run 
+        // and kanjis may still turn into another mode
+        [[nodiscard]] constexpr auto is_settled() const noexcept
+        {
+            return type == mode::byte 
+                || ((type == mode::numeric || type == mode::alphanumeric) && count >= consecutive_run());
+        }
+
+        mode type;
+        Sink* sink;
+        int count;
+        std::optional<char> last;
+    };
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+namespace qrcode::data::optimizer::test
+{
+    struct sink_stub
+    {
+        char character = 0;
+        int held = 0;
+        int released = 0;
+        mode released_type = mode::undefined;
+
+        constexpr auto current() const noexcept { return character; }
+        constexpr auto hold(char) noexcept { ++held; }
+        constexpr auto release(mode type) noexcept { released += held; held = 0; released_type = type; }
+    };
+
+    constexpr auto streaming_states_hold_characters_while_their_mode_may_change()
+    {
+        auto f = []
+        {
+            auto sink = sink_stub{.character = '1'};
+            auto state = streaming_state{mode::numeric, &sink};
+            for (auto i = 0; i != 9; ++i)
+                state = state.advance();
+            return sink.held == 9 && sink.released == 0 && state.character_count() == 9;
+        };
+        static_assert(f());
+    }
+
+    constexpr auto streaming_states_release_characters_of_a_consecutive_run()
+    {
+        auto f = []
+        {
+            auto sink = sink_stub{.character = '1'};
+            auto state = streaming_state{mode::numeric, &sink};
+            for (auto i = 0; i != 11; ++i)
+                state = state.advance();
+            return sink.held == 0 && sink.released == 11 
+                && sink.released_type == mode::numeric && state.character_count() == 11;
+        };
+        static_assert(f());
+    }
+
+    constexpr auto streaming_states_release_bytes_immediately()
+    {
+        auto f = []
+        {
+            auto sink = sink_stub{.character = 'a'};
+            auto const state = streaming_state{mode::byte, &sink}.advance();
+            return sink.held == 0 && sink.released == 1 && state.last_character() == 'a';
+        };
+        static_assert(f());
+    }
+
+    constexpr auto streaming_states_publish_their_type_when_finalized()
+    {
+        auto f = []
+        {
+            auto sink = sink_stub{.character = 'A'};
+            auto published = mode::undefined;
+            auto const state = streaming_state{mode::kanji, &sink}
+                .advance()
+                .finalize([&](auto type) { published = type; }, mode::alphanumeric);
+            return published == mode::kanji 
+                && state.encoder_type() == mode::alphanumeric 
+                && state.character_count() == 1;
+        };
+        static_assert(f());
+    }
+}
+#endif
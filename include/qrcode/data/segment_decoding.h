@@ -0,0 +1,185 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <optional>
+
+#include <cx/vector.h>
+
+#include <qrcode/data/bit_reader.h>
+#include <qrcode/data/encoders.h>
+#include <qrcode/data/optimizer/mode.h>
+#include <qrcode/data/structured_append.h>
+#include <qrcode/eci/assignment_number.h>
+
+namespace qrcode::data
+{
+    struct decoded_segment
+    {
+        optimizer::mode mode = optimizer::mode::undefined;
+        int size = 0;
+    };
+
+    // indicators take at least 17 bits per segment in large versions, smaller versions hold far fewer bits
+    inline constexpr auto max_segment_count = 23648 / 17 + 1;
+
+    // numerics are the densest segments, ten bits for three digits
+    inline constexpr auto max_message_size = 23648 / 10 * 3 + 2;
+
+    struct decoded_data
+    {
+        std::optional<qrcode::eci::assignment_number> eci_assignment_number{};
+        std::optional<structured_append> structured_append_header{};
+        cx::vector<decoded_segment, max_segment_count> segments{};
+        cx::vector<char, max_message_size> message{};
+    };
+}
+
+namespace qrcode::data::detail
+{
+    template<class Encoder>
+    [[nodiscard]] constexpr auto is_mode(std::optional<Encoder> const& encoder, int indicator) noexcept
+    {
+        return encoder && mode(*encoder).value == indicator;
+    }
+
+    template<class Encoder>
+    [[nodiscard]] constexpr auto is_mode(Encoder const& encoder, int indicator) noexcept
+    {
+        return mode(encoder).value == indicator;
+    }
+
+    template<class Encoder>
+    [[nodiscard]] constexpr auto& encoder(std::optional<Encoder> const& encoder) noexcept
+    {
+        return *encoder;
+    }
+
+    template<class Encoder>
+    [[nodiscard]] constexpr auto& encoder(Encoder const& encoder) noexcept
+    {
+        return encoder;
+    }
+}
+
+namespace qrcode::data
+{
+    // reads the segment of the already consumed mode indicator and records its part of the message
+    template<bool Nullable>
+    [[nodiscard]] constexpr auto decode_segment(
+        bit_reader& reader, encoders<Nullable> const& encoders, int indicator, decoded_data& data) noexcept
+    {
+        using qrcode::data::detail::is_mode;
+        using qrcode::data::detail::encoder;
+        using qrcode::data::optimizer::mode;
+
+        auto const message_size = static_cast<int>(data.message.size());
+        auto segment_mode = mode::undefined;
+        auto valid = false;
+
+        if (is_mode(encoders.numeric, indicator))
+        {
+            segment_mode = mode::numeric;
+            valid = encoder(encoders.numeric).read_segment(reader, data.message);
+        }
+        else if (is_mode(encoders.alphanumeric, indicator))
+        {
+            segment_mode = mode::alphanumeric;
+            valid = encoder(encoders.alphanumeric).read_segment(reader, data.message);
+        }
+        else if (is_mode(encoders.byte, indicator))
+        {
+            segment_mode = mode::byte;
+            valid = encoder(encoders.byte).read_segment(reader, data.message);
+        }
+        else if (is_mode(encoders.kanji, indicator))
+        {
+            segment_mode = mode::kanji;
+            valid = encoder(encoders.kanji).read_segment(reader, data.message);
+        }
+
+        if (valid)
+            data.segments.push_back({segment_mode, static_cast<int>(data.message.size()) - message_size});
+        return valid;
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <array>
+#include <string_view>
+#include <qrcode/data/bit_stream.h>
+
+namespace qrcode::data::test
+{
+    constexpr auto decode_segment_appends_the_segment_of_the_matching_encoder()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            auto const any_encoders = nonull_encoders{
+                numeric_encoder{mode_indicator{.value=0b0001,.bit_count=4}, count_indicator{.bit_count=10}},
+                alphanumeric_encoder{mode_indicator{.value=0b0010,.bit_count=4}, count_indicator{.bit_count=9}},
+                byte_encoder{mode_indicator{.value=0b0100,.bit_count=4}, count_indicator{.bit_count=8}},
+                kanji_encoder{mode_indicator{.value=0b1000,.bit_count=4}, count_indicator{.bit_count=8}}
+            };
+
+            auto stream = bit_stream{};
+            auto const any_message = "AB"sv;
+            any_encoders.alphanumeric.write_segment(stream, any_message);
+            any_encoders.byte.write_segment(stream, "x"sv);
+            auto const bits = stream.get();
+
+            auto reader = bit_reader{bits};
+            auto data = decoded_data{};
+            [[maybe_unused]] auto const alphanumeric_mode = reader.read(number_bits{4});
+            auto const first = decode_segment(reader, any_encoders, 0b0010, data);
+            [[maybe_unused]] auto const byte_mode = reader.read(number_bits{4});
+            auto const second = decode_segment(reader, any_encoders, 0b0100, data);
+
+            return first && second
+                && std::ranges::equal(data.message, "ABx"sv)
+                && data.segments.size() == 2
+                && data.segments[0].mode == optimizer::mode::alphanumeric && data.segments[0].size == 2
+                && data.segments[1].mode == optimizer::mode::byte && data.segments[1].size == 1;
+        };
+        static_assert(f());
+    }
+
+    constexpr auto decode_segment_rejects_modes_without_encoder()
+    {
+        auto f = []
+        {
+            auto const any_encoders = nullable_encoders{
+                numeric_encoder{mode_indicator{.value=0b0,.bit_count=1}, count_indicator{.bit_count=4}},
+                std::nullopt, std::nullopt, std::nullopt
+            };
+            auto const bits = bit_stream{}.add(0, number_bits{8}).get();
+            auto reader = bit_reader{bits};
+            auto data = decoded_data{};
+            return !decode_segment(reader, any_encoders, 0b1, data) && data.segments.size() == 0;
+        };
+        static_assert(f());
+    }
+}
+#endif
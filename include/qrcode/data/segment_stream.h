@@ -0,0 +1,379 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <ranges>
+#include <span>
+
+#include <cx/vector.h>
+
+#include <qrcode/data/alphanumeric_encoding.h>
+#include <qrcode/data/bit_stream.h>
+#include <qrcode/data/encoders.h>
+#include <qrcode/data/kanji_encoding.h>
+#include <qrcode/data/numeric_encoding.h>
+#include <qrcode/data/segment_decoding.h>
+#include <qrcode/data/optimizer/dispatch_mode.h>
+#include <qrcode/data/optimizer/mode.h>
+#include <qrcode/data/optimizer/streaming_state.h>
+
+namespace qrcode::data
+{
+    // the data bits of a segment without its mode and character count indicator
+    struct streamed_segment
+    {
+        optimizer::mode mode = optimizer::mode::undefined;
+        int character_count = 0;
+        int bit_count = 0;
+    };
+
+    // data bits of the largest qr symbol
+    inline constexpr auto max_streamed_bits = 23648;
+
+    // kanji runs are held the longest, two characters take 13 bits
+    inline constexpr auto max_held_characters = 2 * (max_streamed_bits / 13) + 2;
+}
+
+namespace qrcode::data::detail
+{
+    [[nodiscard]] constexpr auto group_size(optimizer::mode type) noexcept
+    {
+        using optimizer::mode;
+        switch (type)
+        {
+            case mode::numeric: return 3;
+            case mode::alphanumeric: return 2;
+            case mode::kanji: return 2;
+            default: return 1;
+        }
+    }
+
+    constexpr auto encode_group(bit_stream& stream, optimizer::mode type, std::span<char const> group) noexcept
+    {
+        using optimizer::mode;
+        switch (type)
+        {
+            case mode::numeric: 
+                encode_numerics(stream, group | std::views::transform([](auto c) { return *make_numeric(c); }));
+                break;
+            case mode::alphanumeric: 
+                encode_alphanumerics(stream, group | std::views::transform([](auto c) { return *make_alphanumeric(c); }));
+                break;
+            case mode::kanji: 
+                encode_kanjis(stream, group);
+                break;
+            default:
+                for (auto i : group)
+                    stream.add(static_cast<std::uint8_t>(i), 8_bits);
+                break;
+        }
+    }
+
+    template<class Function>
+    constexpr auto visit_encoder(nonull_encoders const& encoders, optimizer::mode type, Function function) noexcept
+    {
+        using optimizer::mode;
+        switch (type)
+        {
+            case mode::numeric: return function(encoders.numeric);
+            case mode::alphanumeric: return function(encoders.alphanumeric);
+            case mode::kanji: return function(encoders.kanji);
+            default: return function(encoders.byte);
+        }
+    }
+}
+
+namespace qrcode::data
+{
+    // sink of streaming_state: settled characters are encoded right away, only the indicators 
+    // are left open, as their sizes depend on the version which is chosen afterwards
+    class segment_stream
+    {
+    public:
+        [[nodiscard]] constexpr auto current() const noexcept
+        {
+            return incoming;
+        }
+
+        constexpr auto receive(char character) noexcept
+        {
+            incoming = character;
+        }
+
+        constexpr auto hold(char character) noexcept
+        {
+            if (held.size() == held.max_size())
+                overflow = true;
+            else
+                held.push_back(character);
+        }
+
+        constexpr auto release(optimizer::mode type) noexcept
+        {
+            // a lead byte at the end of the message cannot be encoded as kanji
+            if (type == optimizer::mode::kanji && held.size() % 2 != 0)
+                type = optimizer::mode::byte;
+
+            for (auto i : held)
+                put(type, i);
+            held.erase(held.begin(), held.end());
+        }
+
+        constexpr auto close() noexcept
+        {
+            using qrcode::data::detail::encode_group;
+
+            if (open.mode == optimizer::mode::undefined)
+                return;
+
+            encode_group(data, open.mode, std::span{group.data(), static_cast<std::size_t>(group_fill)});
+            group_fill = 0;
+
+            open.bit_count = static_cast<int>(data.size()) - open.bit_count;
+            if (open.mode == optimizer::mode::kanji)
+                open.character_count /= 2;
+
+            if (list.size() == list.max_size())
+                overflow = true;
+            else
+                list.push_back(open);
+            open = streamed_segment{};
+        }
+
+        [[nodiscard]] friend constexpr auto overflowed(segment_stream const& stream) noexcept
+        {
+            return stream.overflow;
+        }
+
+        [[nodiscard]] friend constexpr auto& segments(segment_stream const& stream) noexcept
+        {
+            return stream.list;
+        }
+
+        [[nodiscard]] friend constexpr auto& data_bits(segment_stream const& stream) noexcept
+        {
+            return stream.data;
+        }
+
+    private:
+        // open segments are merged with all following characters of the same mode
+        constexpr auto put(optimizer::mode type, char character) noexcept -> void
+        {
+            using qrcode::data::detail::encode_group;
+            using qrcode::data::detail::group_size;
+
+            if (open.mode != type)
+            {
+                close();
+                // the bit count holds the offset of the segment until it gets closed
+                open = streamed_segment{.mode = type, .character_count = 0, .bit_count = static_cast<int>(data.size())};
+            }
+
+            group[group_fill++] = character;
+            ++open.character_count;
+            if (group_fill == group_size(type))
+            {
+                encode_group(data, type, std::span{group.data(), static_cast<std::size_t>(group_fill)});
+                group_fill = 0;
+            }
+
+            if (data.size() > max_streamed_bits)
+                overflow = true;
+        }
+
+        char incoming = 0;
+        bool overflow = false;
+        cx::vector<char, max_held_characters> held{};
+        std::array<char, 3> group{};
+        int group_fill = 0;
+        streamed_segment open{};
+        cx::vector<streamed_segment, max_segment_count> list{};
+        bit_stream data{};
+    };
+
+    // a single pass over the message, which is segmented like optimizer::optimize does
+    template<std::ranges::input_range Message>
+    requires std::convertible_to<std::ranges::range_value_t<Message>, char>
+    [[nodiscard]] constexpr auto stream_segments(Message&& message) noexcept
+    {
+        using optimizer::dispatch_mode;
+        using optimizer::mode;
+        using optimizer::streaming_state;
+
+        auto stream = segment_stream{};
+        auto const publish = [&stream](auto type) { stream.release(type); };
+        auto const dispatch = dispatch_mode(publish);
+
+        auto state = streaming_state{mode::undefined, &stream};
+        for (auto i = std::ranges::begin(message); i != std::ranges::end(message) && !overflowed(stream); ++i)
+        {
+            stream.receive(static_cast<char>(*i));
+            state = dispatch(state, stream.current());
+        }
+
+        if (state.character_count() != 0)
+            state.finalize(publish);
+        stream.close();
+        return stream;
+    }
+
+    [[nodiscard]] constexpr auto bit_count(segment_stream const& stream, nonull_encoders const& encoders) noexcept
+    {
+        using qrcode::data::detail::visit_encoder;
+
+        auto length = 0;
+        for (auto const& i : segments(stream))
+            length += i.bit_count + visit_encoder(encoders, i.mode, [](auto const& encoder)
+            {
+                return mode(encoder).bit_count + count(encoder).bit_count;
+            });
+        return length;
+    }
+
+    constexpr auto write_segments(
+        bit_stream& stream, segment_stream const& segments_stream, nonull_encoders const& encoders) noexcept
+    {
+        using qrcode::data::detail::visit_encoder;
+
+        auto const& bits = data_bits(segments_stream).get();
+        auto offset = 0;
+        for (auto const& i : segments(segments_stream))
+        {
+            visit_encoder(encoders, i.mode, [&](auto const& encoder)
+            {
+                encode(stream, mode(encoder));
+                encode(stream, count(encoder), i.character_count);
+            });
+            for (auto j = offset; j != offset + i.bit_count; ++j)
+                stream.add(bits[j] ? 1 : 0, 1_bits);
+            offset += i.bit_count;
+        }
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
+#include <qrcode/data/optimizer/data_encoding.h>
+
+namespace qrcode::data::test
+{
+    template<class Range>
+    struct single_pass
+    {
+        Range range;
+
+        struct iterator
+        {
+            using value_type = std::ranges::range_value_t<Range>;
+            using difference_type = std::ptrdiff_t;
+
+            std::ranges::iterator_t<Range const> current;
+
+            constexpr auto operator*() const noexcept { return *current; }
+            constexpr auto operator++() noexcept -> iterator& { ++current; return *this; }
+            constexpr auto operator++(int) noexcept { ++current; }
+        };
+
+        constexpr auto begin() const noexcept { return iterator{std::ranges::begin(range)}; }
+        constexpr auto end() const noexcept { return std::ranges::end(range); }
+
+        friend constexpr auto operator==(iterator const& lhs, std::ranges::sentinel_t<Range const> const& rhs) noexcept
+        {
+            return lhs.current == rhs;
+        }
+    };
+
+    template<class Range>
+    single_pass(Range) -> single_pass<Range>;
+
+    constexpr auto single_pass_ranges_are_no_forward_ranges()
+    {
+        using namespace std::literals;
+        static_assert(std::ranges::input_range<single_pass<std::string_view>>);
+        static_assert(!std::ranges::forward_range<single_pass<std::string_view>>);
+    }
+
+    constexpr auto streamed_segments_are_written_like_optimized_segments()
+    {
+        auto f = [](auto message)
+        {
+            auto const encoders = nonull_encoders{
+                numeric_encoder{mode_indicator{.value=0b0001,.bit_count=4}, count_indicator{.bit_count=10}},
+                alphanumeric_encoder{mode_indicator{.value=0b0010,.bit_count=4}, count_indicator{.bit_count=9}},
+                byte_encoder{mode_indicator{.value=0b0100,.bit_count=4}, count_indicator{.bit_count=8}},
+                kanji_encoder{mode_indicator{.value=0b1000,.bit_count=4}, count_indicator{.bit_count=8}}
+            };
+            auto const streamed = stream_segments(single_pass{message});
+
+            auto expected = bit_stream{};
+            optimizer::encode_data(expected, message, encoders);
+            auto written = bit_stream{};
+            write_segments(written, streamed, encoders);
+
+            return !overflowed(streamed) 
+                && bit_count(streamed, encoders) == static_cast<int>(expected.size())
+                && written.get() == expected.get();
+        };
+
+        using namespace std::literals;
+        static_assert(f("0123456789"sv));
+        static_assert(f("ABRACADABRA"sv));
+        static_assert(f("Hello, world! 123456789012345"sv));
+        static_assert(f("0123ABC4567"sv));
+        static_assert(f("01234567890123ABCDEFGHIJKLMNOP56789abc"sv));
+        static_assert(f("\x93\x5F\xE4\xAA" "ABC" "\x93\x5F"sv));
+        static_assert(f("ab\x93\x5F\xE4\xAA\x93\x5F\xE4\xAA\x93\x5F\xE4\xAA\x93\x5F\xE4\xAA\x93\x5F\xE4\xAA" "1"sv));
+    }
+
+    constexpr auto streamed_segments_record_mode_and_character_count()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            using optimizer::mode;
+
+            auto const streamed = stream_segments(single_pass{"0123456789012345ABCDEFGHIJKLMNOPabc"sv});
+            auto const& s = segments(streamed);
+            return s.size() == 3
+                && s[0].mode == mode::numeric && s[0].character_count == 16 && s[0].bit_count == 54
+                && s[1].mode == mode::alphanumeric && s[1].character_count == 16 && s[1].bit_count == 88
+                && s[2].mode == mode::byte && s[2].character_count == 3 && s[2].bit_count == 24;
+        };
+        static_assert(f());
+    }
+
+    constexpr auto stream_segments_stops_reading_when_no_symbol_can_hold_the_data()
+    {
+        auto f = []
+        {
+            auto const message = std::views::iota(0, max_streamed_bits / 8 + 2)
+                | std::views::transform([](auto) { return 'a'; });
+            return overflowed(stream_segments(single_pass{message}));
+        };
+        static_assert(f());
+    }
+}
+#endif
@@ -0,0 +1,279 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+
+#include <cx/vector.h>
+
+#include <qrcode/data/shift_jis_table.h>
+
+namespace qrcode::data
+{
+    // the longest message any qr symbol holds (7089 digits)
+    inline constexpr auto max_shift_jis_length = 7089;
+    using shift_jis_message = cx::vector<char, max_shift_jis_length>;
+}
+
+namespace qrcode::data::detail
+{
+    // invalid, overlong and surrogate sequences yield nothing, the iterator is moved past the sequence
+    template<class Iterator, class Sentinel>
+    [[nodiscard]] constexpr auto decode_utf8(Iterator& current, Sentinel last) noexcept 
+        -> std::optional<char32_t>
+    {
+        auto const lead = static_cast<std::uint8_t>(*(current++));
+        if (lead < 0x80u)
+            return char32_t{lead};
+
+        auto length = 0;
+        auto code_point = char32_t{0};
+        auto minimum = char32_t{0};
+        if ((lead & 0xE0u) == 0xC0u)
+            length = 2, code_point = lead & 0x1Fu, minimum = 0x80;
+        else if ((lead & 0xF0u) == 0xE0u)
+            length = 3, code_point = lead & 0x0Fu, minimum = 0x800;
+        else if ((lead & 0xF8u) == 0xF0u)
+            length = 4, code_point = lead & 0x07u, minimum = 0x10000;
+        else
+            return std::nullopt;
+
+        for (auto i = 1; i != length; ++i, ++current)
+        {
+            if (current == last)
+                return std::nullopt;
+
+            auto const continuation = static_cast<std::uint8_t>(*current);
+            if ((continuation & 0xC0u) != 0x80u)
+                return std::nullopt;
+            code_point = code_point << 6 | (continuation & 0x3Fu);
+        }
+
+        auto const surrogate = code_point >= 0xD800 && code_point <= 0xDFFF;
+        if (code_point < minimum || code_point > 0x10FFFF || surrogate)
+            return std::nullopt;
+        return code_point;
+    }
+
+    [[nodiscard]] constexpr auto is_ascii_word(std::uint64_t word) noexcept
+    {
+        return (word & 0x8080'8080'8080'8080u) == 0;
+    }
+}
+
+namespace qrcode::data
+{
+    // ascii and halfwidth katakana take one byte, all characters of JIS X 0208 two bytes
+    [[nodiscard]] constexpr auto to_shift_jis(char32_t code_point) noexcept
+    {
+        using qrcode::data::detail::jis_x0208_code_points;
+        using qrcode::data::detail::jis_x0208_shift_jis;
+
+        if (code_point < 0x80)
+            return std::optional<std::uint16_t>{static_cast<std::uint16_t>(code_point)};
+
+        if (code_point >= 0xFF61 && code_point <= 0xFF9F)
+            return std::optional<std::uint16_t>{static_cast<std::uint16_t>(code_point - 0xFF61 + 0xA1)};
+
+        if (code_point > 0xFFFF)
+            return std::optional<std::uint16_t>{};
+
+        auto const found = std::ranges::lower_bound(jis_x0208_code_points, code_point);
+        if (found == end(jis_x0208_code_points) || *found != code_point)
+            return std::optional<std::uint16_t>{};
+        return std::optional<std::uint16_t>{jis_x0208_shift_jis[found - begin(jis_x0208_code_points)]};
+    }
+
+    // utf-8 messages become shift jis, so that the optimizer can put their kanji into kanji mode; 
+    // nothing is returned if a character has no shift jis representation
+    template<std::ranges::forward_range Message>
+    requires std::convertible_to<std::ranges::range_value_t<Message>, char>
+    [[nodiscard]] constexpr auto transcode_to_shift_jis(Message&& message) noexcept
+    {
+        using qrcode::data::detail::decode_utf8;
+        using qrcode::data::detail::is_ascii_word;
+        using iterator = std::ranges::iterator_t<Message>;
+        using sentinel = std::ranges::sentinel_t<Message>;
+        using result_type = std::optional<shift_jis_message>;
+
+        auto transcoded = shift_jis_message{};
+        auto current = std::ranges::begin(message);
+        auto const last = std::ranges::end(message);
+
+        while (current != last)
+        {
+            // ascii fast path, eight characters are checked at once
+            if constexpr (std::contiguous_iterator<iterator> && std::sized_sentinel_for<sentinel, iterator> 
+                && sizeof(std::iter_value_t<iterator>) == 1)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    constexpr auto word_size = 8;
+                    while (last - current >= word_size && transcoded.size() + word_size <= max_shift_jis_length)
+                    {
+                        auto word = std::uint64_t{0};
+                        std::memcpy(&word, std::to_address(current), word_size);
+                        if (!is_ascii_word(word))
+                            break;
+
+                        for (auto i = 0; i != word_size; ++i)
+                            transcoded.push_back(static_cast<char>(*(current++)));
+                    }
+                    if (current == last)
+                        break;
+                }
+            }
+
+            auto const code_point = decode_utf8(current, last);
+            if (!code_point)
+                return result_type{};
+
+            auto const code = to_shift_jis(*code_point);
+            if (!code)
+                return result_type{};
+
+            auto const length = *code > 0xFFu ? 2 : 1;
+            if (static_cast<int>(transcoded.size()) + length > max_shift_jis_length)
+                return result_type{};
+
+            if (length == 2)
+                transcoded.push_back(static_cast<char>(*code >> 8));
+            transcoded.push_back(static_cast<char>(*code & 0xFFu));
+        }
+        return result_type{transcoded};
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
+#include <qrcode/data/kanji.h>
+
+namespace qrcode::data::detail::test
+{
+    constexpr auto decode_utf8_returns_the_code_point_of_the_next_character()
+    {
+        auto f = [](std::string_view encoded)
+        {
+            auto current = begin(encoded);
+            auto const code_point = decode_utf8(current, end(encoded));
+            return current == end(encoded) ? code_point : std::nullopt;
+        };
+
+        using namespace std::literals;
+        static_assert(f("A"sv) == U'A');
+        static_assert(f("\xC3\xA9"sv) == U'é');
+        static_assert(f("\xE6\x97\xA5"sv) == U'日');
+        static_assert(f("\xF0\x9F\x98\x80"sv) == U'\U0001F600');
+    }
+
+    constexpr auto decode_utf8_returns_nothing_for_invalid_sequences()
+    {
+        auto f = [](std::string_view encoded)
+        {
+            auto current = begin(encoded);
+            return decode_utf8(current, end(encoded));
+        };
+
+        using namespace std::literals;
+        static_assert(f("\x80"sv) == std::nullopt);
+        static_assert(f("\xC0\x80"sv) == std::nullopt);
+        static_assert(f("\xE6\x97"sv) == std::nullopt);
+        static_assert(f("\xE6\x41\xA5"sv) == std::nullopt);
+        static_assert(f("\xED\xA0\x80"sv) == std::nullopt);
+        static_assert(f("\xF4\x90\x80\x80"sv) == std::nullopt);
+    }
+
+    constexpr auto is_ascii_word_returns_false_if_any_byte_has_its_high_bit_set()
+    {
+        static_assert(is_ascii_word(0x7F7F'7F7F'7F7F'7F7Fu));
+        static_assert(!is_ascii_word(0x7F7F'7F7F'7F80'7F7Fu));
+    }
+
+    constexpr auto jis_x0208_tables_are_sorted_and_hold_kanji_mode_characters_only()
+    {
+        auto f = []
+        {
+            for (auto i = std::size_t{1}; i != jis_x0208_code_points.size(); ++i)
+                if (jis_x0208_code_points[i-1] >= jis_x0208_code_points[i])
+                    return false;
+            for (auto i : jis_x0208_shift_jis)
+                if (!is_kanji(static_cast<unsigned>(i >> 8), i & 0xFFu))
+                    return false;
+            return true;
+        };
+        static_assert(f());
+    }
+}
+
+namespace qrcode::data::test
+{
+    constexpr auto to_shift_jis_returns_the_shift_jis_code_of_given_code_point()
+    {
+        static_assert(to_shift_jis(U'A') == 0x41u);
+        static_assert(to_shift_jis(U'日') == 0x93FAu);
+        static_assert(to_shift_jis(U'本') == 0x967Bu);
+        static_assert(to_shift_jis(U'Ａ') == 0x8260u);
+        static_assert(to_shift_jis(U'〜') == 0x8160u);
+        static_assert(to_shift_jis(U'～') == 0x8160u);
+        static_assert(to_shift_jis(U'ｱ') == 0xB1u);
+    }
+
+    constexpr auto to_shift_jis_returns_nothing_for_characters_outside_of_shift_jis()
+    {
+        static_assert(to_shift_jis(U'é') == std::nullopt);
+        static_assert(to_shift_jis(U'€') == std::nullopt);
+        static_assert(to_shift_jis(U'\U0001F600') == std::nullopt);
+    }
+
+    constexpr auto transcode_to_shift_jis_converts_utf8_messages()
+    {
+        auto f = [](std::string_view utf8, std::string_view nominal)
+        {
+            auto const transcoded = transcode_to_shift_jis(utf8);
+            return transcoded && std::ranges::equal(*transcoded, nominal);
+        };
+
+        using namespace std::literals;
+        static_assert(f("ABC 123"sv, "ABC 123"sv));
+        static_assert(f("\xE6\x97\xA5\xE6\x9C\xAC"sv, "\x93\xFA\x96\x7B"sv));
+        static_assert(f("QR\xE3\x82\xB3\xE3\x83\xBC\xE3\x83\x89 v1"sv, "QR\x83\x52\x81\x5B\x83\x68 v1"sv));
+        static_assert(f("\xEF\xBD\xB1"sv, "\xB1"sv));
+    }
+
+    constexpr auto transcode_to_shift_jis_returns_nothing_for_characters_outside_of_shift_jis()
+    {
+        using namespace std::literals;
+        static_assert(!transcode_to_shift_jis("caf\xC3\xA9"sv));
+        static_assert(!transcode_to_shift_jis("\xE6\x97\xA5\xF0\x9F\x98\x80"sv));
+        static_assert(!transcode_to_shift_jis("\xFF"sv));
+    }
+}
+#endif
@@ -0,0 +1,156 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ranges>
+
+#include <qrcode/data/bit_reader.h>
+#include <qrcode/data/bit_stream.h>
+
+namespace qrcode::data
+{
+    inline constexpr auto max_structured_append_symbols = 16;
+
+    // symbol sequence indicator and parity of the whole message
+    struct structured_append
+    {
+        int position = 0;
+        int symbol_count = 1;
+        std::uint8_t parity = 0;
+
+        [[nodiscard]] constexpr auto operator==(structured_append const&) const noexcept -> bool = default;
+        [[nodiscard]] constexpr auto operator!=(structured_append const&) const noexcept -> bool = default;
+    };
+
+    // xor of all message bytes, every part of the message carries the parity of the whole one
+    template<std::ranges::input_range Message>
+    [[nodiscard]] constexpr auto structured_append_parity(Message&& message) noexcept
+    {
+        auto parity = std::uint8_t{0};
+        for (auto i : message)
+        {
+            if constexpr (std::same_as<std::ranges::range_value_t<Message>, std::byte>)
+                parity ^= std::to_integer<std::uint8_t>(i);
+            else
+                parity ^= static_cast<std::uint8_t>(i);
+        }
+        return parity;
+    }
+
+    [[nodiscard]] constexpr auto encode(bit_stream& stream, structured_append const& header) noexcept
+    {
+        using namespace qrcode::data::literals;
+        stream.add(0b0011, 4_bits);
+        stream.add(header.position, 4_bits);
+        stream.add(header.symbol_count - 1, 4_bits);
+        stream.add(header.parity, 8_bits);
+    }
+
+    [[nodiscard]] constexpr auto bit_count(structured_append const&) noexcept
+    {
+        return 4 + 4 + 4 + 8;
+    }
+
+    // the mode indicator has already been read
+    [[nodiscard]] constexpr auto decode_structured_append(bit_reader& reader) noexcept
+    {
+        using namespace qrcode::data::literals;
+        using result_type = std::optional<structured_append>;
+
+        auto const position = reader.read(4_bits);
+        auto const last = reader.read(4_bits);
+        auto const parity = reader.read(8_bits);
+        if (!position || !last || !parity || *position > *last)
+            return result_type{};
+
+        return result_type{structured_append{
+            .position = *position, 
+            .symbol_count = *last + 1, 
+            .parity = static_cast<std::uint8_t>(*parity)
+        }};
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <array>
+#include <string_view>
+
+namespace qrcode::data::test
+{
+    constexpr auto structured_append_parity_is_the_xor_of_all_message_bytes()
+    {
+        using namespace std::literals;
+
+        static_assert(structured_append_parity(""sv) == 0);
+        static_assert(structured_append_parity("A"sv) == 0x41);
+        static_assert(structured_append_parity("AB"sv) == (0x41 ^ 0x42));
+        static_assert(structured_append_parity("\xFF\x0F"sv) == 0xF0);
+        static_assert(structured_append_parity(std::array{std::byte{0x41}, std::byte{0x42}}) == (0x41 ^ 0x42));
+    }
+
+    constexpr auto structured_append_headers_can_be_encoded_to_given_bit_stream()
+    {
+        auto f = []
+        {
+            auto stream = bit_stream{};
+            encode(stream, structured_append{.position = 2, .symbol_count = 4, .parity = 0x81});
+            return std::ranges::equal(stream.get(), std::array<bool,20>{
+                0,0,1,1,  0,0,1,0,  0,0,1,1,  1,0,0,0,0,0,0,1});
+        };
+        static_assert(f());
+        static_assert(bit_count(structured_append{}) == 20);
+    }
+
+    constexpr auto structured_append_headers_can_be_decoded_after_their_mode_indicator()
+    {
+        auto f = [](auto header)
+        {
+            using namespace qrcode::data::literals;
+            auto stream = bit_stream{};
+            encode(stream, header);
+            auto const bits = stream.get();
+            auto reader = bit_reader{bits};
+            auto const mode = reader.read(4_bits);
+            return mode == 0b0011 && decode_structured_append(reader) == header;
+        };
+        static_assert(f(structured_append{.position = 0, .symbol_count = 1, .parity = 0}));
+        static_assert(f(structured_append{.position = 15, .symbol_count = 16, .parity = 0xFF}));
+    }
+
+    constexpr auto decode_structured_append_rejects_positions_behind_the_last_symbol()
+    {
+        auto f = []
+        {
+            auto const bits = bit_stream{}.add(0b0101, 4_bits).add(0b0011, 4_bits).add(0, 8_bits).get();
+            auto reader = bit_reader{bits};
+            return !decode_structured_append(reader);
+        };
+        static_assert(f());
+    }
+}
+#endif
@@ -24,6 +24,8 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
+#include <qrcode/data/bit_reader.h>
 #include <qrcode/data/bit_stream.h>
 
 namespace qrcode::eci
@@ -33,7 +35,11 @@ namespace qrcode::eci
         std::int32_t value;
     };
 
+    inline constexpr auto shift_jis_assignment_number = assignment_number{20};
+    inline constexpr auto utf8_assignment_number = assignment_number{26};
+
     using qrcode::data::bit_stream;
+    using qrcode::data::bit_reader;
 
     [[nodiscard]] constexpr auto encode(
         bit_stream& stream, assignment_number assignment_number) noexcept
@@ -59,6 +65,36 @@ namespace qrcode::eci
         }
     }
 
+    [[nodiscard]] constexpr auto decode_assignment_number(bit_reader& reader) noexcept
+    {
+        using namespace qrcode::data::literals;
+        using result_type = std::optional<assignment_number>;
+
+        auto const first = reader.read(8_bits);
+        if (!first)
+            return result_type{};
+
+        if ((*first & 0b1000'0000) == 0)
+            return result_type{{*first}};
+
+        if ((*first & 0b1100'0000) == 0b1000'0000)
+        {
+            auto const second = reader.read(8_bits);
+            return second 
+                ? result_type{{(*first & 0b0011'1111) << 8 | *second}} 
+                : result_type{};
+        }
+
+        if ((*first & 0b1110'0000) == 0b1100'0000)
+        {
+            auto const rest = reader.read(16_bits);
+            return rest 
+                ? result_type{{(*first & 0b0001'1111) << 16 | *rest}} 
+                : result_type{};
+        }
+        return result_type{};
+    }
+
     [[nodiscard]] constexpr auto bit_count(assignment_number const& assignment_number) noexcept
     {
         auto const value = assignment_number.value;
@@ -116,6 +152,24 @@ namespace qrcode::eci::test
         ));
     }
 
+    constexpr auto assignment_numbers_can_be_decoded_from_given_bit_reader()
+    {
+        auto f = [](auto number)
+        {
+            using qrcode::data::bit_reader;
+            auto const bits = encode_wrapper(assignment_number{number}).get();
+            auto reader = bit_reader{bits};
+            auto const decoded = decode_assignment_number(reader);
+            return decoded && decoded->value == number && reader.remaining() == 0;
+        };
+        static_assert(f(0));
+        static_assert(f(127));
+        static_assert(f(128));
+        static_assert(f(16383));
+        static_assert(f(16384));
+        static_assert(f(999999));
+    }
+
     constexpr auto assignment_numbers_provide_their_bit_count()
     {
         static_assert(bit_count(assignment_number{0}) == 8);
@@ -88,9 +88,23 @@ namespace qrcode
     template<class T> struct is_eci_view : std::false_type {};
     template<class T> struct is_eci_view<qrcode::eci::view<T>> : std::true_type {};
     template<class T> inline constexpr auto is_eci_view_v = is_eci_view<T>::value;
+
+    // kanji mode holds shift jis characters, bytes of other character sets must not end up there
+    template<class Message>
+    [[nodiscard]] constexpr auto allows_kanji_mode(Message const& message) noexcept
+    {
+        using qrcode::eci::shift_jis_assignment_number;
+
+        if constexpr (is_eci_view_v<std::decay_t<Message>>)
+            return header(message).eci_assignment_number.value == shift_jis_assignment_number.value;
+        else
+            return true;
+    }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
+
 namespace qrcode::eci::test
 {
     constexpr auto is_eci_view_returns_true_when_given_type_is_an_eci_view_false_otherwise()
@@ -100,5 +114,13 @@ namespace qrcode::eci::test
         static_assert(is_eci_view_v<view<std::array<char,4>&>>);
         static_assert(is_eci_view_v<view<std::array<std::byte,4>&>>);
     }
+
+    constexpr auto allows_kanji_mode_returns_false_for_eci_views_of_other_than_shift_jis_characters()
+    {
+        using namespace std::literals;
+        static_assert(allows_kanji_mode("\x93\x5F"sv));
+        static_assert(allows_kanji_mode(view{shift_jis_assignment_number, "\x93\x5F"sv}));
+        static_assert(!allows_kanji_mode(view{utf8_assignment_number, "\xE6\x97\xA5"sv}));
+    }
 }
 #endif
\ No newline at end of file
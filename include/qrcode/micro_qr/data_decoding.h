@@ -0,0 +1,142 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <algorithm>
+#include <optional>
+
+#include <cx/vector.h>
+
+#include <qrcode/micro_qr/encoders.h>
+#include <qrcode/micro_qr/symbol_version.h>
+
+#include <qrcode/data/bit_reader.h>
+#include <qrcode/data/segment_decoding.h>
+
+namespace qrcode::micro_qr::detail
+{
+    using qrcode::data::bit_reader;
+
+    [[nodiscard]] constexpr auto is_terminated(bit_reader reader, symbol_version version) noexcept
+    {
+        using qrcode::data::number_bits;
+
+        // the terminator is truncated if the symbol capacity is exhausted
+        auto const terminator_size = std::min(3 + 2 * number(version), reader.remaining());
+        return reader.read(number_bits{terminator_size}) == 0;
+    }
+}
+
+namespace qrcode::micro_qr
+{
+    using qrcode::data::decoded_data;
+
+    [[nodiscard]] constexpr auto decode_data(
+        cx::vector<bool> const& bits, symbol_version version) noexcept
+    {
+        using qrcode::micro_qr::detail::is_terminated;
+        using qrcode::data::bit_reader;
+        using qrcode::data::number_bits;
+        using qrcode::data::decode_segment;
+        using result_type = std::optional<decoded_data>;
+
+        auto const mode_size = number_bits{number(version)};
+        auto const encoders = available_encoders(version);
+
+        auto reader = bit_reader{bits};
+        auto data = decoded_data{};
+
+        // micro qr symbols have no eci mode, the terminator equals an empty numeric segment
+        while (!is_terminated(reader, version))
+        {
+            auto const indicator = reader.read(mode_size);
+            if (!indicator || !decode_segment(reader, encoders, *indicator, data))
+                return result_type{};
+        }
+        return result_type{std::move(data)};
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
+#include <qrcode/data/best_fit/data_encoding.h>
+
+namespace qrcode::micro_qr::test
+{
+    constexpr auto decode_data_restores_the_message_of_encoded_micro_qr_data()
+    {
+        auto f = [](auto message, auto version)
+        {
+            using qrcode::data::bit_stream;
+            using qrcode::data::best_fit::encode_data;
+
+            auto stream = bit_stream{};
+            if (!encode_data(stream, available_encoders(version), message))
+                return false;
+
+            auto const data = decode_data(stream.get(), version);
+            return data 
+                && !data->eci_assignment_number 
+                && std::ranges::equal(data->message, message);
+        };
+
+        using namespace std::literals;
+        static_assert(f("01234"sv, symbol_version::M1));
+        static_assert(f("AB12"sv, symbol_version::M2));
+        static_assert(f("Hello!"sv, symbol_version::M3));
+        static_assert(f("\x93\x5F" "0123456789"sv, symbol_version::M4));
+    }
+
+    constexpr auto decode_data_stops_at_the_micro_qr_terminator()
+    {
+        auto f = []
+        {
+            using qrcode::data::bit_stream;
+            using qrcode::data::number_bits;
+
+            // M2: 1 bit mode, 4 bit numeric count, 5 bit terminator
+            auto const bits = bit_stream{}
+                .add(0b0, number_bits{1}).add(1, number_bits{4}).add(7, number_bits{4})
+                .add(0b00000, number_bits{5}).add(0b1010, number_bits{4}).get();
+            auto const data = decode_data(bits, symbol_version::M2);
+            return data && std::ranges::equal(data->message, std::array{'7'});
+        };
+        static_assert(f());
+    }
+
+    constexpr auto decode_data_rejects_truncated_micro_qr_segments()
+    {
+        auto f = []
+        {
+            using qrcode::data::bit_stream;
+            using qrcode::data::number_bits;
+
+            // M2: an alphanumeric segment announcing 31 characters without any data
+            auto const bits = bit_stream{}.add(0b1, number_bits{1}).add(31, number_bits{5}).get();
+            return !decode_data(bits, symbol_version::M2);
+        };
+        static_assert(f());
+    }
+}
+#endif
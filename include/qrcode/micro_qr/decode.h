@@ -0,0 +1,246 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <cx/vector.h>
+
+#include <qrcode/decoded_symbol.h>
+
+#include <qrcode/micro_qr/code_capacity.h>
+#include <qrcode/micro_qr/data_decoding.h>
+#include <qrcode/micro_qr/format_information.h>
+#include <qrcode/micro_qr/mask_pattern.h>
+#include <qrcode/micro_qr/raw_code.h>
+#include <qrcode/micro_qr/symbol_designator.h>
+#include <qrcode/micro_qr/symbol_version.h>
+
+#include <qrcode/code/bit_view.h>
+#include <qrcode/code/byte_view.h>
+#include <qrcode/code/error_correction_decoder.h>
+#include <qrcode/code/sequence_description.h>
+
+#include <qrcode/structure/mask_plane.h>
+#include <qrcode/structure/matrix.h>
+#include <qrcode/structure/position.h>
+#include <qrcode/structure/read_data.h>
+
+namespace qrcode::micro_qr::detail
+{
+    using qrcode::structure::position;
+
+    struct placement
+    {
+        std::vector<position> positions{};
+        mask_planes masks{};
+    };
+
+    [[nodiscard]] constexpr auto make_placement(symbol_version version) noexcept
+    {
+        using qrcode::structure::make_placement_map;
+        using qrcode::structure::make_mask_planes;
+
+        auto const layout = make_function_layout<char>(version);
+        auto const data_region = mask_plane{make_raw_code<char>(version, std::array<bool,0>{})};
+        return placement{make_placement_map(layout), make_mask_planes(data_region, mask_patterns())};
+    }
+
+    struct cached_placement_entry
+    {
+        std::span<position const> positions;
+        mask_planes const& masks;
+    };
+
+    // the positions are sized by the data modules of the version and the masks are the planes of the encoder
+    [[nodiscard]] inline auto cached_placement(symbol_version version) -> cached_placement_entry
+    {
+        using qrcode::structure::make_placement_map;
+
+        constexpr auto version_count = 4;
+
+        static auto positions = std::array<std::vector<position>, version_count>{};
+        static auto masks = std::array<mask_planes const*, version_count>{};
+        static auto initialized = std::array<std::once_flag, version_count>{};
+
+        auto const index = number(version);
+        std::call_once(initialized[index], [&]
+        { 
+            positions[index] = make_placement_map(make_function_layout<char>(version)); 
+            masks[index] = &cached_mask_planes(version, make_raw_code<char>(version, std::array<bool,0>{}));
+        });
+        return cached_placement_entry{positions[index], *masks[index]};
+    }
+
+    [[nodiscard]] constexpr auto symbol_version_of(dimension symbol_size) noexcept
+    {
+        for (auto version : versions())
+            if (size(version) == symbol_size)
+                return std::optional{version};
+        return std::optional<symbol_version>{};
+    }
+
+    template<class Module>
+    [[nodiscard]] constexpr auto decode(
+        matrix<Module> const& code, symbol_version symbol_size_version, 
+        std::span<position const> positions, mask_planes const& masks) noexcept
+    {
+        using qrcode::structure::read_data;
+        using qrcode::code::make_sequence_description;
+        using qrcode::code::correct_sequence;
+        using qrcode::code::bits_per_codeword;
+        using result_type = std::optional<decoded_symbol<symbol_designator>>;
+
+        auto const format = read_format_information(code);
+        if (!format || version(format->first) != symbol_size_version)
+            return result_type{};
+
+        auto const [designator, data_mask] = *format;
+        auto const capacity = make_code_capacity(designator);
+        auto const data_bit_count = total_data_bits(capacity);
+        auto const error_bit_count = error_degree(capacity) * bits_per_codeword();
+
+        // M1 and M3 end their data with a codeword of four bits, its lower half is zero
+        auto const bits = read_data(positions, code, masks[data_mask]);
+        auto codewords = cx::vector<std::byte>{};
+        for (auto i : bits | std::views::take(data_bit_count) | views::byte)
+            codewords.push_back(i);
+        for (auto i : bits | std::views::drop(data_bit_count) | std::views::take(error_bit_count) | views::byte)
+            codewords.push_back(i);
+
+        auto const corrected = correct_sequence(make_sequence_description(capacity), codewords);
+        if (!corrected)
+            return result_type{};
+
+        auto data_bits = cx::vector<bool>{};
+        for (auto i : corrected->data | views::bit | std::views::take(data_bit_count))
+            data_bits.push_back(i);
+
+        auto data = decode_data(data_bits, symbol_size_version);
+        if (!data)
+            return result_type{};
+
+        return result_type{decoded_symbol<symbol_designator>{
+            designator, data_mask, corrected->error_count, std::move(*data)}};
+    }
+}
+
+namespace qrcode::micro_qr
+{
+    template<class Module>
+    [[nodiscard]] constexpr auto decode(matrix<Module> const& code) noexcept
+    {
+        using qrcode::micro_qr::detail::symbol_version_of;
+        using qrcode::micro_qr::detail::make_placement;
+        using qrcode::micro_qr::detail::cached_placement;
+        using result_type = std::optional<decoded_symbol<symbol_designator>>;
+
+        auto const version = symbol_version_of(size(code));
+        if (!version)
+            return result_type{};
+
+        if (std::is_constant_evaluated())
+        {
+            auto const placement = make_placement(*version);
+            return detail::decode(code, *version, placement.positions, placement.masks);
+        }
+        auto const placement = cached_placement(*version);
+        return detail::decode(code, *version, placement.positions, placement.masks);
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
+#include <qrcode/micro_qr/micro_qr.h>
+
+namespace qrcode::micro_qr::detail::test
+{
+    constexpr auto symbol_version_of_returns_the_version_of_given_micro_qr_symbol_size()
+    {
+        static_assert(symbol_version_of({11,11}) == symbol_version::M1);
+        static_assert(symbol_version_of({17,17}) == symbol_version::M4);
+        static_assert(!symbol_version_of({12,12}));
+        static_assert(!symbol_version_of({21,21}));
+    }
+}
+
+namespace qrcode::micro_qr::test
+{
+    constexpr auto decode_restores_message_and_designator_of_generated_micro_qr_symbols()
+    {
+        auto f = [](auto message, auto version, auto error_level)
+        {
+            auto const s = make_symbol<char>(message, version, error_level).value();
+            auto const decoded = decode(modules(s));
+            return decoded 
+                && decoded->designator == designator(s)
+                && decoded->mask_pattern == mask_pattern(s)
+                && decoded->error_count == 0
+                && std::ranges::equal(decoded->data.message, message);
+        };
+
+        using namespace std::literals;
+        static_assert(f("01234"sv, symbol_version::M1, std::nullopt));
+        static_assert(f("AB12"sv, symbol_version::M2, error_correction::level_L));
+        static_assert(f("12345678"sv, symbol_version::M3, error_correction::level_M));
+        static_assert(f("Hello!"sv, symbol_version::M4, error_correction::level_Q));
+    }
+
+    constexpr auto decode_corrects_damaged_micro_qr_symbols()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            constexpr auto any_message = "01234567"sv;
+            auto const s = make_symbol<char>(any_message, symbol_version::M3, error_correction::level_M).value();
+
+            auto damaged = modules(s);
+            auto& any_data_module = element_at(damaged, {14,14});
+            any_data_module = any_data_module == '+' ? ',' : '+';
+
+            auto const decoded = decode(damaged);
+            return decoded 
+                && decoded->error_count == 1
+                && std::ranges::equal(decoded->data.message, any_message);
+        };
+        static_assert(f());
+    }
+
+    constexpr auto decode_rejects_matrices_which_are_no_micro_qr_symbols()
+    {
+        auto f = []
+        {
+            return !decode(matrix<char>{{11,11}, '-'}) && !decode(matrix<char>{{12,12}, '-'});
+        };
+        static_assert(f());
+    }
+}
+#endif
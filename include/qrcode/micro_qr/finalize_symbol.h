@@ -24,6 +24,7 @@
 #pragma once
 
 #include <concepts>
+#include <iterator>
 #include <ranges>
 
 #include <qrcode/symbol.h>
@@ -34,7 +35,6 @@
 #include <qrcode/micro_qr/mask_pattern.h>
 #include <qrcode/micro_qr/penalty_score.h>
 
-#include <qrcode/structure/data_masking.h>
 #include <qrcode/structure/matrix.h>
 
 namespace qrcode::micro_qr
@@ -44,9 +44,29 @@ namespace qrcode::micro_qr
     template<class T>
     [[nodiscard]] constexpr auto finalize(matrix<T> code, symbol_designator designator) noexcept
     {
-        auto const masks = available_masks();
-        auto const score = [](matrix<T> const& code) { return penalty_score(code); };
-        auto const mask_id = static_cast<int>(data_masking(code, masks, score) - begin(masks));
+        using qrcode::micro_qr::detail::edge_score;
+        using qrcode::micro_qr::detail::make_edge_bits;
+
+        // only the lower and the right edge are scored, so the candidates are compared by the
+        // cached edges of their masks and just the winning mask touches the whole symbol
+        auto const edges = make_edge_bits(code);
+        auto const mask_id = with_available_masks(version(designator), code, [&](auto const& masks)
+        {
+            auto mask_id = 0;
+            auto best_score = edge_score(edges ^ masks.edges[0]);
+            for (auto i = 1; i != static_cast<int>(std::size(masks.edges)); ++i)
+            {
+                auto const current_score = edge_score(edges ^ masks.edges[i]);
+                if (current_score < best_score)
+                {
+                    best_score = current_score;
+                    mask_id = i;
+                }
+            }
+
+            code = masks.planes[mask_id](std::move(code));
+            return mask_id;
+        });
         place_format_information(code, designator, mask_id);
         return symbol{std::move(designator), mask_id, std::move(code)};
     }
@@ -23,6 +23,10 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <optional>
+#include <utility>
+
 #include <qrcode/micro_qr/symbol_designator.h>
 #include <qrcode/micro_qr/symbol_number.h>
 #include <qrcode/code/format_encoding.h>
@@ -40,6 +44,7 @@ namespace qrcode::micro_qr::detail
     using qrcode::structure::matrix;
     using qrcode::code::raw_format;
     using qrcode::code::error_correcting_code;
+    using qrcode::code::format_mask;
 
     [[nodiscard]] constexpr auto bch_code() noexcept
     {
@@ -55,6 +60,11 @@ namespace qrcode::micro_qr::detail
         };
     }
 
+    [[nodiscard]] constexpr auto format_mask_pattern() noexcept
+    {
+        return format_mask{0b100'0100'0100'0101};
+    }
+
     [[nodiscard]] constexpr auto format_positions() noexcept
     {
         return std::array<position, 15>{{
@@ -88,10 +98,10 @@ namespace qrcode::micro_qr
         using qrcode::micro_qr::detail::bch_code;
         using qrcode::micro_qr::detail::format;
         using qrcode::micro_qr::detail::format_positions;
-        using qrcode::code::format_mask;
+        using qrcode::micro_qr::detail::format_mask_pattern;
         using qrcode::structure::module_traits;
         
-        auto const mask_pattern = format_mask{0b100'0100'0100'0101};
+        auto const mask_pattern = format_mask_pattern();
         auto format_bits = masked(
             encode(format(designator, data_mask), bch_code()), mask_pattern).data;
 
@@ -104,6 +114,41 @@ namespace qrcode::micro_qr
             format_bits >>= 1;
         }
     }
+
+    template<class T>
+    [[nodiscard]] constexpr auto read_format_information(matrix<T> const& matrix) noexcept
+    {
+        using qrcode::micro_qr::detail::bch_code;
+        using qrcode::micro_qr::detail::format_positions;
+        using qrcode::micro_qr::detail::format_mask_pattern;
+        using qrcode::structure::module_traits;
+        using qrcode::code::masked_format;
+        using qrcode::code::nearest_format;
+        using result_type = std::optional<std::pair<symbol_designator, int>>;
+
+        // there is a single copy, the nearest codeword is unique up to 3 errors
+        constexpr auto max_errors = 3;
+        auto is_set = module_traits<T>::is_set;
+
+        auto format_bits = std::uint16_t{0};
+        auto bit = std::uint16_t{1};
+        for (auto i : format_positions())
+        {
+            format_bits |= is_set(element_at(matrix, i)) ? bit : 0;
+            bit <<= 1;
+        }
+
+        auto const [format, errors] = nearest_format(
+            unmasked(masked_format{format_bits}, format_mask_pattern()), bch_code());
+        if (errors > max_errors)
+            return result_type{};
+
+        auto const designator = designator_of_symbol_number(format.data >> 2);
+        if (!designator)
+            return result_type{};
+
+        return result_type{{*designator, format.data & 0b11}};
+    }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
@@ -154,5 +199,27 @@ namespace qrcode::micro_qr::test
         };
         static_assert(f());
     }
+
+    constexpr auto read_format_information_returns_the_placed_designator_and_data_mask()
+    {
+        auto f = [](auto designator, auto data_mask)
+        {
+            using namespace qrcode::structure;
+            auto any_matrix = matrix<char>(size(version(designator)), module_traits<char>::make_free());
+            place_format_information(any_matrix, designator, data_mask);
+
+            auto const intact = read_format_information(any_matrix);
+
+            auto& any_module = element_at(any_matrix, {8,3});
+            any_module = module_traits<char>::make_function(!module_traits<char>::is_set(any_module));
+            auto const damaged = read_format_information(any_matrix);
+
+            auto const expected = std::pair{designator, data_mask};
+            return intact == expected && damaged == expected;
+        };
+        static_assert(f(*make_designator(symbol_version::M1, std::nullopt), 0b11));
+        static_assert(f(*make_designator(symbol_version::M3, error_correction::level_M), 0b01));
+        static_assert(f(*make_designator(symbol_version::M4, error_correction::level_Q), 0b10));
+    }
 }
 #endif
\ No newline at end of file
@@ -24,9 +24,16 @@
 #pragma once
 
 #include <array>
+#include <mutex>
 #include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include <qrcode/micro_qr/penalty_score.h>
+#include <qrcode/micro_qr/symbol_version.h>
 
 #include <qrcode/structure/apply_mask.h>
+#include <qrcode/structure/mask_plane.h>
 #include <qrcode/structure/matrix.h>
 
 namespace qrcode::micro_qr
@@ -49,6 +56,89 @@ namespace qrcode::micro_qr
     }
 }
 
+namespace qrcode::micro_qr::detail
+{
+    using mask_plane = qrcode::structure::mask_plane<width(size(symbol_version::M4))>;
+    using mask_planes = std::array<mask_plane, 4>;
+    using mask_edges = std::array<edge_bits, 4>;
+
+    // the planes and the modules each of them flips along the two scored edges
+    struct available_masks
+    {
+        mask_planes planes{};
+        mask_edges edges{};
+    };
+
+    [[nodiscard]] constexpr auto make_available_masks(mask_plane const& region) noexcept
+    {
+        using qrcode::structure::make_mask_planes;
+
+        auto masks = available_masks{make_mask_planes(region, mask_patterns())};
+        for (auto i = 0; i != static_cast<int>(std::size(masks.planes)); ++i)
+            masks.edges[i] = make_edge_bits(masks.planes[i]);
+        return masks;
+    }
+
+    struct mask_plane_cache_entries
+    {
+        std::array<available_masks, 4> masks;
+        std::array<std::once_flag, 4> initialized;
+    };
+
+    // shared by all module types, whichever symbol of a version comes first fills it
+    [[nodiscard]] inline auto mask_plane_cache() -> mask_plane_cache_entries&
+    {
+        static auto cache = mask_plane_cache_entries{};
+        return cache;
+    }
+
+    // the data region only depends on the symbol version, so do the planes; the
+    // region is only scanned from given code by the first symbol of each version
+    template<class T>
+    [[nodiscard]] auto cached_masks(
+        symbol_version version, qrcode::structure::matrix<T> const& code) -> available_masks const&
+    {
+        auto& [masks, initialized] = mask_plane_cache();
+
+        auto const index = number(version);
+        std::call_once(initialized[index], [&]
+        { 
+            masks[index] = make_available_masks(mask_plane{code}); 
+        });
+        return masks[index];
+    }
+
+    template<class T>
+    [[nodiscard]] auto cached_mask_planes(
+        symbol_version version, qrcode::structure::matrix<T> const& code) -> mask_planes const&
+    {
+        return cached_masks(version, code).planes;
+    }
+}
+
+namespace qrcode::micro_qr
+{
+    using qrcode::structure::matrix;
+
+    // hands the masks of given code and their edges to given function, at runtime these
+    // are cached for its version and never copied
+    template<class T, class Function>
+    constexpr auto with_available_masks(
+        symbol_version version, matrix<T> const& code, Function&& function) noexcept
+    {
+        using qrcode::micro_qr::detail::cached_masks;
+        using qrcode::micro_qr::detail::make_available_masks;
+        using qrcode::micro_qr::detail::mask_plane;
+
+        if (std::is_constant_evaluated())
+        {
+            auto const masks = make_available_masks(mask_plane{code});
+            return std::forward<Function>(function)(masks);
+        }
+        return std::forward<Function>(function)(cached_masks(version, code));
+    }
+}
+
 #ifdef QRCODE_TESTS_ENABLED
 namespace qrcode::micro_qr::test
 {
@@ -40,6 +40,7 @@
 #include <qrcode/micro_qr/encoders.h>
 #include <qrcode/micro_qr/symbol_version.h>
 
+#include <qrcode/data/best_fit/character_classes.h>
 #include <qrcode/data/best_fit/data_encoding.h>
 #include <qrcode/data/best_fit/data_length.h>
 
@@ -56,6 +57,7 @@ namespace qrcode::micro_qr
     ) noexcept
     {
         using symbol_type = symbol<Module, symbol_designator>;
+        using qrcode::data::best_fit::classify;
         using qrcode::data::best_fit::encode_data;
         using qrcode::data::best_fit::data_length;
         using qrcode::data::bit_stream;
@@ -64,15 +66,16 @@ namespace qrcode::micro_qr
         if (!symbol_designator)
             return result<symbol_type>{error_code::version_and_error_level_not_supported}; 
         
+        auto const classes = classify(message);
         auto const encoders = available_encoders(version);
-        auto const needed_size = data_length(encoders, message);
+        auto const needed_size = data_length(encoders, message, classes);
         auto const capacity = make_code_capacity(*symbol_designator);
         
         if (needed_size > total_data_bits(capacity))
             return result<symbol_type>{error_code::data_too_large};
 
         auto stream = bit_stream{};
-        [[maybe_unused]] auto const success = encode_data(stream, encoders, message);
+        [[maybe_unused]] auto const success = encode_data(stream, encoders, message, classes);
         assert(success);
         
         return result<symbol_type>{finalize(
@@ -87,6 +90,7 @@ namespace qrcode::micro_qr
         Message&& message, std::optional<error_correction> error_level = std::nullopt) noexcept
     {
         using symbol_type = symbol<Module, symbol_designator>;
+        using qrcode::data::best_fit::classify;
         using qrcode::data::best_fit::encode_data;
         using qrcode::data::best_fit::data_length;
         using qrcode::data::bit_stream;
@@ -96,10 +100,12 @@ namespace qrcode::micro_qr
             | std::views::filter([=](auto v){ return v != symbol_version::M1 || error_level; })
             | std::views::filter([=](auto v){ return v == symbol_version::M4 || error_level != error_correction::level_Q; });
         
+        // the message is scanned once, every version derives its bit count from the classes
+        auto const classes = classify(message);
         for (auto i : filtered)
         {
             auto const encoders = available_encoders(i);
-            auto const needed_size = data_length(encoders, message);
+            auto const needed_size = data_length(encoders, message, classes);
             if (!needed_size)
                 continue;
 
@@ -111,7 +117,7 @@ namespace qrcode::micro_qr
             assert(designator != std::nullopt);
 
             auto stream = bit_stream{};
-            [[maybe_unused]] auto const success = encode_data(stream, encoders, message);
+            [[maybe_unused]] auto const success = encode_data(stream, encoders, message, classes);
             assert(success);
             
             return result{finalize(
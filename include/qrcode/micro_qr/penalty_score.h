@@ -23,15 +23,15 @@
  */
 #pragma once
 
-#include <ranges>
+#include <bit>
 #include <concepts>
+#include <cstdint>
 #include <numeric>
+#include <ranges>
 
-#include <qrcode/structure/element_view.h>
-#include <qrcode/structure/horizontal_view.h>
+#include <qrcode/structure/mask_plane.h>
 #include <qrcode/structure/matrix.h>
 #include <qrcode/structure/module_traits.h>
-#include <qrcode/structure/vertical_view.h>
 
 namespace qrcode::micro_qr::detail
 {
@@ -54,8 +54,8 @@ namespace qrcode::micro_qr::detail
         using qrcode::structure::module_traits;
 
         auto range = 
-            views::horizontal({1,height(matrix)-1}, {width(matrix)-1,1}) 
-            | views::element(matrix)
+            row(matrix, height(matrix)-1) 
+            | std::views::drop(1)
             | std::views::transform([](auto v) { return module_traits<T>::is_set(v); });
 
         return sum(range);
@@ -67,8 +67,8 @@ namespace qrcode::micro_qr::detail
         using qrcode::structure::module_traits;
 
         auto range = 
-            views::vertical({width(matrix)-1,1}, {1,height(matrix)-1}) 
-            | views::element(matrix)
+            column(matrix, width(matrix)-1) 
+            | std::views::drop(1)
             | std::views::transform([](auto v) { return module_traits<T>::is_set(v); });
 
         return sum(range);
@@ -109,6 +109,63 @@ namespace qrcode::micro_qr
     }
 }
 
+namespace qrcode::micro_qr::detail
+{
+    // the only modules scored by the penalty score: module i of the lower and the right edge in bit i
+    struct edge_bits
+    {
+        std::uint32_t lower = 0;
+        std::uint32_t right = 0;
+
+        [[nodiscard]] constexpr auto operator==(edge_bits const&) const noexcept -> bool = default;
+    };
+
+    [[nodiscard]] constexpr auto operator^(edge_bits const& a, edge_bits const& b) noexcept
+    {
+        return edge_bits{a.lower ^ b.lower, a.right ^ b.right};
+    }
+
+    template<class T>
+    [[nodiscard]] constexpr auto make_edge_bits(matrix<T> const& matrix) noexcept
+    {
+        using qrcode::structure::module_traits;
+
+        auto edges = edge_bits{};
+        auto const lower = row(matrix, height(matrix)-1);
+        for (auto x = 0; x != width(matrix); ++x)
+            if (module_traits<T>::is_set(lower[x]))
+                edges.lower |= std::uint32_t{1} << x;
+        for (auto y = 0; y != height(matrix); ++y)
+            if (module_traits<T>::is_set(row(matrix, y)[width(matrix)-1]))
+                edges.right |= std::uint32_t{1} << y;
+        return edges;
+    }
+
+    // the modules flipped by the mask along both edges
+    template<int Max_Size>
+    [[nodiscard]] constexpr auto make_edge_bits(qrcode::structure::mask_plane<Max_Size> const& plane) noexcept
+    {
+        auto const extend = size(plane);
+        auto edges = edge_bits{};
+        for (auto x = 0; x != width(extend); ++x)
+            if (is_masked(plane, {x, height(extend)-1}))
+                edges.lower |= std::uint32_t{1} << x;
+        for (auto y = 0; y != height(extend); ++y)
+            if (is_masked(plane, {width(extend)-1, y}))
+                edges.right |= std::uint32_t{1} << y;
+        return edges;
+    }
+
+    // same as the penalty score of the masked symbol, the corner module is not counted
+    [[nodiscard]] constexpr auto edge_score(edge_bits const& edges) noexcept
+    {
+        constexpr auto without_corner = ~std::uint32_t{1};
+        return negative_score{high_score(
+            std::popcount(edges.lower & without_corner), 
+            std::popcount(edges.right & without_corner))};
+    }
+}
+
 #ifdef QRCODE_TESTS_ENABLED
 #include <string_view>
 #include <qrcode/structure/make_matrix.h>
@@ -188,6 +245,33 @@ namespace qrcode::micro_qr::detail::test
         static_assert(high_score(2, 1) == 18);
         static_assert(high_score(6, 8) == 104);
     }
+
+    constexpr auto edge_score_equals_the_penalty_score_of_the_masked_symbol()
+    {
+        using namespace std::literals;
+        using qrcode::structure::make_matrix;
+        using plane = qrcode::structure::mask_plane<11>;
+        constexpr auto any_matrix = make_matrix<char>({11,11},
+            "..........+"
+            "..........+"
+            ",,,,,,,,,,,"
+            "..........,"
+            "..........+"
+            "..........,"
+            "..........,"
+            "..........+"
+            "..........+"
+            "..........,"
+            "++,,+,+,++,"sv
+        );
+        constexpr auto any_mask = [](int i, int j) { return (i + j) % 2 == 0; };
+        constexpr auto any_plane = plane{plane{any_matrix}, any_mask};
+        constexpr auto masked = any_plane(any_matrix);
+
+        static_assert(make_edge_bits(any_matrix) == edge_bits{0b011'0101'0011, 0b001'1001'0011});
+        static_assert(edge_score(make_edge_bits(any_matrix) ^ make_edge_bits(any_plane)).value 
+            == penalty_score(masked).value);
+    }
 }
 
 namespace qrcode::micro_qr::test
@@ -40,12 +40,10 @@ namespace qrcode::micro_qr
 {
     using qrcode::structure::matrix;
 
-    template<class T, std::ranges::range Range>
-    requires std::convertible_to<std::ranges::range_value_t<Range>, bool>
-    [[nodiscard]] constexpr auto make_raw_code(symbol_version version, Range&& bits) noexcept
+    template<class T>
+    [[nodiscard]] constexpr auto make_function_layout(symbol_version version) noexcept
     {
         using qrcode::structure::module_traits;
-        using qrcode::structure::place_data;
 
         auto code = matrix<T>{size(version), module_traits<T>::make_free()};
 
@@ -53,6 +51,18 @@ namespace qrcode::micro_qr
         place_separator_pattern(code);
         place_timing_patterns(code);
         reserve_format_information(code);
+
+        return code;
+    }
+
+    template<class T, std::ranges::range Range>
+    requires std::convertible_to<std::ranges::range_value_t<Range>, bool>
+    [[nodiscard]] constexpr auto make_raw_code(symbol_version version, Range&& bits) noexcept
+    {
+        using qrcode::structure::module_traits;
+        using qrcode::structure::place_data;
+
+        auto code = make_function_layout<T>(version);
         place_data(code, bits | std::views::transform(module_traits<T>::make_data));
 
         return code;
@@ -23,7 +23,11 @@
  */
 #pragma once
 
+#include <array>
+#include <optional>
+
 #include <qrcode/micro_qr/error_correction.h>
+#include <qrcode/micro_qr/symbol_designator.h>
 #include <qrcode/micro_qr/symbol_version.h>
 
 namespace qrcode::micro_qr
@@ -46,6 +50,20 @@ namespace qrcode::micro_qr
         }
         return 0;
     }
+
+    [[nodiscard]] constexpr auto designator_of_symbol_number(int number) noexcept 
+    -> std::optional<symbol_designator>
+    {
+        constexpr auto error_levels = std::array<std::optional<error_correction>, 4>{
+            std::nullopt, error_correction::level_L, error_correction::level_M, error_correction::level_Q};
+
+        for (auto version : versions())
+            for (auto error_level : error_levels)
+                if (auto const designator = make_designator(version, error_level))
+                    if (symbol_number(*designator) == number)
+                        return designator;
+        return std::nullopt;
+    }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
@@ -62,5 +80,13 @@ namespace qrcode::micro_qr::test
         static_assert(symbol_number(*make_designator(symbol_version::M4, error_correction::level_M)) == 6);
         static_assert(symbol_number(*make_designator(symbol_version::M4, error_correction::level_Q)) == 7);
     }
+
+    constexpr auto designator_of_symbol_number_is_the_inverse_of_the_symbol_number()
+    {
+        static_assert(designator_of_symbol_number(0) == make_designator(symbol_version::M1, std::nullopt));
+        static_assert(designator_of_symbol_number(4) == make_designator(symbol_version::M3, error_correction::level_M));
+        static_assert(designator_of_symbol_number(7) == make_designator(symbol_version::M4, error_correction::level_Q));
+        static_assert(!designator_of_symbol_number(8));
+    }
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,102 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <cstdint>
+#include <ranges>
+#include <concepts>
+
+#include <qrcode/symbol.h>
+
+#include <qrcode/micro_qr/decode.h>
+#include <qrcode/micro_qr/symbol_designator.h>
+
+namespace qrcode::micro_qr
+{
+    template<class Module, std::ranges::forward_range Message>
+    requires std::convertible_to<std::ranges::range_value_t<Message>, char>
+    [[nodiscard]] constexpr auto verify(
+        symbol<Module, symbol_designator> const& symbol, Message&& message) noexcept
+    {
+        auto as_byte = [](auto c) { return static_cast<std::uint8_t>(c); };
+
+        // a generated symbol must be readable without any correction
+        auto const decoded = decode(modules(symbol));
+        return decoded
+            && decoded->designator == designator(symbol)
+            && decoded->mask_pattern == mask_pattern(symbol)
+            && decoded->error_count == 0
+            && std::ranges::equal(decoded->data.message, message, {}, as_byte, as_byte);
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
+#include <qrcode/micro_qr/micro_qr.h>
+
+namespace qrcode::micro_qr::test
+{
+    constexpr auto micro_qr_symbols_can_be_verified_against_the_message_they_were_generated_from()
+    {
+        auto f = [](auto message, auto version, auto error_level)
+        {
+            auto const s = make_symbol<char>(message, version, error_level).value();
+            return verify(s, message);
+        };
+
+        using namespace std::literals;
+        static_assert(f("01234"sv, symbol_version::M1, std::nullopt));
+        static_assert(f("ABRACADABRA"sv, symbol_version::M3, error_correction::level_L));
+        static_assert(f("Hello, world!"sv, symbol_version::M4, error_correction::level_L));
+    }
+
+    constexpr auto micro_qr_symbols_do_not_verify_against_a_different_message()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            auto const s = make_symbol<char>("01234567"sv, symbol_version::M2, error_correction::level_L).value();
+            return !verify(s, "01234568"sv) && !verify(s, "0123456"sv);
+        };
+        static_assert(f());
+    }
+
+    constexpr auto micro_qr_symbols_with_damaged_modules_do_not_verify()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            constexpr auto any_message = "01234567"sv;
+            auto const s = make_symbol<char>(any_message, symbol_version::M3, error_correction::level_M).value();
+
+            auto damaged = modules(s);
+            auto& any_data_module = element_at(damaged, {14,14});
+            any_data_module = any_data_module == '+' ? ',' : '+';
+
+            return !verify(symbol{designator(s), mask_pattern(s), damaged}, any_message);
+        };
+        static_assert(f());
+    }
+}
+#endif
@@ -0,0 +1,85 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <qrcode/symbol.h>
+
+#include <qrcode/structure/packed_matrix.h>
+
+namespace qrcode
+{
+    using qrcode::structure::packed_matrix;
+
+    // compact form of a symbol which may be kept in memory for a long time
+    template<Symbol_Designator Designator>
+    struct packed_symbol
+    {
+        Designator designator;
+        int mask_pattern = 0;
+        packed_matrix modules{};
+
+        [[nodiscard]] constexpr auto operator==(packed_symbol const&) const noexcept -> bool = default;
+        [[nodiscard]] constexpr auto operator!=(packed_symbol const&) const noexcept -> bool = default;
+    };
+
+    template<class Module, Symbol_Designator Designator>
+    [[nodiscard]] constexpr auto pack(symbol<Module, Designator> const& symbol)
+    {
+        return packed_symbol<Designator>{
+            designator(symbol), mask_pattern(symbol), packed_matrix{modules(symbol)}};
+    }
+
+    template<class Module, Symbol_Designator Designator>
+    [[nodiscard]] constexpr auto unpack(packed_symbol<Designator> const& packed) noexcept
+    {
+        using qrcode::structure::unpack;
+        return symbol{packed.designator, packed.mask_pattern, unpack<Module>(packed.modules)};
+    }
+
+    template<Symbol_Designator Designator>
+    [[nodiscard]] constexpr auto byte_size(packed_symbol<Designator> const& packed) noexcept
+    {
+        return sizeof(packed) + byte_size(packed.modules);
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <qrcode/qr/qr.h>
+
+#if defined(__cpp_lib_constexpr_vector)
+namespace qrcode::test
+{
+    constexpr auto packed_symbols_can_be_unpacked_to_the_original_symbol()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            auto const any_symbol = qr::make_symbol<char>("ABRACADABRA"sv, qr::error_correction::level_M).value();
+            return unpack<char>(pack(any_symbol)) == any_symbol;
+        };
+        static_assert(f());
+    }
+}
+#endif
+#endif
@@ -0,0 +1,109 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <qrcode/symbol.h>
+#include <qrcode/packed_symbol.h>
+#include <qrcode/static_packed_symbol.h>
+#include <qrcode/structure/module_traits.h>
+
+namespace qrcode::detail
+{
+    template<class Stream, class Module>
+    constexpr auto pbm_header(Stream& stream, matrix<Module> const& modules)
+    {
+        stream << "P4\n" << width(size(modules)) << " " << height(size(modules)) << "\n";
+    }
+
+    // each row is packed separately, the most significant bit is the leftmost module
+    template<class Stream, class Module>
+    constexpr auto packed_rows(Stream& stream, matrix<Module> const& modules)
+    {
+        using qrcode::structure::module_traits;
+
+        auto const extent = size(modules);
+        for (auto y = 0; y != height(extent); ++y)
+        {
+            auto const line = row(modules, y);
+            for (auto x = 0; x < width(extent); x += 8)
+            {
+                auto byte = 0;
+                for (auto bit = 0; bit != 8 && x + bit < width(extent); ++bit)
+                    if (module_traits<Module>::is_set(line[x + bit]))
+                        byte |= 0x80 >> bit;
+                stream << static_cast<char>(byte);
+            }
+        }
+    }
+
+    // static packed symbols and packed matrices keep their own bit order, they are read module by module
+    template<class Stream, class Packed>
+    constexpr auto packed_rows(Stream& stream, Packed const& packed)
+    {
+        auto const extent = size(packed);
+        for (auto y = 0; y != height(extent); ++y)
+        for (auto x = 0; x < width(extent); x += 8)
+        {
+            auto byte = 0;
+            for (auto bit = 0; bit != 8 && x + bit < width(extent); ++bit)
+                if (is_set(packed, {x + bit, y}))
+                    byte |= 0x80 >> bit;
+            stream << static_cast<char>(byte);
+        }
+    }
+}
+
+namespace qrcode
+{
+    // binary portable bitmap, one bit per module
+    //
+    // example:
+    //
+    // auto symbol = ...;
+    // std::ofstream file{"qrcode.pbm", std::ofstream::out | std::ofstream::binary};
+    // pbm(file, symbol);
+    //
+    template<class Stream, class Module, Symbol_Designator Designator>
+    [[nodiscard]] constexpr auto pbm(Stream& stream, symbol<Module, Designator> const& symbol)
+    {
+        qrcode::detail::pbm_header(stream, modules(symbol));
+        qrcode::detail::packed_rows(stream, modules(symbol));
+    }
+
+    template<class Stream, Symbol_Designator Designator, int Width>
+    [[nodiscard]] constexpr auto pbm(Stream& stream, static_packed_symbol<Designator, Width> const& packed)
+    {
+        stream << "P4\n" << Width << " " << Width << "\n";
+        qrcode::detail::packed_rows(stream, packed);
+    }
+
+    // cached symbols are written without unpacking them first
+    template<class Stream, Symbol_Designator Designator>
+    [[nodiscard]] constexpr auto pbm(Stream& stream, packed_symbol<Designator> const& packed)
+    {
+        auto const extent = size(packed.modules);
+        stream << "P4\n" << width(extent) << " " << height(extent) << "\n";
+        qrcode::detail::packed_rows(stream, packed.modules);
+    }
+}
@@ -0,0 +1,382 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <qrcode/packed_symbol.h>
+#include <qrcode/static_packed_symbol.h>
+#include <qrcode/symbol.h>
+#include <qrcode/structure/dimension.h>
+#include <qrcode/structure/module_traits.h>
+#include <qrcode/zlib/deflate.h>
+
+namespace qrcode
+{
+    // sheet geometry in points (1/72 inch), the default is an A4 page
+    struct pdf_layout
+    {
+        double page_width = 595.276;
+        double page_height = 841.89;
+        double margin = 36.0;
+        int columns = 4;
+        int rows = 5;
+        int quiet_zone = 4;     // light modules around every symbol within its cell
+    };
+}
+
+namespace qrcode::detail
+{
+    using qrcode::structure::dimension;
+
+    // decimal number with at most three fractional digits, as PDF does not know exponents
+    [[nodiscard]] constexpr auto pdf_number(double value)
+    {
+        auto const negative = value < 0;
+        auto const scaled = static_cast<long long>((negative ? -value : value) * 1000.0 + 0.5);
+
+        auto text = std::string{};
+        if (auto fraction = scaled % 1000; fraction != 0)
+        {
+            for (auto i = 0; i != 3; ++i, fraction /= 10)
+                if (fraction % 10 != 0 || text.size() != 0)
+                    text.push_back(static_cast<char>('0' + fraction % 10));
+            text.push_back('.');
+        }
+
+        auto integral = scaled / 1000;
+        do 
+        { 
+            text.push_back(static_cast<char>('0' + integral % 10)); 
+            integral /= 10; 
+        } while (integral != 0);
+
+        if (negative && scaled != 0)
+            text.push_back('-');
+
+        std::ranges::reverse(text);
+        return text;
+    }
+
+    // one rectangle per horizontal run of dark modules, all filled at once
+    template<class Write, class Is_Set>
+    constexpr auto pdf_runs(Write&& write, dimension extend, Is_Set&& is_set)
+    {
+        for (auto y = 0; y != height(extend); ++y)
+        for (auto x = 0; x != width(extend);)
+        {
+            if (!is_set(x, y))
+            {
+                ++x;
+                continue;
+            }
+
+            auto const first = x;
+            while (x != width(extend) && is_set(x, y))
+                ++x;
+
+            write(pdf_number(first) + " " + pdf_number(y) + " " + pdf_number(x - first) + " 1 re\n");
+        }
+        write("f\n");
+    }
+
+    // counts the bytes written, the cross reference table needs the offset of every object
+    template<class Stream>
+    class pdf_output
+    {
+    public:
+        explicit constexpr pdf_output(Stream& stream_) noexcept
+        : stream{&stream_}
+        {
+        }
+
+        constexpr auto operator()(std::string_view text)
+        {
+            for (auto c : text)
+                *stream << c;
+            written += text.size();
+        }
+
+        constexpr auto operator()(std::uint8_t byte)
+        {
+            *stream << static_cast<char>(byte);
+            ++written;
+        }
+
+        [[nodiscard]] constexpr auto offset() const noexcept
+        {
+            return written;
+        }
+
+    private:
+        Stream* stream;
+        std::size_t written = 0;
+    };
+
+    template<class Stream>
+    struct pdf_byte_sink
+    {
+        pdf_output<Stream>* out;
+
+        constexpr auto operator()(std::uint8_t byte) { (*out)(byte); }
+    };
+}
+
+namespace qrcode
+{
+    // lays out symbols row by row on a grid of cells and writes one page whenever a sheet is full;
+    // every page is a single deflated content stream written as the symbols are added,
+    // so besides the object offsets the memory used does not depend on the number of sheets
+    //
+    // example:
+    //
+    // std::ofstream file{"sheet.pdf", std::ofstream::out | std::ofstream::binary};
+    // auto writer = pdf_writer{file, pdf_layout{.columns = 8, .rows = 10}};
+    // for (auto const& symbol : symbols)
+    //     writer.add(symbol);
+    // writer.finish();
+    //
+    template<class Stream>
+    class pdf_writer
+    {
+        static constexpr auto catalog_object = 1;
+        static constexpr auto pages_object = 2;
+        static constexpr auto resources_object = 3;
+        static constexpr auto objects_per_page = 3; // page, content stream and its length
+
+        using deflater = zlib::zlib_deflater<detail::pdf_byte_sink<Stream>>;
+
+    public:
+        explicit constexpr pdf_writer(Stream& stream, pdf_layout const& layout_ = pdf_layout{})
+        : out{stream}
+        , layout{layout_}
+        {
+            assert(layout.columns > 0 && layout.rows > 0 && layout.quiet_zone >= 0);
+            assert(layout.page_width > 2 * layout.margin && layout.page_height > 2 * layout.margin);
+
+            out("%PDF-1.4\n%\xE2\xE3\xCF\xD3\n");
+            begin_object(catalog_object);
+            out("<< /Type /Catalog /Pages " + reference(pages_object) + " >>\nendobj\n");
+            begin_object(resources_object);
+            out("<< /ProcSet [/PDF] >>\nendobj\n");
+        }
+
+        template<class Module, Symbol_Designator Designator>
+        constexpr auto add(symbol<Module, Designator> const& symbol)
+        {
+            using qrcode::structure::module_traits;
+            auto const& code = modules(symbol);
+            add(size(code), [&code](int x, int y) { return module_traits<Module>::is_set(row(code, y)[x]); });
+        }
+
+        template<Symbol_Designator Designator>
+        constexpr auto add(packed_symbol<Designator> const& packed)
+        {
+            add(size(packed.modules), [&packed](int x, int y) { return is_set(packed.modules, {x, y}); });
+        }
+
+        template<Symbol_Designator Designator, int Width>
+        constexpr auto add(static_packed_symbol<Designator, Width> const& packed)
+        {
+            add(size(packed), [&packed](int x, int y) { return is_set(packed, {x, y}); });
+        }
+
+        // closes the last page and writes the page tree, the cross references and the trailer;
+        // a document without symbols still gets one empty page, as PDF requires at least one
+        constexpr auto finish()
+        {
+            if (pages == 0 && !content)
+                begin_page();
+            if (content)
+                end_page();
+
+            begin_object(pages_object);
+            out("<< /Type /Pages /Kids [");
+            for (auto page = 0; page != pages; ++page)
+                out(reference(page_object(page)) + " ");
+            out("] /Count " + detail::pdf_number(pages) 
+                + " /MediaBox [0 0 " + detail::pdf_number(layout.page_width) + " " + detail::pdf_number(layout.page_height) + "]"
+                + " /Resources " + reference(resources_object) + " >>\nendobj\n");
+
+            auto const cross_references = out.offset();
+            out("xref\n0 " + detail::pdf_number(static_cast<double>(offsets.size())) + "\n0000000000 65535 f \n");
+            for (auto i = std::size_t{1}; i != offsets.size(); ++i)
+                out(padded(offsets[i]) + " 00000 n \n");
+            out("trailer\n<< /Size " + detail::pdf_number(static_cast<double>(offsets.size())) 
+                + " /Root " + reference(catalog_object) + " >>\nstartxref\n" 
+                + detail::pdf_number(static_cast<double>(cross_references)) + "\n%%EOF\n");
+        }
+
+    private:
+        template<class Is_Set>
+        constexpr auto add(qrcode::structure::dimension extend, Is_Set&& is_set)
+        {
+            if (!content)
+                begin_page();
+
+            auto const cell_width = (layout.page_width - 2 * layout.margin) / layout.columns;
+            auto const cell_height = (layout.page_height - 2 * layout.margin) / layout.rows;
+            auto const cell = cell_width < cell_height ? cell_width : cell_height;
+            auto const module = cell / (width(extend) + 2 * layout.quiet_zone);
+
+            auto const column = cells % layout.columns;
+            auto const row = cells / layout.columns;
+            auto const left = layout.margin + column * cell_width + layout.quiet_zone * module;
+            auto const top = layout.page_height - layout.margin - row * cell_height - layout.quiet_zone * module;
+
+            // module coordinates grow downwards from the top left corner of the symbol
+            write("q " + detail::pdf_number(module) + " 0 0 " + detail::pdf_number(-module) + " "
+                + detail::pdf_number(left) + " " + detail::pdf_number(top) + " cm\n");
+            detail::pdf_runs([this](std::string_view text) { write(text); }, extend, is_set);
+            write("Q\n");
+
+            if (++cells == layout.columns * layout.rows)
+                end_page();
+        }
+
+        constexpr auto begin_page()
+        {
+            begin_object(content_object(pages));
+            out("<< /Length " + reference(length_object(pages)) + " /Filter /FlateDecode >>\nstream\n");
+            content_start = out.offset();
+            content.emplace(detail::pdf_byte_sink<Stream>{&out});
+            write("0 g\n");
+        }
+
+        constexpr auto end_page()
+        {
+            content->finish();
+            content.reset();
+            auto const length = out.offset() - content_start;
+            out("\nendstream\nendobj\n");
+
+            begin_object(length_object(pages));
+            out(detail::pdf_number(static_cast<double>(length)) + "\nendobj\n");
+
+            begin_object(page_object(pages));
+            out("<< /Type /Page /Parent " + reference(pages_object) 
+                + " /Contents " + reference(content_object(pages)) + " >>\nendobj\n");
+
+            ++pages;
+            cells = 0;
+        }
+
+        constexpr auto write(std::string_view text)
+        {
+            content->write({reinterpret_cast<std::uint8_t const*>(text.data()), text.size()});
+        }
+
+        constexpr auto begin_object(int number)
+        {
+            if (offsets.size() <= static_cast<std::size_t>(number))
+                offsets.resize(number + 1);
+            offsets[number] = out.offset();
+            out(detail::pdf_number(number) + " 0 obj\n");
+        }
+
+        [[nodiscard]] static constexpr auto page_object(int page) noexcept
+        {
+            return resources_object + 1 + objects_per_page * page;
+        }
+
+        [[nodiscard]] static constexpr auto content_object(int page) noexcept
+        {
+            return page_object(page) + 1;
+        }
+
+        [[nodiscard]] static constexpr auto length_object(int page) noexcept
+        {
+            return page_object(page) + 2;
+        }
+
+        [[nodiscard]] static constexpr auto reference(int number)
+        {
+            return detail::pdf_number(number) + " 0 R";
+        }
+
+        [[nodiscard]] static constexpr auto padded(std::size_t offset)
+        {
+            auto text = std::string(10, '0');
+            for (auto i = 9; offset != 0; --i, offset /= 10)
+                text[i] = static_cast<char>('0' + offset % 10);
+            return text;
+        }
+
+        detail::pdf_output<Stream> out;
+        pdf_layout layout;
+        std::vector<std::size_t> offsets;
+        std::optional<deflater> content;
+        std::size_t content_start = 0;
+        int pages = 0;
+        int cells = 0;
+    };
+
+    // sheets of all given symbols in one document
+    template<class Stream, std::ranges::input_range Symbols>
+    constexpr auto pdf(Stream& stream, Symbols&& symbols, pdf_layout const& layout = pdf_layout{})
+    {
+        auto writer = pdf_writer<Stream>{stream, layout};
+        for (auto const& symbol : symbols)
+            writer.add(symbol);
+        writer.finish();
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#if defined(__cpp_lib_constexpr_string)
+namespace qrcode::detail::test
+{
+    constexpr auto pdf_numbers_have_at_most_three_fractional_digits()
+    {
+        static_assert(pdf_number(0) == "0");
+        static_assert(pdf_number(42) == "42");
+        static_assert(pdf_number(-3) == "-3");
+        static_assert(pdf_number(2.5) == "2.5");
+        static_assert(pdf_number(595.276) == "595.276");
+        static_assert(pdf_number(0.0625) == "0.063");
+        static_assert(pdf_number(-0.05) == "-0.05");
+        static_assert(pdf_number(-0.0001) == "0");
+    }
+
+    constexpr auto pdf_runs_merge_adjacent_dark_modules_of_a_row()
+    {
+        auto f = []
+        {
+            auto text = std::string{};
+            auto const dark = [](int x, int y) { return y == 0 ? x != 2 : x == 3; };
+            pdf_runs([&text](std::string_view s) { text += s; }, dimension{5,2}, dark);
+            return text;
+        };
+        static_assert(f() == "0 0 2 1 re\n3 0 2 1 re\n3 1 1 1 re\nf\n");
+    }
+}
+#endif
+#endif
@@ -0,0 +1,189 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+
+namespace qrcode::pipeline
+{
+    // lock-free ring of D. Vyukov: every cell carries a sequence number which tells producers and
+    // consumers whose turn it is, so neither side takes a lock. Any number of threads may push and pop.
+    // The blocking push and pop spin shortly and then sleep on a counter of the other side.
+    template<class T>
+    class bounded_queue
+    {
+    public:
+        // capacity is rounded up to a power of two
+        explicit bounded_queue(std::size_t capacity)
+        : mask{std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity) - 1}
+        , cells{std::make_unique<cell[]>(mask + 1)}
+        {
+            for (auto i = std::size_t{0}; i != mask + 1; ++i)
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        bounded_queue(bounded_queue const&) = delete;
+        auto operator=(bounded_queue const&) -> bounded_queue& = delete;
+
+        [[nodiscard]] auto try_push(T& value) -> bool
+        {
+            auto position = enqueue_position.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                auto& cell = cells[position & mask];
+                auto const sequence = cell.sequence.load(std::memory_order_acquire);
+                auto const lag = static_cast<std::ptrdiff_t>(sequence - position);
+                if (lag < 0)
+                    return false;
+                if (lag > 0)
+                    position = enqueue_position.load(std::memory_order_relaxed);
+                else if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    signal(pushed, waiting_consumers);
+                    return true;
+                }
+            }
+        }
+
+        [[nodiscard]] auto try_pop() -> std::optional<T>
+        {
+            auto position = dequeue_position.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                auto& cell = cells[position & mask];
+                auto const sequence = cell.sequence.load(std::memory_order_acquire);
+                auto const lag = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+                if (lag < 0)
+                    return std::nullopt;
+                if (lag > 0)
+                    position = dequeue_position.load(std::memory_order_relaxed);
+                else if (dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    auto value = std::move(cell.value);
+                    cell.value.reset();
+                    cell.sequence.store(position + mask + 1, std::memory_order_release);
+                    signal(popped, waiting_producers);
+                    return value;
+                }
+            }
+        }
+
+        // waits while the queue is full, that is the back-pressure on the producer;
+        // false if the queue has been closed
+        auto push(T value) -> bool
+        {
+            for (auto spins = 0; !is_closed.load(std::memory_order_acquire); ++spins)
+            {
+                auto const seen = popped.load();
+                if (try_push(value))
+                    return true;
+                wait_for(popped, seen, waiting_producers, spins);
+            }
+            return false;
+        }
+
+        // waits while the queue is empty; nothing once the queue is closed and drained
+        [[nodiscard]] auto pop() -> std::optional<T>
+        {
+            for (auto spins = 0;; ++spins)
+            {
+                auto const seen = pushed.load();
+                if (auto value = try_pop())
+                    return value;
+                if (is_closed.load(std::memory_order_acquire))
+                    return try_pop();
+                wait_for(pushed, seen, waiting_consumers, spins);
+            }
+        }
+
+        // values pushed before are still popped, every waiting thread wakes up
+        auto close() noexcept
+        {
+            is_closed.store(true, std::memory_order_release);
+            pushed.fetch_add(1);
+            popped.fetch_add(1);
+            pushed.notify_all();
+            popped.notify_all();
+        }
+
+        [[nodiscard]] friend auto capacity(bounded_queue const& queue) noexcept
+        {
+            return queue.mask + 1;
+        }
+
+    private:
+        static constexpr auto spin_limit = 64;
+
+        // The counters are sequentially consistent: a waiter registers before it sleeps and the
+        // other side counts before it checks for waiters, so either the waiter sees the new count
+        // or it is notified. Nobody is notified while no one waits.
+        static auto signal(std::atomic<std::uint32_t>& counter, std::atomic<int> const& waiting) noexcept
+        {
+            counter.fetch_add(1);
+            if (waiting.load() > 0)
+                counter.notify_one();
+        }
+
+        static auto wait_for(
+            std::atomic<std::uint32_t>& counter, std::uint32_t seen, std::atomic<int>& waiting, int spins) noexcept
+        {
+            if (spins < spin_limit)
+            {
+                std::this_thread::yield();
+                return;
+            }
+            waiting.fetch_add(1);
+            counter.wait(seen);
+            waiting.fetch_sub(1);
+        }
+
+        struct cell
+        {
+            std::atomic<std::size_t> sequence{0};
+            std::optional<T> value{};
+        };
+
+        std::size_t mask;
+        std::unique_ptr<cell[]> cells;
+
+        // producers and consumers should not share a cache line
+        alignas(64) std::atomic<std::size_t> enqueue_position{0};
+        alignas(64) std::atomic<std::size_t> dequeue_position{0};
+        alignas(64) std::atomic<bool> is_closed{false};
+
+        // counts of pushed and popped values to sleep on, each next to the waiters of its side
+        alignas(64) std::atomic<std::uint32_t> pushed{0};
+        std::atomic<int> waiting_consumers{0};
+        alignas(64) std::atomic<std::uint32_t> popped{0};
+        std::atomic<int> waiting_producers{0};
+    };
+}
@@ -0,0 +1,143 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+namespace qrcode::pipeline
+{
+    // a symbol keeps all of its modules, codewords and mask candidates on the stack, a large version
+    // needs about 2 MB. Secondary threads get 512 KB on darwin and 1 MB on windows by default.
+    inline constexpr auto default_stack_size = std::size_t{8} << 20;
+
+    // joining thread with a stack of given size. Posix systems create it with pthreads, elsewhere it is
+    // a std::thread and the stack size of the executable applies (e.g. /STACK:8388608 with msvc).
+    class worker_thread
+    {
+    public:
+        worker_thread() noexcept = default;
+
+        template<class Function>
+        requires std::is_invocable_v<std::decay_t<Function>&>
+        explicit worker_thread(Function&& function, std::size_t stack_size = default_stack_size)
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            using function_type = std::decay_t<Function>;
+            auto attributes = pthread_attr_t{};
+            if (auto const error = pthread_attr_init(&attributes); error != 0)
+                throw std::system_error{error, std::generic_category(), "pthread_attr_init"};
+
+            auto task = std::make_unique<function_type>(std::forward<Function>(function));
+            auto error = pthread_attr_setstacksize(&attributes, stack_size);
+            if (error == 0)
+                error = pthread_create(&handle, &attributes, &start<function_type>, task.get());
+            pthread_attr_destroy(&attributes);
+            if (error != 0)
+                throw std::system_error{error, std::generic_category(), "pthread_create"};
+
+            task.release();
+            joinable = true;
+#else
+            static_cast<void>(stack_size);
+            thread = std::thread{std::forward<Function>(function)};
+#endif
+        }
+
+        worker_thread(worker_thread&& other) noexcept
+        {
+            swap(other);
+        }
+
+        auto operator=(worker_thread&& other) noexcept -> worker_thread&
+        {
+            if (this != &other)
+            {
+                join();
+                swap(other);
+            }
+            return *this;
+        }
+
+        ~worker_thread()
+        {
+            join();
+        }
+
+        auto join() noexcept -> void
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            if (std::exchange(joinable, false))
+                pthread_join(handle, nullptr);
+#else
+            if (thread.joinable())
+                thread.join();
+#endif
+        }
+
+        [[nodiscard]] auto native_handle() noexcept
+        {
+#if defined(__unix__) || defined(__APPLE__)
+            return handle;
+#else
+            return thread.native_handle();
+#endif
+        }
+
+    private:
+#if defined(__unix__) || defined(__APPLE__)
+        template<class Function>
+        static auto start(void* task) -> void*
+        {
+            // an exception leaving the worker terminates the program, just as with std::thread
+            [&]() noexcept { (*std::unique_ptr<Function>{static_cast<Function*>(task)})(); }();
+            return nullptr;
+        }
+
+        auto swap(worker_thread& other) noexcept -> void
+        {
+            std::swap(handle, other.handle);
+            std::swap(joinable, other.joinable);
+        }
+
+        pthread_t handle{};
+        bool joinable = false;
+#else
+        auto swap(worker_thread& other) noexcept -> void
+        {
+            thread.swap(other.thread);
+        }
+
+        std::thread thread{};
+#endif
+    };
+}
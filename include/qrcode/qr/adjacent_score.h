@@ -23,11 +23,13 @@
  */
 #pragma once
 
+#include <limits>
 #include <ranges>
+#include <span>
 
 #include <qrcode/qr/penalty_weight.h>
-#include <qrcode/structure/element_view.h>
-#include <qrcode/structure/horizontal_view.h>
+#include <qrcode/qr/static_segments.h>
+#include <qrcode/structure/matrix.h>
 #include <qrcode/structure/module_traits.h>
 
 namespace qrcode::qr::detail
@@ -35,62 +37,153 @@ namespace qrcode::qr::detail
     using qrcode::structure::position;
     using qrcode::structure::matrix;
 
-    template<std::ranges::viewable_range Range>
-    [[nodiscard]] constexpr auto adjacent_score(Range&& line)
+    [[nodiscard]] constexpr auto run_score(int length) noexcept
     {
-        using std::ranges::empty;
-        using std::ranges::begin;
-        using std::ranges::end;
+        return length < 5 ? 0 : penalty_weight(1) + length - 5;
+    }
 
-        if (empty(line))
-            return 0;
+    // the run of the line scanned so far, a static segment is passed by its leading and trailing
+    // runs; the runs in between are the same for every mask and not counted here
+    class adjacent_run
+    {
+    public:
+        constexpr auto push(bool set) noexcept
+        {
+            count = count != 0 && set == color ? count + 1 : 1;
+            color = set;
 
-        auto previous = *begin(line);
-        auto next = begin(line); 
-        ++next;
+            if (count == 5)
+                line_score += penalty_weight(1);
 
-        auto count = 1;
-        auto score = 0;
+            if (count > 5)
+                ++line_score;
+        }
+
+        constexpr auto skip(static_segment const& segment) noexcept
+        {
+            if (count != 0 && first_module(segment) == color)
+            {
+                line_score += run_score(count + segment.leading) - run_score(count);
+                count += segment.leading;
+            }
+            else
+            {
+                line_score += run_score(segment.leading);
+                count = segment.leading;
+                color = first_module(segment);
+            }
+
+            if (segment.leading != length(segment))
+            {
+                line_score += run_score(segment.trailing);
+                count = segment.trailing;
+                color = last_module(segment);
+            }
+        }
+
+        [[nodiscard]] constexpr auto score() const noexcept
+        {
+            return line_score;
+        }
+
+    private:
+        bool color = false;
+        int count = 0;
+        int line_score = 0;
+    };
+
+    // penalty of the runs between the leading and the trailing run of given segment
+    [[nodiscard]] constexpr auto inner_run_score(static_segment const& segment) noexcept
+    {
+        auto run = adjacent_run{};
+        for (auto i = segment.leading; i < length(segment) - segment.trailing; ++i)
+            run.push(((segment.bits >> (length(segment) - 1 - i)) & 1) != 0);
+        return run.score();
+    }
 
+    template<std::ranges::viewable_range Range>
+    [[nodiscard]] constexpr auto adjacent_score(Range&& line)
+    {
         using qrcode::structure::module_traits;
         using value_type = std::ranges::range_value_t<Range>;
         auto is_set = module_traits<value_type>::is_set;
 
-        for (auto i : std::ranges::subrange{next, end(line)})
-        {
-            count = is_set(i) == is_set(previous) ? count + 1 : 1;
-            previous = i;
+        auto run = adjacent_run{};
+        for (auto i : line)
+            run.push(is_set(i));
+        return run.score();
+    }
 
-            if (count == 5)
-                score += penalty_weight(1);
+    template<std::ranges::random_access_range Range>
+    [[nodiscard]] constexpr auto adjacent_score(Range&& line, std::span<static_segment const> segments)
+    {
+        using qrcode::structure::module_traits;
+        using value_type = std::ranges::range_value_t<Range>;
+        auto is_set = module_traits<value_type>::is_set;
 
-            if (count > 5)
-                ++score;
+        auto const modules = std::ranges::begin(line);
+        auto const line_length = static_cast<int>(std::ranges::size(line));
+
+        auto run = adjacent_run{};
+        auto i = 0;
+        for (auto const& segment : segments)
+        {
+            for (; i != segment.begin; ++i)
+                run.push(is_set(modules[i]));
+            run.skip(segment);
+            i = segment.end;
+        }
+        for (; i != line_length; ++i)
+            run.push(is_set(modules[i]));
+        return run.score();
+    }
+    
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto horizontal_adjacent_score(
+        matrix<T, Capacity> const& modules, int budget = std::numeric_limits<int>::max())
+    {
+        auto score = 0;
+        for (auto y = 0; y != height(modules) && score < budget; ++y)
+        {
+            score += adjacent_score(row(modules, y));
         }
+        return score;
+    }
 
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto vertical_adjacent_score(
+        matrix<T, Capacity> const& modules, int budget = std::numeric_limits<int>::max())
+    {
+        auto score = 0;
+        for (auto x = 0; x != width(modules) && score < budget; ++x)
+        {
+            score += adjacent_score(column(modules, x));
+        }
         return score;
     }
-    
-    template<class T>
-    [[nodiscard]] constexpr auto horizontal_adjacent_score(matrix<T> const& modules)
+
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto horizontal_adjacent_score(
+        matrix<T, Capacity> const& modules, static_segments const& segments, int budget)
     {
         auto score = 0;
-        for (auto y = 0; y != height(modules); ++y)
+        for (auto y = 0; y != height(modules) && score < budget; ++y)
         {
-            auto range = views::horizontal({0,y}, {width(modules),1}) | views::element(modules);
-            score += adjacent_score(range);
+            if (!is_fixed_row(segments, y))
+                score += adjacent_score(row(modules, y), row_segments(segments, y));
         }
         return score;
     }
 
-    template<class T>
-    [[nodiscard]] constexpr auto vertical_adjacent_score(matrix<T> const& modules)
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto vertical_adjacent_score(
+        matrix<T, Capacity> const& modules, static_segments const& segments, int budget)
     {
         auto score = 0;
-        for (auto x = 0; x != width(modules); ++x)
+        for (auto x = 0; x != width(modules) && score < budget; ++x)
         {
-            auto range = views::horizontal({x,0}, {1,height(modules)}) | views::element(modules);
-            score += adjacent_score(range);
+            if (!is_fixed_column(segments, x))
+                score += adjacent_score(column(modules, x), column_segments(segments, x));
         }
         return score;
     }
@@ -100,12 +193,56 @@ namespace qrcode::qr
 {
     using qrcode::structure::matrix;
 
-    template<class T>
-    [[nodiscard]] constexpr auto adjacent_score(matrix<T> const& modules)
+    // scoring stops as soon as the partial score reaches the given budget,
+    // i.e. the result is exact only if it is below the budget
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto adjacent_score(
+        matrix<T, Capacity> const& modules, int budget = std::numeric_limits<int>::max())
+    {
+        using qrcode::qr::detail::horizontal_adjacent_score;
+        using qrcode::qr::detail::vertical_adjacent_score;
+        auto const score = horizontal_adjacent_score(modules, budget);
+        return score + vertical_adjacent_score(modules, budget - score);
+    }
+
+    // penalty of the runs which do not change with the mask: all runs of lines without data modules
+    // and the runs inside of static segments, apart from the runs a segment begins and ends with
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto static_adjacent_score(
+        matrix<T, Capacity> const& code, static_segments const& segments) noexcept
+    {
+        using qrcode::qr::detail::adjacent_score;
+        using qrcode::qr::detail::inner_run_score;
+
+        auto score = 0;
+        for (auto y = 0; y != height(code); ++y)
+        {
+            if (is_fixed_row(segments, y))
+                score += adjacent_score(row(code, y));
+            for (auto const& segment : row_segments(segments, y))
+                score += inner_run_score(segment);
+        }
+        for (auto x = 0; x != width(code); ++x)
+        {
+            if (is_fixed_column(segments, x))
+                score += adjacent_score(column(code, x));
+            for (auto const& segment : column_segments(segments, x))
+                score += inner_run_score(segment);
+        }
+        return score;
+    }
+
+    // same as above, but only the lines with data modules are scanned and the static segments are
+    // passed by their boundary runs; adding the static adjacent score of the code gives the full score
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto adjacent_score(
+        matrix<T, Capacity> const& modules, static_segments const& segments, 
+        int budget = std::numeric_limits<int>::max())
     {
         using qrcode::qr::detail::horizontal_adjacent_score;
         using qrcode::qr::detail::vertical_adjacent_score;
-        return horizontal_adjacent_score(modules) + vertical_adjacent_score(modules);
+        auto const score = horizontal_adjacent_score(modules, segments, budget);
+        return score + vertical_adjacent_score(modules, segments, budget - score);
     }
 }   
 
@@ -207,5 +344,23 @@ namespace qrcode::qr::test
             1,1,0,0,0,1
         })) == (penalty_weight(1)+1+penalty_weight(1)));
     }
+
+    constexpr auto adjacent_score_stops_as_soon_as_the_given_budget_has_been_reached()
+    {
+        using qrcode::structure::make_matrix;
+        constexpr auto some_modules = make_matrix<int>({6,6}, std::array{
+            1,1,1,1,1,0,
+            1,1,1,1,1,1,
+            0,1,0,1,0,1,
+            0,1,0,0,0,0,
+            0,1,1,0,1,0,
+            1,1,0,0,0,1
+        });
+
+        static_assert(adjacent_score(some_modules) == (3*penalty_weight(1)+2));
+        static_assert(adjacent_score(some_modules, 100) == (3*penalty_weight(1)+2));
+        static_assert(adjacent_score(some_modules, 1) == penalty_weight(1));
+        static_assert(adjacent_score(some_modules, penalty_weight(1)+1) == (2*penalty_weight(1)+1));
+    }
 }
 #endif
\ No newline at end of file
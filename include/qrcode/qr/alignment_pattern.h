@@ -111,8 +111,8 @@ namespace qrcode::qr::detail
             return extend;
         }
 
-        template<class T>
-        [[nodiscard]] constexpr auto place(matrix<T>& matrix, position top_left) const noexcept
+        template<class T, int Capacity>
+        [[nodiscard]] constexpr auto place(matrix<T, Capacity>& matrix, position top_left) const noexcept
         {
             constexpr auto pattern = std::array<bool,width(extend)*height(extend)>{
                 1,1,1,1,1,
@@ -134,8 +134,8 @@ namespace qrcode::qr
 {
     using qrcode::structure::matrix;
 
-    template<class T>
-    [[nodiscard]] constexpr auto place_alignment_patterns(matrix<T>& matrix)
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto place_alignment_patterns(matrix<T, Capacity>& matrix)
     {
         using qrcode::qr::detail::alignment_pattern;
         using qrcode::qr::detail::alignment_positions;
@@ -26,6 +26,8 @@
 #include <ranges>
 #include <concepts>
 
+#include <cx/vector.h>
+
 #include <qrcode/code/bit_view.h>
 #include <qrcode/code/byte_view.h>
 #include <qrcode/code/code_capacity.h>
@@ -36,6 +38,8 @@
 #include <qrcode/code/sequence_description.h>
 #include <qrcode/code/sequence_view.h>
 
+#include <qrcode/trace/tracer.h>
+
 namespace qrcode::qr::detail
 {
     [[nodiscard]] constexpr auto data_padding()
@@ -64,7 +68,8 @@ namespace qrcode::qr
 {
     using qrcode::code::code_capacity;
 
-    template<std::ranges::range Range>
+    // the codewords of the symbol are buffered once, symbols of a known version may bound them
+    template<int Codewords = cx::default_capacity, std::ranges::range Range>
     requires std::convertible_to<std::ranges::range_value_t<Range>, bool>
     [[nodiscard]] constexpr auto code_bits(
         Range&& data_bits, code_capacity const& capacity) noexcept
@@ -93,10 +98,28 @@ namespace qrcode::qr
             | as_gf2p8
             | views::polynomial(polynomial_info)
             | views::codeword(error_correction_polynomial(error_degree(capacity)))
-            | views::sequence(description)
+            | views::sequence<Codewords>(description)
             | as_byte
             | views::bit;
     }
+
+    // the traced variant evaluates the lazy view right away, so the stage can be timed on its own
+    template<std::ranges::range Range, trace::Tracer Tracer>
+    requires std::convertible_to<std::ranges::range_value_t<Range>, bool>
+    [[nodiscard]] constexpr auto code_bits(
+        Range&& data_bits, code_capacity const& capacity, Tracer&& tracer) noexcept
+    {
+        using qrcode::trace::stage;
+        using qrcode::trace::detail::begin_stage;
+        using qrcode::trace::detail::end_stage;
+
+        begin_stage(tracer, stage::code_bits);
+        auto bits = cx::vector<bool>{};
+        for (auto bit : code_bits(std::forward<Range>(data_bits), capacity))
+            bits.push_back(bit);
+        end_stage(tracer, stage::code_bits, static_cast<int>(bits.size()));
+        return bits;
+    }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
@@ -182,6 +205,10 @@ namespace qrcode::qr
                 0,1,0,1,0,1,0,1
             }
         ));
+        static_assert(std::ranges::equal(
+            code_bits(any_data, any_capacity, trace::null_tracer{}),
+            code_bits(any_data, any_capacity)
+        ));
     }
 }
 #endif
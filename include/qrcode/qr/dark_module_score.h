@@ -23,62 +23,88 @@
  */
 #pragma once
 
+#include <bit>
+#include <limits>
 #include <numeric>
 #include <ranges>
 
 #include <qrcode/qr/penalty_weight.h>
 
+#include <qrcode/structure/mask_plane.h>
 #include <qrcode/structure/matrix.h>
-#include <qrcode/structure/element_view.h>
-#include <qrcode/structure/horizontal_view.h>
 #include <qrcode/structure/module_traits.h>
 
 namespace qrcode::qr::detail
 {
     using qrcode::structure::matrix;
 
-    template<class T>
+    template<class T, int Capacity>
     requires std::convertible_to<T, bool>
-    [[nodiscard]] constexpr auto dark_module_count(matrix<T> const& matrix) noexcept
+    [[nodiscard]] constexpr auto dark_module_count(matrix<T, Capacity> const& matrix) noexcept
     {
         using qrcode::structure::module_traits;
 
-        auto range = 
-            views::horizontal({0,0}, size(matrix)) 
-            | views::element(matrix) 
-            | std::views::transform([](auto v){ return module_traits<T>::is_set(v); });
-
         auto sum = 0;
-        std::ranges::for_each(range, [&sum](auto i) { sum += i; });
+        for (auto y = 0; y != height(matrix); ++y)
+            for (auto const& module : row(matrix, y))
+                sum += module_traits<T>::is_set(module) ? 1 : 0;
         return sum;
     }
 
+    // every module under the mask changes its color, so the dark modules of the masked matrix
+    // follow from the ones of the unmasked matrix without masking it
+    template<class T, int Capacity, int Max_Size>
+    [[nodiscard]] constexpr auto masked_dark_module_count(
+        matrix<T, Capacity> const& matrix, int dark_count, 
+        qrcode::structure::mask_plane<Max_Size> const& mask) noexcept
+    {
+        using qrcode::structure::module_traits;
+
+        auto flipped = 0;
+        auto flipped_dark = 0;
+        for (auto y = 0; y != height(matrix); ++y)
+        {
+            auto x = 0;
+            for (auto bits : row(mask, y))
+            {
+                flipped += std::popcount(bits);
+                for (; bits != 0; bits &= bits - 1)
+                    if (module_traits<T>::is_set(element_at(matrix, {x + std::countr_zero(bits), y})))
+                        ++flipped_dark;
+                x += std::numeric_limits<decltype(bits)>::digits;
+            }
+        }
+        return dark_count + flipped - 2 * flipped_dark;
+    }
+
     [[nodiscard]] constexpr auto nearest_five_percentage_step(float proportion) noexcept
     {
         auto abs = [](auto value){ return value >= 0.f ? value : -value; }; // constexpr abs
         return static_cast<int>(abs(50.f-proportion) / 5.f);
     }
+
+    [[nodiscard]] constexpr auto dark_module_score(int dark_count, int total) noexcept
+    {
+        auto const proportion = 100.f * dark_count / total;
+        return nearest_five_percentage_step(proportion) * penalty_weight(4);
+    }
 }   
 
 namespace qrcode::qr
 {
     using qrcode::structure::matrix;
 
-    template<class T>
-    [[nodiscard]] constexpr auto dark_module_score(matrix<T> const& modules)
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto dark_module_score(matrix<T, Capacity> const& modules)
     {
         using qrcode::qr::detail::dark_module_count;
-        using qrcode::qr::detail::nearest_five_percentage_step;
 
-        auto const total = width(modules) * height(modules);
-        auto const count = dark_module_count(modules);
-        auto const proportion = 100.f * count / total;
-        
-        return nearest_five_percentage_step(proportion) * penalty_weight(4);
+        return detail::dark_module_score(dark_module_count(modules), width(modules) * height(modules));
     }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
 #include <qrcode/structure/make_matrix.h>
 
 namespace qrcode::qr::detail::test
@@ -112,6 +138,24 @@ namespace qrcode::qr::detail::test
         static_assert(nearest_five_percentage_step(72.f) == 4);
         static_assert(nearest_five_percentage_step(79.f) == 5);
     }
+
+    constexpr auto masked_dark_module_count_equals_the_dark_modules_of_the_masked_matrix()
+    {
+        using namespace std::literals;
+        using qrcode::structure::make_matrix;
+        using plane = qrcode::structure::mask_plane<7>;
+
+        constexpr auto any_matrix = make_matrix<char>({7,3}, 
+            "*-,+,,+"
+            "+,-*++,"
+            ",++,-*+"sv
+        );
+        constexpr auto any_mask = [](int i, int j) { return (i + j) % 2 == 0; };
+        constexpr auto any_plane = plane{plane{any_matrix}, any_mask};
+
+        static_assert(masked_dark_module_count(any_matrix, dark_module_count(any_matrix), any_plane) 
+            == dark_module_count(any_plane(any_matrix)));
+    }
 }
 
 namespace qrcode::qr::test
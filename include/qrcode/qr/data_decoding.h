@@ -0,0 +1,190 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <optional>
+
+#include <cx/vector.h>
+
+#include <qrcode/qr/encoders.h>
+#include <qrcode/qr/version_category.h>
+
+#include <qrcode/data/bit_reader.h>
+#include <qrcode/data/segment_decoding.h>
+#include <qrcode/eci/assignment_number.h>
+
+namespace qrcode::qr
+{
+    using qrcode::data::decoded_data;
+
+    [[nodiscard]] constexpr auto decode_data(
+        cx::vector<bool> const& bits, version_category category) noexcept
+    {
+        using qrcode::data::bit_reader;
+        using qrcode::data::decode_segment;
+        using qrcode::data::decode_structured_append;
+        using qrcode::eci::decode_assignment_number;
+        using namespace qrcode::data::literals;
+        using result_type = std::optional<decoded_data>;
+
+        constexpr auto mode_size = 4_bits;
+        constexpr auto terminator = 0b0000;
+        constexpr auto eci_mode = 0b0111;
+        constexpr auto structured_append_mode = 0b0011;
+        auto const encoders = available_encoders(category);
+
+        auto reader = bit_reader{bits};
+        auto data = decoded_data{};
+
+        // a terminator may be truncated if the symbol capacity is exhausted
+        while (reader.remaining() >= mode_size.value)
+        {
+            auto const indicator = *reader.read(mode_size);
+            if (indicator == terminator)
+                break;
+
+            auto valid = false;
+            if (indicator == eci_mode)
+            {
+                data.eci_assignment_number = decode_assignment_number(reader);
+                valid = data.eci_assignment_number.has_value();
+            }
+            else if (indicator == structured_append_mode)
+            {
+                data.structured_append_header = decode_structured_append(reader);
+                valid = data.structured_append_header.has_value();
+            }
+            else
+                valid = decode_segment(reader, encoders, indicator, data);
+
+            if (!valid)
+                return result_type{};
+        }
+        return result_type{std::move(data)};
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
+#include <qrcode/qr/data_encoding.h>
+
+namespace qrcode::qr::test
+{
+    constexpr auto decode_data_restores_the_message_of_encoded_data()
+    {
+        auto f = [](auto message, auto category)
+        {
+            auto const bits = encode_data(message, category).get();
+            auto const data = decode_data(bits, category);
+            return data 
+                && !data->eci_assignment_number 
+                && std::ranges::equal(data->message, message);
+        };
+
+        using namespace std::literals;
+        static_assert(f("01234567"sv, version_category::small));
+        static_assert(f("ABRACADABRA"sv, version_category::medium));
+        static_assert(f("Hello, world! 123456789012345"sv, version_category::large));
+        static_assert(f("\x93\x5F\xE4\xAA" "ABC"sv, version_category::small));
+    }
+
+    constexpr auto decode_data_records_the_mode_and_size_of_every_segment()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            using qrcode::data::optimizer::mode;
+            auto const bits = encode_data("0123456789012345ABCDEFGHIJKLMNOPabc"sv, version_category::small).get();
+            auto const data = decode_data(bits, version_category::small);
+            return data 
+                && data->segments.size() == 3
+                && data->segments[0].mode == mode::numeric && data->segments[0].size == 16
+                && data->segments[1].mode == mode::alphanumeric && data->segments[1].size == 16
+                && data->segments[2].mode == mode::byte && data->segments[2].size == 3;
+        };
+        static_assert(f());
+    }
+
+    constexpr auto decode_data_restores_the_eci_header_of_encoded_data()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            using qrcode::eci::assignment_number;
+            auto const any_message = eci::view{assignment_number{26}, "\xC3\xA4pfel"sv};
+
+            auto const bits = encode_data(any_message, version_category::small).get();
+            auto const data = decode_data(bits, version_category::small);
+            return data 
+                && data->eci_assignment_number 
+                && data->eci_assignment_number->value == 26
+                && std::ranges::equal(data->message, "\xC3\xA4pfel"sv);
+        };
+        static_assert(f());
+    }
+
+    constexpr auto decode_data_restores_the_structured_append_header_of_encoded_data()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            using qrcode::data::structured_append;
+            constexpr auto any_header = structured_append{.position = 1, .symbol_count = 3, .parity = 0x5A};
+
+            auto const bits = encode_data("ABC"sv, version_category::small, any_header).get();
+            auto const data = decode_data(bits, version_category::small);
+            return data 
+                && data->structured_append_header == any_header
+                && std::ranges::equal(data->message, "ABC"sv);
+        };
+        static_assert(f());
+    }
+
+    constexpr auto decode_data_stops_at_the_terminator()
+    {
+        auto f = []
+        {
+            using namespace qrcode::data::literals;
+            auto const bits = qrcode::data::bit_stream{}
+                .add(0b0001, 4_bits).add(1, 10_bits).add(7, 4_bits)
+                .add(0b0000, 4_bits).add(0b1110'1100, 8_bits).get();
+
+            auto const data = decode_data(bits, version_category::small);
+            return data && std::ranges::equal(data->message, std::array{'7'});
+        };
+        static_assert(f());
+    }
+
+    constexpr auto decode_data_rejects_unknown_modes()
+    {
+        auto f = []
+        {
+            using namespace qrcode::data::literals;
+            auto const bits = qrcode::data::bit_stream{}.add(0b1111, 4_bits).add(0, 12_bits).get();
+            return !decode_data(bits, version_category::small);
+        };
+        static_assert(f());
+    }
+}
+#endif
@@ -27,6 +27,7 @@
 #include <concepts>
 #include <qrcode/qr/version_category.h>
 #include <qrcode/qr/optimized_data_encoding.h>
+#include <qrcode/data/structured_append.h>
 #include <qrcode/eci/view.h>
 
 namespace qrcode::qr
@@ -45,10 +46,47 @@ namespace qrcode::qr
 
         return stream;
     }
+
+    using qrcode::data::structured_append;
+
+    // the structured append header precedes all other segments of a symbol
+    template<std::ranges::forward_range Message>
+    requires std::convertible_to<std::ranges::range_value_t<Message>, char>
+    [[nodiscard]] constexpr auto encode_data(
+        Message&& message, version_category category, structured_append const& sequence)
+    {
+        auto stream = bit_stream{};
+
+        encode(stream, sequence);
+        if constexpr (is_eci_view_v<std::decay_t<Message>>)
+            encode(stream, header(message));
+        optimized_encode_data(stream, message, category);
+
+        return stream;
+    }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
+
 namespace qrcode::qr::test
 {
+    constexpr auto encode_data_puts_the_structured_append_header_in_front_of_the_data()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            auto const any_sequence = structured_append{.position = 0, .symbol_count = 2, .parity = 0x01};
+
+            auto const bits = encode_data("123"sv, version_category::small, any_sequence).get();
+            return std::ranges::equal(
+                bits | std::views::take(20), 
+                std::array<bool,20>{0,0,1,1, 0,0,0,0, 0,0,0,1, 0,0,0,0,0,0,0,1})
+                && std::ranges::equal(
+                    bits | std::views::drop(20), 
+                    encode_data("123"sv, version_category::small).get());
+        };
+        static_assert(f());
+    }
 }
 #endif
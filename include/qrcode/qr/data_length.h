@@ -27,6 +27,7 @@
 #include <concepts>
 #include <qrcode/qr/version_category.h>
 #include <qrcode/qr/optimized_data_length.h>
+#include <qrcode/data/structured_append.h>
 #include <qrcode/eci/view.h>
 
 namespace qrcode::qr
@@ -42,10 +43,29 @@ namespace qrcode::qr
             
         return length;
     }
+
+    using qrcode::data::structured_append;
+
+    template<std::ranges::forward_range Message>
+    requires std::convertible_to<std::ranges::range_value_t<Message>, char>
+    [[nodiscard]] constexpr auto data_length(
+        Message&& message, version_category category, structured_append const& sequence)
+    {
+        return bit_count(sequence) + data_length(std::forward<Message>(message), category);
+    }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
+
 namespace qrcode::qr::test
 {
+    constexpr auto data_length_includes_the_structured_append_header()
+    {
+        using namespace std::literals;
+
+        static_assert(data_length("123"sv, version_category::small, structured_append{}) 
+            == 20 + data_length("123"sv, version_category::small));
+    }
 }
 #endif
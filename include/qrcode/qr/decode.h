@@ -0,0 +1,255 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <cx/vector.h>
+
+#include <qrcode/decoded_symbol.h>
+
+#include <qrcode/qr/code_capacity.h>
+#include <qrcode/qr/data_decoding.h>
+#include <qrcode/qr/format_information.h>
+#include <qrcode/qr/mask_pattern.h>
+#include <qrcode/qr/raw_code.h>
+#include <qrcode/qr/symbol_designator.h>
+#include <qrcode/qr/version_category.h>
+#include <qrcode/qr/version_information.h>
+
+#include <qrcode/code/bit_view.h>
+#include <qrcode/code/byte_view.h>
+#include <qrcode/code/error_correction_decoder.h>
+#include <qrcode/code/sequence_description.h>
+
+#include <qrcode/structure/mask_plane.h>
+#include <qrcode/structure/matrix.h>
+#include <qrcode/structure/position.h>
+#include <qrcode/structure/read_data.h>
+
+namespace qrcode::qr::detail
+{
+    using qrcode::structure::position;
+
+    struct placement
+    {
+        std::vector<position> positions{};
+        mask_planes masks{};
+    };
+
+    [[nodiscard]] constexpr auto make_placement(symbol_version version) noexcept
+    {
+        using qrcode::structure::make_placement_map;
+        using qrcode::structure::make_mask_planes;
+
+        auto const layout = make_function_layout<char>(version);
+        auto const data_region = mask_plane{make_raw_code(layout, std::array<bool,0>{})};
+        return placement{make_placement_map(layout), make_mask_planes(data_region, mask_patterns())};
+    }
+
+    struct cached_placement_entry
+    {
+        std::span<position const> positions;
+        mask_planes const& masks;
+    };
+
+    // placement and masks only depend on the symbol version, they are shared by all symbols; the
+    // positions are sized by the data modules of the version and the masks are the planes of the encoder
+    [[nodiscard]] inline auto cached_placement(symbol_version version) -> cached_placement_entry
+    {
+        using qrcode::structure::make_placement_map;
+
+        constexpr auto version_count = 40;
+
+        static auto positions = std::array<std::vector<position>, version_count>{};
+        static auto masks = std::array<mask_planes const*, version_count>{};
+        static auto initialized = std::array<std::once_flag, version_count>{};
+
+        auto const index = version.number - 1;
+        std::call_once(initialized[index], [&]
+        { 
+            auto const layout = make_function_layout<char>(version);
+            positions[index] = make_placement_map(layout); 
+            masks[index] = &cached_mask_planes(version, make_raw_code(layout, std::array<bool,0>{}));
+        });
+        return cached_placement_entry{positions[index], *masks[index]};
+    }
+
+    [[nodiscard]] constexpr auto symbol_version_of(dimension symbol_size) noexcept
+    {
+        auto const number = (width(symbol_size) - 17) / 4;
+        auto const version = symbol_version{number};
+        return number >= 1 && number <= 40 && size(version) == symbol_size 
+            ? std::optional{version} : std::nullopt;
+    }
+
+    inline constexpr auto max_codeword_count = 
+        total_bits(make_code_capacity({symbol_version{40}, error_correction::level_L})) / qrcode::code::bits_per_codeword();
+
+    template<class Module>
+    [[nodiscard]] constexpr auto decode(
+        matrix<Module> const& code, symbol_version version, 
+        std::span<position const> positions, mask_planes const& masks) noexcept
+    {
+        using qrcode::structure::read_codewords;
+        using qrcode::code::make_sequence_description;
+        using qrcode::code::correct_sequence;
+        using qrcode::code::total_codewords;
+        using result_type = std::optional<decoded_symbol<symbol_designator>>;
+
+        auto const format = read_format_information(code);
+        if (!format)
+            return result_type{};
+
+        auto const designator = symbol_designator{version, format->first};
+        auto const data_mask = format->second;
+        auto const description = make_sequence_description(make_code_capacity(designator));
+
+        // remainder bits do not belong to any codeword
+        auto const codewords = read_codewords<max_codeword_count>(
+            positions, code, masks[data_mask], total_codewords(description));
+
+        auto const corrected = correct_sequence(description, codewords);
+        if (!corrected)
+            return result_type{};
+
+        auto bits = cx::vector<bool>{};
+        for (auto i : corrected->data | views::bit)
+            bits.push_back(i);
+
+        auto data = decode_data(bits, make_version_category(version));
+        if (!data)
+            return result_type{};
+
+        return result_type{decoded_symbol<symbol_designator>{
+            designator, data_mask, corrected->error_count, std::move(*data)}};
+    }
+}
+
+namespace qrcode::qr
+{
+    template<class Module>
+    [[nodiscard]] constexpr auto decode(matrix<Module> const& code) noexcept
+    {
+        using qrcode::qr::detail::symbol_version_of;
+        using qrcode::qr::detail::make_placement;
+        using qrcode::qr::detail::cached_placement;
+        using result_type = std::optional<decoded_symbol<symbol_designator>>;
+
+        auto const version = symbol_version_of(size(code));
+        if (!version)
+            return result_type{};
+
+        // the version information is only a cross check, the size already determines the version
+        if (version->number >= 7)
+            if (auto const information = read_version_information(code); information && information != version)
+                return result_type{};
+
+        if (std::is_constant_evaluated())
+        {
+            auto const placement = make_placement(*version);
+            return detail::decode(code, *version, placement.positions, placement.masks);
+        }
+        auto const placement = cached_placement(*version);
+        return detail::decode(code, *version, placement.positions, placement.masks);
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
+#include <qrcode/qr/qr.h>
+
+namespace qrcode::qr::detail::test
+{
+    constexpr auto symbol_version_of_returns_the_version_of_given_symbol_size()
+    {
+        static_assert(symbol_version_of({21,21}) == symbol_version{1});
+        static_assert(symbol_version_of({177,177}) == symbol_version{40});
+        static_assert(!symbol_version_of({22,22}));
+        static_assert(!symbol_version_of({21,25}));
+        static_assert(!symbol_version_of({181,181}));
+    }
+}
+
+namespace qrcode::qr::test
+{
+    constexpr auto decode_restores_message_and_designator_of_generated_qr_symbols()
+    {
+        auto f = [](auto message, auto version, auto error_level)
+        {
+            auto const s = make_symbol<char>(message, symbol_version{version}, error_level).value();
+            auto const decoded = decode(modules(s));
+            return decoded 
+                && decoded->designator == designator(s)
+                && decoded->mask_pattern == mask_pattern(s)
+                && decoded->error_count == 0
+                && std::ranges::equal(decoded->data.message, message);
+        };
+
+        using namespace std::literals;
+        static_assert(f("01234567"sv, 1, error_correction::level_M));
+        static_assert(f("ABRACADABRA"sv, 2, error_correction::level_H));
+        static_assert(f("Hello, world! 123"sv, 7, error_correction::level_Q));
+    }
+
+    constexpr auto decode_corrects_damaged_qr_symbols()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            constexpr auto any_message = "ABRACADABRA"sv;
+            auto const s = make_symbol<char>(any_message, symbol_version{1}, error_correction::level_M).value();
+
+            auto damaged = modules(s);
+            for (auto i : {position{20,20}, position{10,12}, position{12,18}})
+            {
+                auto& module = element_at(damaged, i);
+                module = module == '+' ? ',' : '+';
+            }
+
+            auto const decoded = decode(damaged);
+            return decoded 
+                && decoded->error_count > 0 
+                && std::ranges::equal(decoded->data.message, any_message);
+        };
+        static_assert(f());
+    }
+
+    constexpr auto decode_rejects_matrices_which_are_no_qr_symbols()
+    {
+        auto f = []
+        {
+            return !decode(matrix<char>{{21,21}, '-'}) && !decode(matrix<char>{{22,22}, '-'});
+        };
+        static_assert(f());
+    }
+}
+#endif
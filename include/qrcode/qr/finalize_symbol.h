@@ -23,36 +23,96 @@
  */
 #pragma once
 
+#include <array>
 #include <concepts>
 #include <ranges>
+#include <variant>
 
 #include <qrcode/symbol.h>
 
 #include <qrcode/qr/symbol_designator.h>
+#include <qrcode/qr/dark_module_score.h>
 #include <qrcode/qr/format_information.h>
 #include <qrcode/qr/mask_pattern.h>
 #include <qrcode/qr/penalty_score.h>
+#include <qrcode/qr/static_penalty.h>
 
 #include <qrcode/structure/data_masking.h>
 #include <qrcode/structure/matrix.h>
 
+#include <qrcode/trace/tracer.h>
+
+namespace qrcode::qr::detail
+{
+    using qrcode::structure::matrix;
+
+    // scores every mask in full, the masking itself stops scoring a mask once it cannot win
+    template<class T, int Capacity, class Masks>
+    [[nodiscard]] constexpr auto all_mask_scores(matrix<T, Capacity> const& original, Masks const& masks) noexcept
+    {
+        auto scores = std::array<int, 8>{};
+        for (auto i = std::size_t{0}; i != scores.size(); ++i)
+            scores[i] = penalty_score(masks[i](original));
+        return scores;
+    }
+}
+
 namespace qrcode::qr
 {
     using qrcode::structure::matrix;
 
-    template<class T>
-    [[nodiscard]] constexpr auto finalize(matrix<T> code, symbol_designator designator) noexcept
+    template<class T, int Capacity, trace::Tracer Tracer = trace::null_tracer>
+    [[nodiscard]] constexpr auto finalize(
+        matrix<T, Capacity> code, symbol_designator designator, Tracer&& tracer = {}) noexcept
     {
-        auto const masks = available_masks();
-        auto const score = [](matrix<T> const& matrix) { return penalty_score(matrix); };
-        auto const mask_id = static_cast<int>(data_masking(code, masks, score) - begin(masks));
+        using qrcode::trace::stage;
+        using qrcode::trace::detail::begin_stage;
+        using qrcode::trace::detail::end_stage;
+        using qrcode::qr::detail::dark_module_count;
+        using qrcode::qr::detail::masked_dark_module_count;
+
+        auto const original = [&code]
+        {
+            if constexpr (trace::detail::reports_masks<std::remove_cvref_t<Tracer>>)
+                return code;
+            else
+                return std::monostate{};
+        }();
+
+        // the pre score starts every mask from the dark modules of the unmasked code
+        auto const dark_count = dark_module_count(code);
+        auto const mask_id = with_available_masks(version(designator), code, [&](auto const& masks)
+        {
+            return with_static_penalty(version(designator), code, [&](static_penalty const& penalty)
+            {
+                begin_stage(tracer, stage::data_masking);
+                auto const score = [&penalty](matrix<T, Capacity> const& matrix, int budget) 
+                { 
+                    return penalty_score(matrix, budget, penalty); 
+                };
+                auto const pre_score = [&dark_count](matrix<T, Capacity> const& matrix, auto const& mask) 
+                { 
+                    return detail::dark_module_score(
+                        masked_dark_module_count(matrix, dark_count, mask), width(matrix) * height(matrix)); 
+                };
+                auto const id = static_cast<int>(
+                    data_masking(code, masks, score, pre_score) - begin(masks));
+                end_stage(tracer, stage::data_masking);
+
+                if constexpr (trace::detail::reports_masks<std::remove_cvref_t<Tracer>>)
+                    tracer.masks(trace::mask_event{detail::all_mask_scores(original, masks), id});
+                return id;
+            });
+        });
+
         place_format_information(code, error_level(designator), mask_id);
-        return symbol{std::move(designator), mask_id, std::move(code)};
+        return symbol{std::move(designator), mask_id, matrix<T>{std::move(code)}};
     }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
 #include <string_view>
+#include <utility>
 #include <qrcode/structure/make_matrix.h>
 
 namespace qrcode::qr
@@ -115,6 +175,26 @@ namespace qrcode::qr
                 "*******-*,,+,+++,,+,+"sv
             )
         });
+
+        struct mask_recorder
+        {
+            constexpr auto begin(trace::stage_event const&) noexcept { ++stages; }
+            constexpr auto end(trace::stage_event const&) noexcept { ++stages; }
+            constexpr auto masks(trace::mask_event const& e) noexcept { event = e; }
+            int stages = 0;
+            trace::mask_event event = {};
+        };
+
+        constexpr auto recorded = []
+        {
+            auto tracer = mask_recorder{};
+            auto const s = finalize(any_unmasked, any_designator, tracer);
+            return std::pair{tracer, s};
+        }();
+        static_assert(recorded.second == finalize(any_unmasked, any_designator));
+        static_assert(recorded.first.stages == 2);
+        static_assert(recorded.first.event.chosen == selected_mask_id);
+        static_assert(recorded.first.event.scores[selected_mask_id] == std::ranges::min(recorded.first.event.scores));
     }
 }
 #endif
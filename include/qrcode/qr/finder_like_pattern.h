@@ -0,0 +1,48 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <array>
+
+namespace qrcode::qr
+{
+    // dark-light-dark-dark-dark-light-dark with four light modules before, after or on both
+    // sides of it, the latest module in the lowest bit
+    struct finder_like_pattern
+    {
+        unsigned bits;
+        int length;
+    };
+
+    inline constexpr auto finder_like_patterns = std::array{
+        finder_like_pattern{0b000'0101'1101u, 11},
+        finder_like_pattern{0b101'1101'0000u, 11},
+        finder_like_pattern{0b000'0101'1101'0000u, 15}
+    };
+
+    [[nodiscard]] constexpr auto matches(finder_like_pattern pattern, unsigned window) noexcept
+    {
+        return (window & ((1u << pattern.length) - 1)) == pattern.bits;
+    }
+}
@@ -24,98 +24,239 @@
 #pragma once
 
 #include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
 #include <ranges>
+#include <span>
 
+#include <qrcode/qr/finder_like_pattern.h>
 #include <qrcode/qr/penalty_weight.h>
+#include <qrcode/qr/static_segments.h>
 
-#include <qrcode/structure/element_view.h>
-#include <qrcode/structure/horizontal_view.h>
 #include <qrcode/structure/matrix.h>
 #include <qrcode/structure/module_traits.h>
-#include <qrcode/structure/vertical_view.h>
 
 namespace qrcode::qr::detail
 {
     using qrcode::structure::matrix;
 
-    template<std::ranges::range Line>
-    [[nodiscard]] constexpr auto finder_line_score(Line&& line)
+    // slides a window over the last 15 modules of the line, the latest module in the lowest bit;
+    // a single pass instead of searching the line for every pattern keeps constant evaluation cheap
+    class finder_window
     {
-        using value_type = std::ranges::range_value_t<Line>;
-        constexpr auto pattern_left = std::array<value_type,11>{0,0,0,0,1,0,1,1,1,0,1};
-        constexpr auto pattern_right = std::array<value_type,11>{1,0,1,1,1,0,1,0,0,0,0};
-        constexpr auto pattern_both = std::array<value_type,15>{0,0,0,0,1,0,1,1,1,0,1,0,0,0,0};
+        static constexpr auto long_window = 0b111'1111'1111'1111u;
 
-        auto contains_range = [](auto&& range, auto&& subrange)
+    public:
+        constexpr auto push(bool set) noexcept
         {
-            using std::ranges::begin;
-            using std::ranges::end;
-            using std::ranges::empty;
-            return !empty(std::ranges::search(range, subrange));
-        };
+            window = ((window << 1) | (set ? 1u : 0u)) & long_window;
+            ++modules;
+            match(window, modules);
+        }
 
-        auto score = 0;
+        // only the candidates of a static segment depend on the modules before it
+        constexpr auto skip(static_segment const& segment) noexcept
+        {
+            auto const segment_length = length(segment);
+            for (auto candidates = segment.finder_candidates; candidates != 0; candidates &= candidates - 1)
+            {
+                auto const j = std::countr_zero(candidates);
+                auto const shifted = (std::uint64_t{window} << (j + 1)) | (segment.bits >> (segment_length - 1 - j));
+                match(static_cast<unsigned>(shifted & long_window), modules + j + 1);
+            }
+            found |= segment.finder_matches;
 
-        if (contains_range(line, pattern_left))
-            score += penalty_weight(3);
+            auto const shifted = segment_length < 15 ? std::uint64_t{window} << segment_length : 0;
+            window = static_cast<unsigned>((shifted | segment.bits) & long_window);
+            modules += segment_length;
+        }
 
-        if (contains_range(line, pattern_right))
-            score += penalty_weight(3);
+        [[nodiscard]] constexpr auto score() const noexcept
+        {
+            auto score = 0;
 
-        if (contains_range(line, pattern_both))
-            score -= penalty_weight(3);
+            if (found & 0b001)
+                score += penalty_weight(3);
 
-        return score;
+            if (found & 0b010)
+                score += penalty_weight(3);
+
+            if (found & 0b100)
+                score -= penalty_weight(3);
+
+            return score;
+        }
+
+    private:
+        constexpr auto match(unsigned current, int count) noexcept -> void
+        {
+            auto const [left, right, both] = finder_like_patterns;
+
+            if (count >= left.length)
+            {
+                found |= matches(left, current) ? 0b001u : 0u;
+                found |= matches(right, current) ? 0b010u : 0u;
+            }
+            if (count >= both.length)
+                found |= matches(both, current) ? 0b100u : 0u;
+        }
+
+        unsigned window = 0;
+        int modules = 0;
+        unsigned found = 0;
+    };
+
+    template<std::ranges::range Line>
+    [[nodiscard]] constexpr auto finder_line_score(Line&& line)
+    {
+        auto window = finder_window{};
+        for (auto module : line)
+            window.push(static_cast<bool>(module));
+        return window.score();
+    }
+
+    template<std::ranges::random_access_range Line>
+    [[nodiscard]] constexpr auto finder_line_score(Line&& line, std::span<static_segment const> segments)
+    {
+        auto const modules = std::ranges::begin(line);
+        auto const line_length = static_cast<int>(std::ranges::size(line));
+
+        auto window = finder_window{};
+        auto i = 0;
+        for (auto const& segment : segments)
+        {
+            for (; i != segment.begin; ++i)
+                window.push(static_cast<bool>(modules[i]));
+            window.skip(segment);
+            i = segment.end;
+        }
+        for (; i != line_length; ++i)
+            window.push(static_cast<bool>(modules[i]));
+        return window.score();
     }
 
-    template<class T>
-    [[nodiscard]] constexpr auto horizontal_finder_like_score(matrix<T> const& matrix)
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto horizontal_finder_like_score(
+        matrix<T, Capacity> const& matrix, int budget = std::numeric_limits<int>::max())
     {
         using qrcode::structure::module_traits;
 
         auto score = 0;
-        for (auto y = 0; y != height(matrix); ++y)
+        for (auto y = 0; y != height(matrix) && score < budget; ++y)
         {
             auto range = 
-                views::horizontal({0,y}, {width(matrix),1}) 
-                | views::element(matrix)
+                row(matrix, y)
                 | std::views::transform([](auto v) { return module_traits<T>::is_set(v); });
             score += finder_line_score(range);
         }
         return score;
     }
 
-    template<class T>
-    [[nodiscard]] constexpr auto vertical_finder_like_score(matrix<T> const& matrix)
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto vertical_finder_like_score(
+        matrix<T, Capacity> const& matrix, int budget = std::numeric_limits<int>::max())
     {
+        using qrcode::structure::module_traits;
+
         auto score = 0;
 
-        for (auto x = 0; x != width(matrix); ++x)
+        for (auto x = 0; x != width(matrix) && score < budget; ++x)
         {
             auto range = 
-                views::vertical({x,0}, {1,height(matrix)}) 
-                | views::element(matrix)
+                column(matrix, x)
                 | std::views::transform([](auto v) { return module_traits<T>::is_set(v); });
             score += finder_line_score(range);
         }
 
         return score;
     }
+
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto horizontal_finder_like_score(
+        matrix<T, Capacity> const& matrix, static_segments const& segments, int budget)
+    {
+        using qrcode::structure::module_traits;
+
+        auto score = 0;
+        for (auto y = 0; y != height(matrix) && score < budget; ++y)
+        {
+            if (is_fixed_row(segments, y))
+                continue;
+            auto range = 
+                row(matrix, y)
+                | std::views::transform([](auto v) { return module_traits<T>::is_set(v); });
+            score += finder_line_score(range, row_segments(segments, y));
+        }
+        return score;
+    }
+
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto vertical_finder_like_score(
+        matrix<T, Capacity> const& matrix, static_segments const& segments, int budget)
+    {
+        using qrcode::structure::module_traits;
+
+        auto score = 0;
+        for (auto x = 0; x != width(matrix) && score < budget; ++x)
+        {
+            if (is_fixed_column(segments, x))
+                continue;
+            auto range = 
+                column(matrix, x)
+                | std::views::transform([](auto v) { return module_traits<T>::is_set(v); });
+            score += finder_line_score(range, column_segments(segments, x));
+        }
+        return score;
+    }
 }   
 
 namespace qrcode::qr
 {
     using qrcode::structure::matrix;
 
-    template<class T>
-    [[nodiscard]] constexpr auto finder_like_score(matrix<T> const& matrix)
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto finder_like_score(
+        matrix<T, Capacity> const& matrix, int budget = std::numeric_limits<int>::max())
+    {
+        using qrcode::qr::detail::horizontal_finder_like_score;
+        using qrcode::qr::detail::vertical_finder_like_score;
+
+        auto const score = horizontal_finder_like_score(matrix, budget);
+        return score + vertical_finder_like_score(matrix, budget - score);
+    }
+
+    // a pattern may be found in the static and in the data modules of a line, but it is counted just
+    // once; so only the lines without data modules are scored in advance
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto static_finder_like_score(
+        matrix<T, Capacity> const& code, static_segments const& segments) noexcept
+    {
+        using qrcode::qr::detail::finder_line_score;
+        using qrcode::structure::module_traits;
+
+        auto const is_set = [](auto v) { return module_traits<T>::is_set(v); };
+        auto score = 0;
+        for (auto y = 0; y != height(code); ++y)
+            if (is_fixed_row(segments, y))
+                score += finder_line_score(row(code, y) | std::views::transform(is_set));
+        for (auto x = 0; x != width(code); ++x)
+            if (is_fixed_column(segments, x))
+                score += finder_line_score(column(code, x) | std::views::transform(is_set));
+        return score;
+    }
+
+    // finder like score of the lines with data modules, the static finder like score adds the rest
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto finder_like_score(
+        matrix<T, Capacity> const& matrix, static_segments const& segments, 
+        int budget = std::numeric_limits<int>::max())
     {
         using qrcode::qr::detail::horizontal_finder_like_score;
         using qrcode::qr::detail::vertical_finder_like_score;
 
-        return 
-            horizontal_finder_like_score(matrix) 
-            + vertical_finder_like_score(matrix);
+        auto const score = horizontal_finder_like_score(matrix, segments, budget);
+        return score + vertical_finder_like_score(matrix, segments, budget - score);
     }
 }
 
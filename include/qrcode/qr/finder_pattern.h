@@ -50,10 +50,10 @@ namespace qrcode::qr
             return extend;
         }
 
-        template<class T>
+        template<class T, int Capacity>
         requires std::convertible_to<std::invoke_result_t<
             decltype(module_traits<T>::make_function), bool>, T>
-        [[nodiscard]] constexpr auto place(matrix<T>& matrix, position top_left) const noexcept
+        [[nodiscard]] constexpr auto place(matrix<T, Capacity>& matrix, position top_left) const noexcept
         {
             using qrcode::structure::module_traits;
             using std::ranges::begin;
@@ -84,8 +84,8 @@ namespace qrcode::qr
         return std::array<position,3>{{{0,0}, {left,0}, {0, bottom}}};
     }
 
-    template<class T>
-    [[nodiscard]] constexpr auto place_finder_patterns(matrix<T>& matrix) noexcept
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto place_finder_patterns(matrix<T, Capacity>& matrix) noexcept
     {
         auto const pattern = finder_pattern{};
         for (auto i : finder_locations(size(matrix)))
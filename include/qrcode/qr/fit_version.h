@@ -47,5 +47,21 @@ namespace qrcode::qr
         }
         return std::optional<symbol_version>{};
     }
+
+    // a part of a structured append message, whose header takes space in every symbol
+    template<std::ranges::forward_range Message>
+    requires std::convertible_to<std::ranges::range_value_t<Message>, char>
+    [[nodiscard]] constexpr auto fit_version(
+        Message&& message, error_correction error_level, structured_append const& sequence) noexcept
+    {
+        for (auto i : version_categories())
+        {
+            auto const needed_size = data_length(message, i, sequence);        
+            auto const version = best_version(error_level, needed_size);
+            if (version && make_version_category(*version) == i)
+                return std::optional<symbol_version>{version};
+        }
+        return std::optional<symbol_version>{};
+    }
 }
 
@@ -23,6 +23,10 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <optional>
+#include <utility>
+
 #include <qrcode/qr/error_correction.h>
 
 #include <qrcode/code/format_encoding.h>
@@ -39,12 +43,18 @@ namespace qrcode::qr::detail
     using qrcode::structure::matrix;
     using qrcode::code::raw_format;
     using qrcode::code::error_correcting_code;
+    using qrcode::code::format_mask;
 
     [[nodiscard]] constexpr auto bch_code() noexcept
     {
         return error_correcting_code{15, 5, 0b101'0011'0111};
     }
 
+    [[nodiscard]] constexpr auto format_mask_pattern() noexcept
+    {
+        return format_mask{0b101'0100'0001'0010};
+    }
+
     [[nodiscard]] constexpr auto format(error_correction error_level, int mask_type) noexcept
     {
         return raw_format{static_cast<std::uint16_t>(
@@ -90,8 +100,8 @@ namespace qrcode::qr
 {
     using qrcode::structure::matrix;
 
-    template<class T>
-    [[nodiscard]] constexpr auto reserve_format_information(matrix<T>& matrix)
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto reserve_format_information(matrix<T, Capacity>& matrix)
     {
         using qrcode::qr::detail::format_positions;
         using qrcode::qr::detail::dark_dot;
@@ -107,18 +117,18 @@ namespace qrcode::qr
         element_at(matrix, dark_dot(size(matrix))) = make_function(1);
     }
     
-    template<class T>
+    template<class T, int Capacity>
     [[nodiscard]] constexpr auto place_format_information(
-        matrix<T>& matrix, error_correction error_level, int data_mask) noexcept
+        matrix<T, Capacity>& matrix, error_correction error_level, int data_mask) noexcept
     {
         using qrcode::qr::detail::bch_code;
         using qrcode::qr::detail::format;
         using qrcode::qr::detail::dark_dot;
         using qrcode::qr::detail::format_positions;
+        using qrcode::qr::detail::format_mask_pattern;
         using qrcode::structure::module_traits;
-        using qrcode::code::format_mask;
 
-        auto const mask_pattern = format_mask{0b101'0100'0001'0010};
+        auto const mask_pattern = format_mask_pattern();
         auto bits = masked(encode(format(error_level, data_mask), bch_code()), mask_pattern).data;
         auto make_function = module_traits<T>::make_function;
 
@@ -130,6 +140,40 @@ namespace qrcode::qr
         }
         element_at(matrix, dark_dot(size(matrix))) = make_function(1);
     }
+
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto read_format_information(matrix<T, Capacity> const& matrix) noexcept
+    {
+        using qrcode::qr::detail::bch_code;
+        using qrcode::qr::detail::format_positions;
+        using qrcode::qr::detail::format_mask_pattern;
+        using qrcode::structure::module_traits;
+        using qrcode::code::masked_format;
+        using qrcode::code::nearest_format;
+        using result_type = std::optional<std::pair<error_correction, int>>;
+
+        // the code has a minimum distance of 7, the nearest codeword is unique up to 3 errors
+        constexpr auto max_errors = 3;
+        auto is_set = module_traits<T>::is_set;
+
+        auto first = std::uint16_t{0};
+        auto second = std::uint16_t{0};
+        auto bit = std::uint16_t{1};
+        for (auto i : format_positions(size(matrix)))
+        {
+            first |= is_set(element_at(matrix, i.first)) ? bit : 0;
+            second |= is_set(element_at(matrix, i.second)) ? bit : 0;
+            bit <<= 1;
+        }
+
+        auto const a = nearest_format(unmasked(masked_format{first}, format_mask_pattern()), bch_code());
+        auto const b = nearest_format(unmasked(masked_format{second}, format_mask_pattern()), bch_code());
+        auto const [format, errors] = a.second <= b.second ? a : b;
+        if (errors > max_errors)
+            return result_type{};
+
+        return result_type{{static_cast<error_correction>(format.data >> 3), format.data & 0b111}};
+    }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
@@ -226,5 +270,44 @@ namespace qrcode::qr::test
         };
         static_assert(f());
     }
+
+    constexpr auto format_information_can_be_read_from_qr_symbols()
+    {
+        auto f = [](auto error_level, auto data_mask)
+        {
+            using namespace qrcode::structure;
+            auto any_matrix = matrix<char>{{21,21}, module_traits<char>::make_free()};
+
+            place_format_information(any_matrix, error_level, data_mask);
+
+            return read_format_information(any_matrix) == std::make_pair(error_level, data_mask);
+        };
+        static_assert(f(error_correction::level_L, 0b000));
+        static_assert(f(error_correction::level_M, 0b101));
+        static_assert(f(error_correction::level_Q, 0b011));
+        static_assert(f(error_correction::level_H, 0b111));
+    }
+
+    constexpr auto format_information_is_read_from_the_less_damaged_copy()
+    {
+        auto f = []
+        {
+            using namespace qrcode::structure;
+            auto any_matrix = matrix<char>{{21,21}, module_traits<char>::make_free()};
+            place_format_information(any_matrix, error_correction::level_Q, 0b110);
+
+            auto const flip = [&](position p) 
+            { 
+                auto& module = element_at(any_matrix, p);
+                module = module == '*' ? '-' : '*';
+            };
+            for (auto i : {0, 1, 2, 3, 4})
+                flip(detail::format_positions({21,21})[i].first);
+            flip(detail::format_positions({21,21})[7].second);
+
+            return read_format_information(any_matrix) == std::make_pair(error_correction::level_Q, 0b110);
+        };
+        static_assert(f());
+    }
 }
 #endif
\ No newline at end of file
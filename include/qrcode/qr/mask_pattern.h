@@ -24,9 +24,15 @@
 #pragma once
 
 #include <array>
+#include <mutex>
 #include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include <qrcode/qr/symbol_version.h>
 
 #include <qrcode/structure/apply_mask.h>
+#include <qrcode/structure/mask_plane.h>
 #include <qrcode/structure/matrix.h>
 
 namespace qrcode::qr
@@ -53,6 +59,65 @@ namespace qrcode::qr
     }
 }
 
+namespace qrcode::qr::detail
+{
+    using mask_plane = qrcode::structure::mask_plane<width(size(symbol_version{40}))>;
+    using mask_planes = std::array<mask_plane, 8>;
+
+    struct mask_plane_cache_entries
+    {
+        std::array<mask_planes, 40> planes;
+        std::array<std::once_flag, 40> initialized;
+    };
+
+    // shared by all module types, whichever symbol of a version comes first fills it
+    [[nodiscard]] inline auto mask_plane_cache() -> mask_plane_cache_entries&
+    {
+        static auto cache = mask_plane_cache_entries{};
+        return cache;
+    }
+
+    // the data region only depends on the symbol version, so do the planes; the
+    // region is only scanned from given code by the first symbol of each version
+    template<class T, int Capacity>
+    [[nodiscard]] auto cached_mask_planes(
+        symbol_version version, qrcode::structure::matrix<T, Capacity> const& code) -> mask_planes const&
+    {
+        using qrcode::structure::make_mask_planes;
+        auto& [planes, initialized] = mask_plane_cache();
+
+        auto const index = version.number - 1;
+        std::call_once(initialized[index], [&]
+        { 
+            planes[index] = make_mask_planes(mask_plane{code}, mask_patterns()); 
+        });
+        return planes[index];
+    }
+}
+
+namespace qrcode::qr
+{
+    using qrcode::structure::matrix;
+
+    // hands the masks of given code to given function, at runtime these are the
+    // cached planes of its version which are never copied
+    template<class T, int Capacity, class Function>
+    constexpr auto with_available_masks(
+        symbol_version version, matrix<T, Capacity> const& code, Function&& function) noexcept
+    {
+        using qrcode::structure::make_mask_planes;
+        using qrcode::qr::detail::cached_mask_planes;
+        using qrcode::qr::detail::mask_plane;
+
+        if (std::is_constant_evaluated())
+        {
+            auto const masks = make_mask_planes(mask_plane{code}, mask_patterns());
+            return std::forward<Function>(function)(masks);
+        }
+        return std::forward<Function>(function)(cached_mask_planes(version, code));
+    }
+}
+
 #ifdef QRCODE_TESTS_ENABLED
 #include <string_view>
 #include <qrcode/structure/make_matrix.h>
@@ -166,5 +231,32 @@ namespace qrcode::qr::test
         };
         static_assert(f());
     }
+
+    constexpr auto available_masks_of_given_code_mask_its_data_modules_like_the_mask_patterns()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            using qrcode::structure::make_matrix;
+            constexpr auto any_version = symbol_version{1};
+            auto const nominal_masks = available_masks();
+
+            auto const any_matrix = make_matrix<char>({6,5}, 
+                "**+,,+"
+                "*-+.++"
+                ",+-*,,"
+                "++,+,+"
+                "-,,,++"sv
+            );
+            return with_available_masks(any_version, any_matrix, [&](auto const& masks)
+            {
+                for (auto i = 0; i != 8; ++i)
+                    if (masks[i](any_matrix) != nominal_masks[i](any_matrix))
+                        return false;
+                return true;
+            });
+        };
+        static_assert(f());
+    }
 }
 #endif
\ No newline at end of file
@@ -26,6 +26,7 @@
 #include <qrcode/qr/encoders.h>
 #include <qrcode/qr/version_category.h>
 #include <qrcode/data/optimizer/data_encoding.h>
+#include <qrcode/eci/view.h>
 
 namespace qrcode::qr
 {
@@ -37,7 +38,8 @@ namespace qrcode::qr
         bit_stream& stream, Message&& message, version_category category) noexcept
     {
         using qrcode::data::optimizer::encode_data;
-        encode_data(stream, std::forward<Message>(message), available_encoders(category));
+        auto const kanji_enabled = allows_kanji_mode(message);
+        encode_data(stream, std::forward<Message>(message), available_encoders(category), kanji_enabled);
     }
 }
 
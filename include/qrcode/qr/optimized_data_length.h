@@ -26,6 +26,7 @@
 #include <qrcode/qr/encoders.h>
 #include <qrcode/qr/version_category.h>
 #include <qrcode/data/optimizer/data_length.h>
+#include <qrcode/eci/view.h>
 
 namespace qrcode::qr
 {
@@ -35,7 +36,8 @@ namespace qrcode::qr
         Message&& message, version_category category) noexcept
     {
         using qrcode::data::optimizer::data_length;
-        return data_length(std::forward<Message>(message), available_encoders(category)); 
+        auto const kanji_enabled = allows_kanji_mode(message);
+        return data_length(std::forward<Message>(message), available_encoders(category), kanji_enabled); 
     }
 }
 
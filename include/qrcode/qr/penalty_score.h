@@ -27,11 +27,12 @@
 #include <qrcode/qr/same_color_score.h>
 #include <qrcode/qr/finder_like_score.h>
 #include <qrcode/qr/dark_module_score.h>
+#include <qrcode/qr/static_penalty.h>
 
 namespace qrcode::qr
 {
-    template<class T>
-    [[nodiscard]] constexpr auto penalty_score(matrix<T> const& matrix)
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto penalty_score(matrix<T, Capacity> const& matrix)
     {
         return 
             adjacent_score(matrix)
@@ -39,10 +40,36 @@ namespace qrcode::qr
             + finder_like_score(matrix)
             + dark_module_score(matrix);
     }
+
+    // the result is exact only if it is below the given budget;
+    // otherwise the evaluation may stop early with any score not below the budget
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto penalty_score(matrix<T, Capacity> const& matrix, int budget)
+    {
+        auto score = dark_module_score(matrix);
+        score += adjacent_score(matrix, budget - score);
+        score += same_color_score(matrix, budget - score);
+        score += finder_like_score(matrix, budget - score);
+        return score;
+    }
+
+    // same as above for a mask candidate of the code given static penalty was made of,
+    // only the data modules and the boundaries of the static segments are scanned
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto penalty_score(
+        matrix<T, Capacity> const& matrix, int budget, static_penalty const& penalty)
+    {
+        auto score = penalty.score + dark_module_score(matrix);
+        score += adjacent_score(matrix, penalty.segments, budget - score);
+        score += same_color_score(matrix, penalty.segments, budget - score);
+        score += finder_like_score(matrix, penalty.segments, budget - score);
+        return score;
+    }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
 #include <string_view>
+#include <qrcode/qr/mask_pattern.h>
 #include <qrcode/structure/make_matrix.h>
 
 namespace qrcode::qr::test
@@ -87,5 +114,58 @@ namespace qrcode::qr::test
         static_assert(s4 == 0);
         static_assert(penalty_score(any_matrix) == (s1+s2+s3+s4));
     }
+
+    constexpr auto budgeted_penalty_scores_are_exact_below_the_budget_and_not_below_it_otherwise()
+    {
+        using qrcode::structure::make_matrix;
+        using namespace std::literals;
+
+        constexpr auto any_matrix = make_matrix<char>({11,11},
+            "*******.**."   
+            "*.....*.*.."   
+            "*.***.*.*.."   
+            "*.***.*.*.*"   
+            "*.***.*.*.*"   
+            "*.....*...*"   
+            "*******.*.*"   
+            "........*.."   
+            ".**.*.**..."   
+            ".*......***"   
+            "..**.***.**"sv
+        );
+        constexpr auto nominal = penalty_score(any_matrix);
+
+        static_assert(penalty_score(any_matrix, nominal+1) == nominal);
+        static_assert(penalty_score(any_matrix, nominal) >= nominal);
+        static_assert(penalty_score(any_matrix, 1) >= 1);
+        static_assert(penalty_score(any_matrix, 0) >= 0);
+    }
+
+    constexpr auto penalty_scores_of_mask_candidates_can_start_from_the_static_penalty_of_their_code()
+    {
+        using qrcode::structure::make_matrix;
+        using namespace std::literals;
+
+        constexpr auto any_code = make_matrix<char>({11,11},
+            "*******-+,+"   
+            "*-----*-,,+"   
+            "*-***-*-+++"   
+            "*-***-*-,,+"   
+            "*-***-*-+,+"   
+            "*-----*-++,"   
+            "*******-*-*"   
+            "--------,,+"   
+            "+,++,+*+,++"   
+            "+,,,,,-,,++"   
+            "++,,+,*++,+"sv
+        );
+        constexpr auto penalty = make_static_penalty(any_code);
+        constexpr auto masked = available_masks()[3](any_code);
+        constexpr auto nominal = penalty_score(masked);
+
+        static_assert(penalty_score(masked, nominal+1, penalty) == nominal);
+        static_assert(penalty_score(masked, nominal, penalty) >= nominal);
+        static_assert(penalty_score(masked, 1, penalty) >= 1);
+    }
 }
 #endif
\ No newline at end of file
@@ -29,68 +29,246 @@
 #include <qrcode/result.h>
 #include <qrcode/symbol.h>
 
+#include <qrcode/data/segment_stream.h>
+
+#include <qrcode/qr/best_version.h>
 #include <qrcode/qr/raw_code.h>
 #include <qrcode/qr/code_bits.h>
 #include <qrcode/qr/code_capacity.h>
 #include <qrcode/qr/data_encoding.h>
 #include <qrcode/qr/data_length.h>
+#include <qrcode/qr/encoders.h>
 #include <qrcode/qr/error_correction.h>
 #include <qrcode/qr/finalize_symbol.h>
 #include <qrcode/qr/fit_version.h>
 #include <qrcode/qr/symbol_version.h>
 #include <qrcode/qr/version_category.h>
 #include <qrcode/eci/view.h>
+#include <qrcode/trace/tracer.h>
+
+namespace qrcode::qr::detail
+{
+    using qrcode::data::numeric_encoder;
+    using qrcode::data::alphanumeric_encoder;
+    using qrcode::data::byte_encoder;
+    using qrcode::data::kanji_encoder;
+
+    [[nodiscard]] constexpr auto segment_mode(numeric_encoder const&) noexcept { return trace::mode::numeric; }
+    [[nodiscard]] constexpr auto segment_mode(alphanumeric_encoder const&) noexcept { return trace::mode::alphanumeric; }
+    [[nodiscard]] constexpr auto segment_mode(byte_encoder const&) noexcept { return trace::mode::byte; }
+    [[nodiscard]] constexpr auto segment_mode(kanji_encoder const&) noexcept { return trace::mode::kanji; }
+
+    // runs the optimizer a second time, only for tracers listening to segments
+    template<class Message, class Tracer>
+    constexpr auto trace_segments(Message const& message, version_category category, Tracer& tracer) noexcept
+    {
+        if constexpr (trace::detail::reports_segments<Tracer>)
+        {
+            using qrcode::data::optimizer::optimize;
+            using qrcode::trace::detail::report_segment;
+
+            auto publish = [&tracer](auto const& range, auto const& encoder)
+            {
+                auto const mode = segment_mode(encoder);
+                auto const length = static_cast<int>(std::ranges::distance(range));
+                report_segment(tracer, mode, mode == trace::mode::kanji ? length / 2 : length);
+            };
+            optimize(message, available_encoders(category), publish, allows_kanji_mode(message));
+        }
+    }
+
+    template<int Version>
+    inline constexpr auto module_count = width(size(symbol_version{Version})) * height(size(symbol_version{Version}));
+
+    // the number of codewords only depends on the version, not on the error level
+    template<int Version>
+    inline constexpr auto codeword_count = total_bits(make_code_capacity(
+        symbol_designator{symbol_version{Version}, error_correction::level_L})) / code::bits_per_codeword();
+
+    template<int Version, class Module>
+    inline constexpr auto function_layout = make_function_layout<Module, module_count<Version>>(symbol_version{Version});
+
+    template<class Module, class Bits, class Tracer>
+    [[nodiscard]] constexpr auto finish_symbol(
+        symbol_designator const& designator, Bits&& data_bits, Tracer& tracer) noexcept
+    {
+        using qrcode::trace::stage;
+        using qrcode::trace::detail::begin_stage;
+        using qrcode::trace::detail::end_stage;
+
+        auto const capacity = make_code_capacity(designator);
+        if constexpr (trace::enabled<Tracer>)
+        {
+            auto const bits = code_bits(std::forward<Bits>(data_bits), capacity, tracer);
+            begin_stage(tracer, stage::make_raw_code);
+            auto code = make_raw_code<Module>(version(designator), bits);
+            end_stage(tracer, stage::make_raw_code, static_cast<int>(bits.size()));
+            return finalize(std::move(code), designator, tracer);
+        }
+        else
+            return finalize(
+                make_raw_code<Module>(version(designator), code_bits(std::forward<Bits>(data_bits), capacity)),
+                designator
+            );
+    }
+}
 
 namespace qrcode::qr
 {
     using qrcode::structure::module;
 
-    template<class Module = module, std::ranges::forward_range Message>
+    // a tracer observes the stages of the generation, the default one compiles to nothing
+    template<class Module = module, std::ranges::forward_range Message, trace::Tracer Tracer = trace::null_tracer>
     requires std::convertible_to<std::ranges::range_value_t<Message>, char>
     [[nodiscard]] constexpr auto make_symbol(
-        Message&& message, symbol_version version, error_correction error_level) noexcept
+        Message&& message, symbol_version version, error_correction error_level, Tracer&& tracer = {}) noexcept
     {
+        using qrcode::trace::stage;
+        using qrcode::trace::detail::begin_stage;
+        using qrcode::trace::detail::end_stage;
+        using qrcode::trace::detail::report_version;
         using symbol_type = symbol<Module, symbol_designator>;
 
         auto const designator = symbol_designator{version, error_level};
         auto const category = make_version_category(version);
         auto const capacity = make_code_capacity(designator);
 
+        begin_stage(tracer, stage::fit_version);
         auto const needed_size = data_length(message, category);        
+        end_stage(tracer, stage::fit_version, needed_size);
         if (needed_size > total_data_bits(capacity))
             return result<symbol_type>{error_code::data_too_large};
 
+        report_version(tracer, version.number, number(error_level));
+        detail::trace_segments(message, category, tracer);
+
+        begin_stage(tracer, stage::encode_data);
         auto const stream = encode_data(std::forward<Message>(message), category);
-        return result{finalize(
-            make_raw_code<Module>(version, code_bits(stream.get(), capacity)),
-            designator
-        )};
+        end_stage(tracer, stage::encode_data, stream.size());
+        return result{detail::finish_symbol<Module>(designator, stream.get(), tracer)};
     }
 
-    template<class Module = module, std::ranges::forward_range Message>
+    template<class Module = module, std::ranges::forward_range Message, trace::Tracer Tracer = trace::null_tracer>
     requires std::convertible_to<std::ranges::range_value_t<Message>, char>
     [[nodiscard]] constexpr auto make_symbol(
-        Message&& message, error_correction error_level) noexcept
+        Message&& message, error_correction error_level, Tracer&& tracer = {}) noexcept
     {
+        using qrcode::trace::stage;
+        using qrcode::trace::detail::begin_stage;
+        using qrcode::trace::detail::end_stage;
+        using qrcode::trace::detail::report_version;
         using symbol_type = symbol<Module, symbol_designator>;
 
+        begin_stage(tracer, stage::fit_version);
         auto const version = fit_version(message, error_level);
+        end_stage(tracer, stage::fit_version);
         if (!version)
             return result<symbol_type>{error_code::data_too_large};
 
         auto const designator = symbol_designator{*version, error_level};
-        auto const stream = encode_data(message, make_version_category(*version));
+        auto const category = make_version_category(*version);
+        report_version(tracer, version->number, number(error_level));
+        detail::trace_segments(message, category, tracer);
+
+        begin_stage(tracer, stage::encode_data);
+        auto const stream = encode_data(message, category);
+        end_stage(tracer, stage::encode_data, stream.size());
+        return result{detail::finish_symbol<Module>(designator, stream.get(), tracer)};
+    }
+
+    // single pass ranges like streams are read only once, the characters are encoded right away
+    // and the version is chosen afterwards from the bit counts of the segments
+    template<class Module = module, std::ranges::input_range Message>
+    requires (!std::ranges::forward_range<Message>)
+        && std::convertible_to<std::ranges::range_value_t<Message>, char>
+    [[nodiscard]] constexpr auto make_symbol(
+        Message&& message, error_correction error_level) noexcept
+    {
+        using qrcode::data::bit_stream;
+        using qrcode::data::stream_segments;
+        using symbol_type = symbol<Module, symbol_designator>;
+
+        auto const segments = stream_segments(std::forward<Message>(message));
+        if (overflowed(segments))
+            return result<symbol_type>{error_code::data_too_large};
+
+        for (auto i : version_categories())
+        {
+            auto const encoders = available_encoders(i);
+            auto const version = best_version(error_level, bit_count(segments, encoders));
+            if (!version || make_version_category(*version) != i)
+                continue;
+
+            auto const designator = symbol_designator{*version, error_level};
+            auto stream = bit_stream{};
+            write_segments(stream, segments, encoders);
+            return result{finalize(
+                make_raw_code<Module>(
+                    *version, 
+                    code_bits(stream.get(), make_code_capacity(designator))),
+                designator
+            )};
+        }
+        return result<symbol_type>{error_code::data_too_large};
+    }
+
+    template<class Module = module, std::ranges::input_range Message>
+    requires (!std::ranges::forward_range<Message>)
+        && std::convertible_to<std::ranges::range_value_t<Message>, char>
+    [[nodiscard]] constexpr auto make_symbol(
+        Message&& message, symbol_version version, error_correction error_level) noexcept
+    {
+        using qrcode::data::bit_stream;
+        using qrcode::data::stream_segments;
+        using symbol_type = symbol<Module, symbol_designator>;
+
+        auto const designator = symbol_designator{version, error_level};
+        auto const encoders = available_encoders(make_version_category(version));
+        auto const capacity = make_code_capacity(designator);
+
+        auto const segments = stream_segments(std::forward<Message>(message));
+        if (overflowed(segments) || bit_count(segments, encoders) > total_data_bits(capacity))
+            return result<symbol_type>{error_code::data_too_large};
+
+        auto stream = bit_stream{};
+        write_segments(stream, segments, encoders);
+        return result{finalize(make_raw_code<Module>(version, code_bits(stream.get(), capacity)), designator)};
+    }
+
+    // the version is known at compile time, so is the layout of the function patterns; the layout,
+    // the matrix being masked and the codeword buffer are all sized for this version only
+    template<int Version, class Module = module, std::ranges::forward_range Message>
+    requires (Version >= 1 && Version <= 40)
+        && std::convertible_to<std::ranges::range_value_t<Message>, char>
+    [[nodiscard]] constexpr auto make_symbol(
+        Message&& message, error_correction error_level) noexcept
+    {
+        using qrcode::qr::detail::codeword_count;
+        using qrcode::qr::detail::function_layout;
+        using symbol_type = symbol<Module, symbol_designator>;
+
+        constexpr auto version = symbol_version{Version};
+        constexpr auto category = make_version_category(version);
+
+        auto const designator = symbol_designator{version, error_level};
+        auto const capacity = make_code_capacity(designator);
+
+        auto const needed_size = data_length(message, category);        
+        if (needed_size > total_data_bits(capacity))
+            return result<symbol_type>{error_code::data_too_large};
+
+        auto const stream = encode_data(std::forward<Message>(message), category);
         return result{finalize(
-            make_raw_code<Module>(
-                *version, 
-                code_bits(stream.get(), make_code_capacity(designator))),
+            make_raw_code(function_layout<Version, Module>, code_bits<codeword_count<Version>>(stream.get(), capacity)),
             designator
-        )};    
+        )};
     }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
+#include <array>
 #include <string_view>
+#include <utility>
 #include <qrcode/structure/make_matrix.h>
 
 namespace qrcode::qr
@@ -189,6 +367,38 @@ namespace qrcode::qr
         static_assert(!s.has_value());
     }
 
+    constexpr auto qr_symbols_can_be_generated_for_a_version_known_at_compile_time()
+    {
+        using namespace std::literals;
+        constexpr auto any_data = "01234567"sv;
+        constexpr auto too_long_data = "This is way too long. Sorry! This does not work!!!"sv;
+        constexpr auto any_error_level = error_correction::level_M;
+
+        constexpr auto s = make_symbol<1, char>(any_data, any_error_level);
+        constexpr auto nominal = make_symbol<char>(any_data, symbol_version{1}, any_error_level);
+
+        static_assert(s.value() == nominal.value());
+        static_assert(!make_symbol<1, char>(too_long_data, any_error_level).has_value());
+    }
+
+    constexpr auto qr_symbols_can_be_generated_from_single_pass_ranges()
+    {
+        using qrcode::data::test::single_pass;
+        using namespace std::literals;
+        constexpr auto any_data = "Hello, world! 0123456789012345"sv;
+        constexpr auto too_long_data = "This is way too long. Sorry! This does not work!!!"sv;
+        constexpr auto any_error_level = error_correction::level_M;
+
+        constexpr auto s = make_symbol<char>(single_pass{any_data}, any_error_level);
+        constexpr auto nominal = make_symbol<char>(any_data, any_error_level);
+
+        static_assert(s.value() == nominal.value());
+        static_assert(
+            make_symbol<char>(single_pass{any_data}, symbol_version{3}, any_error_level).value() == 
+            make_symbol<char>(any_data, symbol_version{3}, any_error_level).value());
+        static_assert(!make_symbol<char>(single_pass{too_long_data}, symbol_version{1}, any_error_level).has_value());
+    }
+
     constexpr auto qr_symbols_support_eci_encoding()
     {
         using qrcode::structure::make_matrix;
@@ -229,5 +439,81 @@ namespace qrcode::qr
             )
         });
     }
+
+    struct event_recorder
+    {
+        constexpr auto begin(trace::stage_event const& e) noexcept { stages[stage_count++] = e; }
+        constexpr auto end(trace::stage_event const& e) noexcept { stages[stage_count++] = e; }
+        constexpr auto segment(trace::segment_event const& e) noexcept { segments[segment_count++] = e; }
+        constexpr auto version(trace::version_event const& e) noexcept { chosen_version = e; }
+        constexpr auto masks(trace::mask_event const& e) noexcept { mask_scores = e; }
+
+        std::array<trace::stage_event, 10> stages = {};
+        int stage_count = 0;
+        std::array<trace::segment_event, 4> segments = {};
+        int segment_count = 0;
+        trace::version_event chosen_version = {};
+        trace::mask_event mask_scores = {};
+    };
+
+    constexpr auto qr_symbol_generation_reports_its_stages_to_given_tracer()
+    {
+        using qrcode::trace::stage;
+        using qrcode::trace::stage_event;
+        using namespace std::literals;
+
+        constexpr auto any_data = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"sv;
+        constexpr auto any_error_level = error_correction::level_L;
+
+        constexpr auto traced = [=]
+        {
+            auto tracer = event_recorder{};
+            auto s = make_symbol<char>(any_data, any_error_level, tracer);
+            return std::pair{tracer, s.value()};
+        }();
+        constexpr auto events = traced.first;
+
+        static_assert(traced.second == make_symbol<char>(any_data, any_error_level).value());
+        static_assert(events.stage_count == 10);
+        static_assert(events.stages[0] == stage_event{stage::fit_version});
+        static_assert(events.stages[1] == stage_event{stage::fit_version});
+        static_assert(events.stages[2] == stage_event{stage::encode_data});
+        static_assert(events.stages[3] == stage_event{stage::encode_data, 0, 4+10+34 + 4+9+143});
+        static_assert(events.stages[4] == stage_event{stage::code_bits});
+        static_assert(events.stages[5] == stage_event{stage::code_bits, 0, 44*8});
+        static_assert(events.stages[6] == stage_event{stage::make_raw_code});
+        static_assert(events.stages[7] == stage_event{stage::make_raw_code, 0, 44*8});
+        static_assert(events.stages[8] == stage_event{stage::data_masking});
+        static_assert(events.stages[9] == stage_event{stage::data_masking});
+
+        static_assert(events.segment_count == 2);
+        static_assert(events.segments[0] == trace::segment_event{trace::mode::numeric, 36-26});
+        static_assert(events.segments[1] == trace::segment_event{trace::mode::alphanumeric, 26});
+        static_assert(events.chosen_version == trace::version_event{2, number(any_error_level)});
+        static_assert(events.mask_scores.chosen == mask_pattern(traced.second));
+    }
+
+    constexpr auto qr_symbols_with_given_version_report_the_needed_data_length()
+    {
+        using qrcode::trace::stage;
+        using qrcode::trace::stage_event;
+        using namespace std::literals;
+
+        constexpr auto any_data = "01234567"sv;
+        constexpr auto any_version = symbol_version{1};
+        constexpr auto any_error_level = error_correction::level_M;
+
+        constexpr auto traced = [=]
+        {
+            auto tracer = event_recorder{};
+            auto s = make_symbol<char>(any_data, any_version, any_error_level, tracer);
+            return std::pair{tracer, s.value()};
+        }();
+
+        static_assert(traced.second == make_symbol<char>(any_data, any_version, any_error_level).value());
+        static_assert(traced.first.stages[1] == stage_event{stage::fit_version, 0, 41});
+        static_assert(traced.first.segments[0] == trace::segment_event{trace::mode::numeric, 8});
+        static_assert(traced.first.chosen_version == trace::version_event{1, number(any_error_level)});
+    }
 }
 #endif
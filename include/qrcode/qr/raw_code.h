@@ -44,14 +44,12 @@ namespace qrcode::qr
 {
     using qrcode::structure::matrix;
 
-    template<class T, std::ranges::range Range>
-    requires std::convertible_to<std::ranges::range_value_t<Range>, bool>
-    [[nodiscard]] constexpr auto make_raw_code(symbol_version version, Range&& bits) noexcept
+    template<class T, int Capacity = cx::default_capacity>
+    [[nodiscard]] constexpr auto make_function_layout(symbol_version version) noexcept
     {
         using qrcode::structure::module_traits;
-        using qrcode::structure::place_data;
 
-        auto code = matrix<T>{size(version), module_traits<T>::make_free()};
+        auto code = matrix<T, Capacity>{size(version), module_traits<T>::make_free()};
 
         place_finder_patterns(code);
         place_separator_patterns(code);
@@ -59,10 +57,27 @@ namespace qrcode::qr
         place_alignment_patterns(code);
         place_version_information(code, version);
         reserve_format_information(code);
-        place_data(code, bits | std::views::transform(module_traits<T>::make_data));
 
         return code;
     }
+
+    template<class T, int Capacity, std::ranges::range Range>
+    requires std::convertible_to<std::ranges::range_value_t<Range>, bool>
+    [[nodiscard]] constexpr auto make_raw_code(matrix<T, Capacity> layout, Range&& bits) noexcept
+    {
+        using qrcode::structure::module_traits;
+        using qrcode::structure::place_data;
+
+        place_data(layout, bits | std::views::transform(module_traits<T>::make_data));
+        return layout;
+    }
+
+    template<class T, std::ranges::range Range>
+    requires std::convertible_to<std::ranges::range_value_t<Range>, bool>
+    [[nodiscard]] constexpr auto make_raw_code(symbol_version version, Range&& bits) noexcept
+    {
+        return make_raw_code(make_function_layout<T>(version), std::forward<Range>(bits));
+    }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
@@ -24,12 +24,13 @@
 #pragma once
 
 #include <algorithm>
+#include <limits>
 #include <ranges>
+#include <span>
 
 #include <qrcode/qr/penalty_weight.h>
+#include <qrcode/qr/static_segments.h>
 
-#include <qrcode/structure/element_view.h>
-#include <qrcode/structure/horizontal_view.h>
 #include <qrcode/structure/matrix.h>
 
 namespace qrcode::qr::detail
@@ -66,24 +67,103 @@ namespace qrcode::qr::detail
         }
         return score;
     }
+
+    // calls given function with the first and the last column of every run of 2x2 blocks of
+    // rows y and y+1 which consist of static modules only
+    template<class Function>
+    constexpr auto for_each_static_block_run(static_segments const& segments, int y, Function&& function)
+    {
+        auto const whole = std::array{static_segment{.begin = 0, .end = width(size(segments))}};
+        auto const line = [&](int i)
+        {
+            return is_fixed_row(segments, i) ? std::span<static_segment const>{whole} : row_segments(segments, i);
+        };
+
+        auto const upper = line(y);
+        auto const lower = line(y+1);
+        for (auto i = begin(upper), j = begin(lower); i != end(upper) && j != end(lower);)
+        {
+            auto const first = std::max(i->begin, j->begin);
+            auto const last = std::min(i->end, j->end) - 1;
+            if (last > first)
+                function(first, last);
+
+            if (i->end < j->end)
+                ++i;
+            else
+                ++j;
+        }
+    }
 }   
 
 namespace qrcode::qr
 {
     using qrcode::structure::matrix;
 
-    template<class T>
-    [[nodiscard]] constexpr auto same_color_score(matrix<T> const& matrix)
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto same_color_score(
+        matrix<T, Capacity> const& matrix, int budget = std::numeric_limits<int>::max())
+    {
+        using qrcode::qr::detail::same_2x2_score;
+
+        auto score = 0;
+        for (auto y = 0; y != height(matrix)-1 && score < budget; ++y)
+        {
+            score += same_2x2_score(row(matrix, y+0), row(matrix, y+1));
+        }
+        return score;
+    }
+
+    // penalty of the 2x2 blocks which only consist of function modules
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto static_same_color_score(
+        matrix<T, Capacity> const& code, static_segments const& segments) noexcept
     {
+        using qrcode::qr::detail::for_each_static_block_run;
         using qrcode::qr::detail::same_2x2_score;
 
         auto score = 0;
-        for (auto y = 0; y != height(matrix)-1; ++y)
+        for (auto y = 0; y != height(code)-1; ++y)
         {
-            auto line_1 = views::horizontal({0,y+0}, {width(matrix),1}) | views::element(matrix);
-            auto line_2 = views::horizontal({0,y+1}, {width(matrix),1}) | views::element(matrix);
+            for_each_static_block_run(segments, y, [&](int first, int last)
+            {
+                auto const length = static_cast<std::size_t>(last - first + 1);
+                score += same_2x2_score(row(code, y).subspan(first, length), row(code, y+1).subspan(first, length));
+            });
+        }
+        return score;
+    }
+
+    // same color score of the blocks with data modules, the static same color score adds the rest
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto same_color_score(
+        matrix<T, Capacity> const& matrix, static_segments const& segments, 
+        int budget = std::numeric_limits<int>::max())
+    {
+        using qrcode::qr::detail::for_each_static_block_run;
+        using qrcode::qr::detail::same_2x2_score;
 
-            score += same_2x2_score(line_1, line_2);
+        auto score = 0;
+        for (auto y = 0; y != height(matrix)-1 && score < budget; ++y)
+        {
+            auto const upper = row(matrix, y+0);
+            auto const lower = row(matrix, y+1);
+            auto const blocks = [&](int first, int last)
+            {
+                if (last > first)
+                {
+                    auto const length = static_cast<std::size_t>(last - first + 1);
+                    score += same_2x2_score(upper.subspan(first, length), lower.subspan(first, length));
+                }
+            };
+
+            auto next = 0;
+            for_each_static_block_run(segments, y, [&](int first, int last)
+            {
+                blocks(next, first);
+                next = last;
+            });
+            blocks(next, width(matrix)-1);
         }
         return score;
     }
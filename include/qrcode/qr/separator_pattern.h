@@ -33,8 +33,8 @@ namespace qrcode::qr
 {
     using qrcode::structure::matrix;
 
-    template<class T>
-    [[nodiscard]] constexpr auto place_separator_patterns(matrix<T>& matrix)
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto place_separator_patterns(matrix<T, Capacity>& matrix)
     {
         auto const finder_positions = finder_locations(size(matrix));
         auto const finder = finder_pattern{};
@@ -0,0 +1,219 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include <qrcode/qr/adjacent_score.h>
+#include <qrcode/qr/finder_like_score.h>
+#include <qrcode/qr/same_color_score.h>
+#include <qrcode/qr/static_segments.h>
+#include <qrcode/qr/symbol_version.h>
+
+#include <qrcode/structure/matrix.h>
+
+namespace qrcode::qr
+{
+    using qrcode::structure::matrix;
+
+    // the function patterns of a version as seen by the penalty rules: the static segments of every
+    // line and the penalty lying entirely within the function patterns, which is the same for all masks
+    struct static_penalty
+    {
+        static_segments segments{};
+        int score = 0;
+    };
+
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto make_static_penalty(matrix<T, Capacity> const& code) noexcept
+    {
+        auto penalty = static_penalty{static_segments{code}};
+        penalty.score = static_adjacent_score(code, penalty.segments)
+            + static_same_color_score(code, penalty.segments)
+            + static_finder_like_score(code, penalty.segments);
+        return penalty;
+    }
+}
+
+namespace qrcode::qr::detail
+{
+    struct static_penalty_cache_entries
+    {
+        std::array<static_penalty, 40> penalties;
+        std::array<std::once_flag, 40> initialized;
+    };
+
+    [[nodiscard]] inline auto static_penalty_cache() -> static_penalty_cache_entries&
+    {
+        static auto cache = static_penalty_cache_entries{};
+        return cache;
+    }
+
+    // like the mask planes, the function patterns are only scanned from the first code of each version
+    template<class T, int Capacity>
+    [[nodiscard]] auto cached_static_penalty(
+        symbol_version version, matrix<T, Capacity> const& code) -> static_penalty const&
+    {
+        auto& [penalties, initialized] = static_penalty_cache();
+
+        auto const index = version.number - 1;
+        std::call_once(initialized[index], [&] { penalties[index] = make_static_penalty(code); });
+        return penalties[index];
+    }
+}
+
+namespace qrcode::qr
+{
+    // hands the static penalty of given code to given function, at runtime it is cached per version
+    template<class T, int Capacity, class Function>
+    constexpr auto with_static_penalty(
+        symbol_version version, matrix<T, Capacity> const& code, Function&& function) noexcept
+    {
+        using qrcode::qr::detail::cached_static_penalty;
+
+        if (std::is_constant_evaluated())
+        {
+            auto const penalty = make_static_penalty(code);
+            return std::forward<Function>(function)(penalty);
+        }
+        return std::forward<Function>(function)(cached_static_penalty(version, code));
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
+#include <tuple>
+#include <qrcode/qr/mask_pattern.h>
+#include <qrcode/structure/make_matrix.h>
+
+namespace qrcode::qr::test
+{
+    constexpr auto static_segments_cover_the_function_patterns_of_lines_with_data_modules()
+    {
+        using qrcode::structure::make_matrix;
+        using namespace std::literals;
+
+        constexpr auto any_code = make_matrix<char>({7,4},
+            "**-+,*-"
+            "*-*--**"
+            "+,-*-,+"
+            "--*-*,-"sv
+        );
+        constexpr auto segments = static_segments{any_code};
+        constexpr auto boundaries = [](static_segment const& s) { return std::tuple{s.begin, s.end, s.bits, s.leading, s.trailing}; };
+        constexpr auto equal = [=](auto const& a, auto const& b) { return std::ranges::equal(a, b, {}, boundaries, boundaries); };
+
+        static_assert(!is_fixed_row(segments, 0) && is_fixed_row(segments, 1));
+        static_assert(equal(row_segments(segments, 0), std::array{
+            static_segment{.begin = 0, .end = 3, .bits = 0b110, .leading = 2, .trailing = 1},
+            static_segment{.begin = 5, .end = 7, .bits = 0b10, .leading = 1, .trailing = 1}
+        }));
+        static_assert(row_segments(segments, 1).empty());
+        static_assert(equal(row_segments(segments, 2), std::array{
+            static_segment{.begin = 2, .end = 5, .bits = 0b010, .leading = 1, .trailing = 1}
+        }));
+        static_assert(equal(row_segments(segments, 3), std::array{
+            static_segment{.begin = 0, .end = 5, .bits = 0b00101, .leading = 2, .trailing = 1}
+        }));
+        static_assert(is_fixed_column(segments, 2) && !is_fixed_column(segments, 4));
+        static_assert(equal(column_segments(segments, 0), std::array{
+            static_segment{.begin = 0, .end = 2, .bits = 0b11, .leading = 2, .trailing = 2}
+        }));
+        static_assert(equal(column_segments(segments, 3), std::array{
+            static_segment{.begin = 1, .end = 4, .bits = 0b010, .leading = 1, .trailing = 1}
+        }));
+    }
+
+    constexpr auto static_segments_know_where_finder_like_patterns_may_end_and_which_they_contain()
+    {
+        using qrcode::structure::make_matrix;
+        using namespace std::literals;
+
+        constexpr auto any_code = make_matrix<char>({13,2},
+            "*-***-*++,+,+"
+            "----*-***-*+,"sv
+        );
+        constexpr auto segments = static_segments{any_code};
+
+        static_assert(row_segments(segments, 0)[0].finder_candidates == 0b100'0101);
+        static_assert(row_segments(segments, 0)[0].finder_matches == 0);
+        static_assert(row_segments(segments, 1)[0].finder_matches == 0b001);
+    }
+
+    constexpr auto static_penalty_and_the_scores_of_the_data_modules_add_up_to_the_penalty_score()
+    {
+        using qrcode::structure::make_matrix;
+        using namespace std::literals;
+
+        auto f = []
+        {
+            auto const any_code = make_matrix<char>({21,21},
+                "*******--,,+,-*******"
+                "*-----*--,++,-*-----*"
+                "*-***-*--+,,+-*-***-*"
+                "*-***-*--,,,+-*-***-*"
+                "*-***-*--+++,-*-***-*"
+                "*-----*--+,,,-*-----*"
+                "*******-*-*-*-*******"
+                "---------+,+,--------"
+                "------*--,,,,--------"
+                "+,,,,+-++++,,,,,,+,,,"
+                "+,++,,*+,,,+++,+++,++"
+                "+,,++,-,,,,,+,,,++,,,"
+                "+,,,++*+++,+++,++,+,,"
+                "--------*+++,+++,+,,,"
+                "*******--,+,,,+,,,+,,"
+                "*-----*--+++,+++,,,,+"
+                "*-***-*--+,,,,,,,+,,,"
+                "*-***-*--,,,,,,,,,+,,"
+                "*-***-*--+++++,++,,,,"
+                "*-----*--+,,+,,,+,,+,"
+                "*******--,++++,++,,,,"sv
+            );
+            auto const penalty = make_static_penalty(any_code);
+            auto const& segments = penalty.segments;
+
+            for (auto const& mask : available_masks())
+            {
+                auto const masked = mask(any_code);
+                if (adjacent_score(masked) != 
+                        adjacent_score(masked, segments) + static_adjacent_score(any_code, segments))
+                    return false;
+                if (same_color_score(masked) != 
+                        same_color_score(masked, segments) + static_same_color_score(any_code, segments))
+                    return false;
+                if (finder_like_score(masked) != 
+                        finder_like_score(masked, segments) + static_finder_like_score(any_code, segments))
+                    return false;
+            }
+            return penalty.score == static_adjacent_score(any_code, segments) 
+                + static_same_color_score(any_code, segments) + static_finder_like_score(any_code, segments);
+        };
+        static_assert(f());
+    }
+}
+#endif
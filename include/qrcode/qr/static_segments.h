@@ -0,0 +1,207 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <ranges>
+#include <span>
+
+#include <cx/vector.h>
+
+#include <qrcode/qr/finder_like_pattern.h>
+#include <qrcode/qr/symbol_version.h>
+
+#include <qrcode/structure/dimension.h>
+#include <qrcode/structure/matrix.h>
+#include <qrcode/structure/module_traits.h>
+
+namespace qrcode::qr
+{
+    using qrcode::structure::dimension;
+    using qrcode::structure::matrix;
+
+    // modules of a row or column which are the same for every mask, the first module is the highest bit;
+    // leading and trailing are the runs of one color the segment begins and ends with. A finder like
+    // pattern may end at the candidate modules, depending on the modules before the segment; the
+    // patterns which lie inside of the segment are matched in advance (bit i for pattern i).
+    struct static_segment
+    {
+        static constexpr auto max_length = 64;
+
+        int begin = 0;
+        int end = 0;
+        std::uint64_t bits = 0;
+        int leading = 0;
+        int trailing = 0;
+        unsigned finder_candidates = 0;
+        unsigned finder_matches = 0;
+
+        [[nodiscard]] constexpr auto operator==(static_segment const&) const noexcept -> bool = default;
+    };
+
+    [[nodiscard]] constexpr auto length(static_segment const& segment) noexcept
+    {
+        return segment.end - segment.begin;
+    }
+
+    [[nodiscard]] constexpr auto first_module(static_segment const& segment) noexcept
+    {
+        return ((segment.bits >> (length(segment) - 1)) & 1) != 0;
+    }
+
+    [[nodiscard]] constexpr auto last_module(static_segment const& segment) noexcept
+    {
+        return (segment.bits & 1) != 0;
+    }
+
+    // static segments of all rows and columns of a symbol, derived from the function patterns of its
+    // code. Lines without any data module are fixed and have no segments, they are scored just once.
+    class static_segments
+    {
+        static constexpr auto max_lines = 2 * width(size(symbol_version{40}));
+
+    public:
+        // static stretches shorter than this are scanned along with the data modules around them
+        static constexpr auto min_length = 2;
+        static constexpr auto max_segments = 512;
+
+        constexpr static_segments() noexcept = default;
+
+        template<class T, int Capacity>
+        explicit constexpr static_segments(matrix<T, Capacity> const& code) noexcept
+        : extend{size(code)}
+        {
+            assert(width(code) <= max_lines / 2 && height(code) <= max_lines / 2);
+            for (auto y = 0; y != height(code); ++y)
+                add_line<T>(y, row(code, y));
+            for (auto x = 0; x != width(code); ++x)
+                add_line<T>(height(code) + x, column(code, x));
+        }
+
+        [[nodiscard]] friend constexpr auto size(static_segments const& segments) noexcept
+        {
+            return segments.extend;
+        }
+
+        [[nodiscard]] friend constexpr auto is_fixed_row(static_segments const& segments, int y) noexcept
+        {
+            return segments.fixed[y];
+        }
+
+        [[nodiscard]] friend constexpr auto is_fixed_column(static_segments const& segments, int x) noexcept
+        {
+            return segments.fixed[height(segments.extend) + x];
+        }
+
+        [[nodiscard]] friend constexpr auto row_segments(static_segments const& segments, int y) noexcept
+            -> std::span<static_segment const>
+        {
+            return segments.line(y);
+        }
+
+        [[nodiscard]] friend constexpr auto column_segments(static_segments const& segments, int x) noexcept
+            -> std::span<static_segment const>
+        {
+            return segments.line(height(segments.extend) + x);
+        }
+
+    private:
+        [[nodiscard]] constexpr auto line(int index) const noexcept -> std::span<static_segment const>
+        {
+            return {segments.begin() + offsets[index], segments.begin() + offsets[index+1]};
+        }
+
+        template<class T, std::ranges::random_access_range Line>
+        constexpr auto add_line(int index, Line&& line) noexcept
+        {
+            using qrcode::structure::module_traits;
+
+            auto const modules = std::ranges::begin(line);
+            auto const line_length = static_cast<int>(std::ranges::size(line));
+            auto const add_segments = [&](int first, int last)
+            {
+                if (last - first < min_length)
+                    return;
+                for (; first < last; first += static_segment::max_length)
+                    segments.push_back(make_segment<T>(modules, first, std::min(last, first + static_segment::max_length)));
+            };
+
+            offsets[index] = static_cast<int>(segments.size());
+
+            auto first = 0;
+            for (auto i = 0; i != line_length; ++i)
+            {
+                if (!module_traits<T>::is_data(modules[i]))
+                    continue;
+                add_segments(first, i);
+                first = i + 1;
+            }
+
+            fixed[index] = first == 0;
+            if (!fixed[index])
+                add_segments(first, line_length);
+
+            offsets[index+1] = static_cast<int>(segments.size());
+        }
+
+        template<class T, class Iterator>
+        [[nodiscard]] static constexpr auto make_segment(Iterator modules, int first, int last) noexcept
+        {
+            using qrcode::structure::module_traits;
+
+            auto const is_set = [&](int i) { return module_traits<T>::is_set(modules[i]); };
+
+            auto segment = static_segment{first, last};
+            for (auto i = first; i != last; ++i)
+                segment.bits = (segment.bits << 1) | (is_set(i) ? 1u : 0u);
+
+            while (first + segment.leading != last && is_set(first + segment.leading) == is_set(first))
+                ++segment.leading;
+            while (last - 1 - segment.trailing >= first && is_set(last - 1 - segment.trailing) == is_set(last - 1))
+                ++segment.trailing;
+
+            // the modules of the segment up to j are the latest ones of the window at j
+            for (auto j = 0; j != last - first; ++j)
+            {
+                auto const window = static_cast<unsigned>((segment.bits >> (last - first - 1 - j)) & 0x7fff);
+                for (auto i = 0u; i != finder_like_patterns.size(); ++i)
+                {
+                    auto const pattern = finder_like_patterns[i];
+                    if (j + 1 >= pattern.length && matches(pattern, window))
+                        segment.finder_matches |= 1u << i;
+                    if (j + 1 < pattern.length && matches({pattern.bits & ((1u << (j+1)) - 1), j+1}, window))
+                        segment.finder_candidates |= 1u << j;
+                }
+            }
+            return segment;
+        }
+
+        dimension extend{0,0};
+        cx::vector<static_segment, max_segments> segments{};
+        std::array<int, max_lines + 1> offsets{};
+        std::array<bool, max_lines> fixed{};
+    };
+}
@@ -0,0 +1,96 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <optional>
+
+#include <qrcode/static_packed_symbol.h>
+#include <qrcode/qr/fit_version.h>
+#include <qrcode/qr/qr.h>
+
+namespace qrcode::qr::detail
+{
+    template<fixed_string Message, error_correction Level>
+    inline constexpr auto static_version = fit_version(Message.view(), Level);
+}
+
+namespace qrcode::qr
+{
+    // the symbol is generated while compiling, a constant of it is placed in read-only data
+    //
+    // example:
+    //
+    // constexpr auto& homepage = qrcode::qr::static_symbol<"https://example.com", qrcode::qr::error_correction::level_Q>;
+    // svg(file, homepage);
+    //
+    template<fixed_string Message, error_correction Level = error_correction::level_M>
+    [[nodiscard]] consteval auto make_static_symbol() noexcept
+    {
+        constexpr auto version = detail::static_version<Message, Level>;
+        static_assert(version.has_value(), "the message does not fit into any symbol version");
+
+        constexpr auto side = width(size(*version));
+        return pack_static<side>(make_symbol<version->number, char>(Message.view(), Level).value());
+    }
+
+    template<fixed_string Message, error_correction Level = error_correction::level_M>
+    inline constexpr auto static_symbol = make_static_symbol<Message, Level>();
+
+    namespace literals
+    {
+        // "https://example.com"_qr is the same constant as static_symbol<"https://example.com">
+        template<fixed_string Message>
+        [[nodiscard]] consteval auto& operator""_qr() noexcept
+        {
+            return static_symbol<Message>;
+        }
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+namespace qrcode::qr::test
+{
+    constexpr auto static_symbols_unpack_to_the_generated_symbol()
+    {
+        using namespace std::literals;
+        constexpr auto& any_symbol = static_symbol<"HELLO WORLD", error_correction::level_Q>;
+        static_assert(size(any_symbol) == dimension{21,21});
+        static_assert(unpack<char>(any_symbol) == make_symbol<char>("HELLO WORLD"sv, error_correction::level_Q).value());
+    }
+
+    constexpr auto static_symbols_are_packed_row_by_row()
+    {
+        constexpr auto& any_symbol = static_symbol<"01234567">;
+        static_assert((row(any_symbol, 0)[0] & 0x7f) == 0x7f);
+        static_assert((row(any_symbol, 0)[0] >> 7 & 1) == 0);
+        static_assert(is_set(any_symbol, {0,6}) && !is_set(any_symbol, {1,5}));
+    }
+
+    constexpr auto static_symbols_can_be_made_from_literals()
+    {
+        using namespace literals;
+        static_assert(&"01234567"_qr == &static_symbol<"01234567">);
+    }
+}
+#endif
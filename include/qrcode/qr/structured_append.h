@@ -0,0 +1,231 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <concepts>
+#include <optional>
+#include <ranges>
+#include <vector>
+
+#include <cx/vector.h>
+
+#include <qrcode/result.h>
+#include <qrcode/symbol.h>
+
+#include <qrcode/data/structured_append.h>
+#include <qrcode/eci/view.h>
+#include <qrcode/pipeline/worker_thread.h>
+#include <qrcode/qr/qr.h>
+
+namespace qrcode::qr
+{
+    using qrcode::data::structured_append;
+    using qrcode::data::max_structured_append_symbols;
+
+    // a single symbol of a structured append sequence in the smallest version the part fits into
+    template<class Module = module, std::ranges::forward_range Message>
+    requires std::convertible_to<std::ranges::range_value_t<Message>, char>
+    [[nodiscard]] constexpr auto make_symbol(
+        Message&& message, error_correction error_level, structured_append const& sequence) noexcept
+    {
+        using symbol_type = symbol<Module, symbol_designator>;
+
+        auto const version = fit_version(message, error_level, sequence);
+        if (!version)
+            return result<symbol_type>{error_code::data_too_large};
+
+        auto const designator = symbol_designator{*version, error_level};
+        auto const stream = encode_data(std::forward<Message>(message), make_version_category(*version), sequence);
+        return result{finalize(
+            make_raw_code<Module>(
+                *version, 
+                code_bits(stream.get(), make_code_capacity(designator))),
+            designator
+        )};
+    }
+}
+
+namespace qrcode::qr::detail
+{
+    // parts of an eci message keep its header
+    template<class Message, class Iterator>
+    [[nodiscard]] constexpr auto message_part(Message const& message, Iterator first, Iterator last) noexcept
+    {
+        auto part = std::ranges::subrange{first, last};
+        if constexpr (is_eci_view_v<std::decay_t<Message>>)
+            return eci::view{header(message).eci_assignment_number, part};
+        else
+            return part;
+    }
+
+    template<class Message>
+    [[nodiscard]] constexpr auto message_part(Message const& message, int first, int last) noexcept
+    {
+        using std::ranges::begin;
+        return message_part(
+            message, std::ranges::next(begin(message), first), std::ranges::next(begin(message), last));
+    }
+
+    using part_offsets = cx::vector<int, max_structured_append_symbols + 1>;
+
+    // greedy: every part takes as many bytes as fit into the largest allowed version
+    template<std::ranges::forward_range Message>
+    [[nodiscard]] constexpr auto split_message(
+        Message const& message, error_correction error_level, symbol_version max_version) noexcept
+    {
+        using result_type = std::optional<part_offsets>;
+
+        auto const fits = [&](int first, int last)
+        {
+            auto const version = fit_version(message_part(message, first, last), error_level, structured_append{});
+            return version && version->number <= max_version.number;
+        };
+
+        auto const total = static_cast<int>(std::ranges::distance(message));
+        auto offsets = part_offsets{};
+        offsets.push_back(0);
+        while (offsets.back() != total)
+        {
+            if (static_cast<int>(offsets.size()) > max_structured_append_symbols)
+                return result_type{};
+
+            // the data length grows with the part, so the longest fitting part can be bisected
+            auto const first = offsets.back();
+            auto low = 0;
+            auto high = total - first;
+            while (low < high)
+            {
+                auto const middle = (low + high + 1) / 2;
+                if (fits(first, first + middle))
+                    low = middle;
+                else
+                    high = middle - 1;
+            }
+
+            if (low == 0)
+                return result_type{};
+            offsets.push_back(first + low);
+        }
+        return result_type{offsets};
+    }
+}
+
+namespace qrcode::qr
+{
+    // messages which do not fit into a single symbol up to given version are split into a structured append
+    // sequence of at most 16 symbols, which are generated concurrently
+    template<class Module = module, std::ranges::forward_range Message>
+    requires std::convertible_to<std::ranges::range_value_t<Message>, char>
+    [[nodiscard]] auto make_symbols(
+        Message&& message, error_correction error_level, symbol_version max_version = symbol_version{40})
+    {
+        using qrcode::data::structured_append_parity;
+        using qrcode::qr::detail::message_part;
+        using qrcode::qr::detail::split_message;
+        using symbol_type = symbol<Module, symbol_designator>;
+        using result_type = result<std::vector<symbol_type>>;
+
+        if (auto const version = fit_version(message, error_level); version && version->number <= max_version.number)
+            return result_type{std::vector{qr::make_symbol<Module>(message, *version, error_level).value()}};
+
+        auto const offsets = split_message(message, error_level, max_version);
+        if (!offsets)
+            return result_type{error_code::data_too_large};
+
+        auto const parity = structured_append_parity(message);
+        auto const symbol_count = static_cast<int>(offsets->size()) - 1;
+
+        // every part gets a worker with a stack large enough for a symbol of the highest version
+        auto parts = std::vector<std::optional<symbol_type>>(symbol_count);
+        {
+            auto workers = std::vector<qrcode::pipeline::worker_thread>{};
+            workers.reserve(symbol_count);
+            for (auto i = 0; i != symbol_count; ++i)
+                workers.emplace_back([&, i]
+                {
+                    auto const sequence = structured_append{
+                        .position = i, .symbol_count = symbol_count, .parity = parity};
+                    auto const part = message_part(message, (*offsets)[i], (*offsets)[i+1]);
+                    parts[i] = qr::make_symbol<Module>(part, error_level, sequence).value();
+                });
+        }
+
+        auto symbols = std::vector<symbol_type>{};
+        symbols.reserve(parts.size());
+        for (auto& i : parts)
+            symbols.push_back(std::move(*i));
+        return result_type{std::move(symbols)};
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
+#include <qrcode/qr/decode.h>
+
+namespace qrcode::qr::detail::test
+{
+    constexpr auto split_message_fills_every_symbol_up_to_the_largest_allowed_version()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            // version 1-H holds 72 data bits: 20 header bits, 13 indicator bits and 7 alphanumeric characters
+            auto const offsets = split_message("ABCDEFGHIJKLMNOPQRSTU"sv, error_correction::level_H, symbol_version{1});
+            return offsets && std::ranges::equal(*offsets, std::array{0, 7, 14, 21});
+        };
+        static_assert(f());
+    }
+
+    constexpr auto split_message_returns_nothing_if_more_than_16_symbols_are_needed()
+    {
+        auto f = [](auto length)
+        {
+            auto const message = cx::vector<char>(length, 'A');
+            return split_message(message, error_correction::level_H, symbol_version{1}).has_value();
+        };
+        static_assert(f(16 * 7));
+        static_assert(!f(16 * 7 + 1));
+    }
+}
+
+namespace qrcode::qr::test
+{
+    constexpr auto structured_append_symbols_carry_their_sequence_header()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            constexpr auto any_sequence = structured_append{.position = 1, .symbol_count = 3, .parity = 0x42};
+
+            auto const s = make_symbol<char>("HIJKLMN"sv, error_correction::level_H, any_sequence).value();
+            auto const decoded = decode(modules(s));
+            return designator(s) == symbol_designator{symbol_version{1}, error_correction::level_H}
+                && decoded 
+                && decoded->data.structured_append_header == any_sequence
+                && std::ranges::equal(decoded->data.message, "HIJKLMN"sv);
+        };
+        static_assert(f());
+    }
+}
+#endif
@@ -0,0 +1,195 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+
+#include <qrcode/packed_symbol.h>
+#include <qrcode/result.h>
+
+#include <qrcode/cache/fnv_hash.h>
+#include <qrcode/cache/sharded_cache.h>
+#include <qrcode/eci/view.h>
+#include <qrcode/qr/qr.h>
+
+namespace qrcode::qr
+{
+    // the module type is not part of the key: cached symbols are packed and unpacked to any module type
+    struct symbol_key
+    {
+        std::string message;
+        std::optional<std::int32_t> eci_assignment_number;
+        error_correction error_level{error_correction::level_L};
+        std::optional<symbol_version> version;
+
+        [[nodiscard]] auto operator==(symbol_key const&) const noexcept -> bool = default;
+        [[nodiscard]] auto operator!=(symbol_key const&) const noexcept -> bool = default;
+    };
+}
+
+namespace qrcode::qr::detail
+{
+    [[nodiscard]] constexpr auto hash_symbol_key(
+        std::string_view message, 
+        std::optional<std::int32_t> eci_assignment_number, 
+        error_correction error_level, 
+        std::optional<symbol_version> version) noexcept
+    {
+        using qrcode::cache::fnv_hash;
+
+        auto const eci = eci_assignment_number.value_or(-1);
+        auto const parameters = std::array<std::uint8_t, 6>{
+            static_cast<std::uint8_t>(eci), 
+            static_cast<std::uint8_t>(eci >> 8), 
+            static_cast<std::uint8_t>(eci >> 16),
+            static_cast<std::uint8_t>(eci >> 24),
+            static_cast<std::uint8_t>(number(error_level)),
+            static_cast<std::uint8_t>(version ? version->number : 0)
+        };
+        return fnv_hash(parameters, fnv_hash(message));
+    }
+
+    struct symbol_key_hash
+    {
+        [[nodiscard]] auto operator()(symbol_key const& key) const noexcept
+        {
+            return static_cast<std::size_t>(hash_symbol_key(
+                key.message, key.eci_assignment_number, key.error_level, key.version));
+        }
+    };
+
+    template<std::ranges::forward_range Message>
+    [[nodiscard]] auto make_symbol_key(
+        Message const& message, std::optional<symbol_version> version, error_correction error_level)
+    {
+        using qrcode::cache::detail::octet;
+
+        auto key = symbol_key{{}, std::nullopt, error_level, version};
+        for (auto i : message)
+            key.message.push_back(static_cast<char>(octet(i)));
+        if constexpr (is_eci_view_v<std::remove_cvref_t<Message>>)
+            key.eci_assignment_number = header(message).eci_assignment_number.value;
+        return key;
+    }
+}
+
+namespace qrcode::qr
+{
+    using cached_symbol = std::shared_ptr<packed_symbol<symbol_designator> const>;
+    using qrcode::cache::cache_statistics;
+
+    // thread-safe, generated symbols are immutable and shared by all callers asking for the same key
+    template<int Shard_Count = 16>
+    class symbol_cache
+    {
+    public:
+        static constexpr auto default_capacity = std::size_t{16} << 20;
+
+        explicit symbol_cache(std::size_t max_bytes = default_capacity) noexcept
+        : symbols{max_bytes}
+        {
+        }
+
+        template<std::ranges::forward_range Message>
+        requires std::convertible_to<std::ranges::range_value_t<Message>, char>
+        [[nodiscard]] auto make_symbol(
+            Message&& message, symbol_version version, error_correction error_level) -> result<cached_symbol>
+        {
+            return find_or_make(message, version, error_level, [&]
+            {
+                return qr::make_symbol(std::forward<Message>(message), version, error_level);
+            });
+        }
+
+        template<std::ranges::forward_range Message>
+        requires std::convertible_to<std::ranges::range_value_t<Message>, char>
+        [[nodiscard]] auto make_symbol(
+            Message&& message, error_correction error_level) -> result<cached_symbol>
+        {
+            return find_or_make(message, std::nullopt, error_level, [&]
+            {
+                return qr::make_symbol(std::forward<Message>(message), error_level);
+            });
+        }
+
+        [[nodiscard]] friend auto statistics(symbol_cache const& cache) noexcept
+        {
+            return statistics(cache.symbols);
+        }
+
+    private:
+        // failures are not cached, they are cheap to detect again
+        template<class Message, class Make>
+        [[nodiscard]] auto find_or_make(
+            Message const& message, 
+            std::optional<symbol_version> version, 
+            error_correction error_level, 
+            Make make) -> result<cached_symbol>
+        {
+            using qrcode::qr::detail::make_symbol_key;
+
+            auto key = make_symbol_key(message, version, error_level);
+            if (auto cached = symbols.find(key))
+                return result{std::move(cached)};
+
+            auto const generated = make();
+            if (!generated)
+                return result<cached_symbol>{generated.error()};
+
+            auto packed = std::make_shared<packed_symbol<symbol_designator> const>(pack(generated.value()));
+            // the key is held twice, by its slot and by the index of the shard
+            auto const weight = byte_size(*packed) + 2 * (sizeof(symbol_key) + size(key.message));
+            return result{symbols.insert(std::move(key), std::move(packed), weight)};
+        }
+
+        using key_hash = qrcode::qr::detail::symbol_key_hash;
+        qrcode::cache::sharded_cache<symbol_key, packed_symbol<symbol_designator>, key_hash, Shard_Count> symbols;
+    };
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+namespace qrcode::qr::detail::test
+{
+    constexpr auto hash_symbol_key_differs_for_every_part_of_the_key()
+    {
+        using namespace std::literals;
+
+        constexpr auto any_hash = hash_symbol_key("ABC"sv, std::nullopt, error_correction::level_M, std::nullopt);
+
+        static_assert(hash_symbol_key("ABC"sv, std::nullopt, error_correction::level_M, std::nullopt) == any_hash);
+        static_assert(hash_symbol_key("ABD"sv, std::nullopt, error_correction::level_M, std::nullopt) != any_hash);
+        static_assert(hash_symbol_key("ABC"sv, 26, error_correction::level_M, std::nullopt) != any_hash);
+        static_assert(hash_symbol_key("ABC"sv, std::nullopt, error_correction::level_Q, std::nullopt) != any_hash);
+        static_assert(hash_symbol_key("ABC"sv, std::nullopt, error_correction::level_M, symbol_version{2}) != any_hash);
+    }
+}
+#endif
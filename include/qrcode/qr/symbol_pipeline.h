@@ -0,0 +1,400 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <qrcode/result.h>
+#include <qrcode/symbol.h>
+
+#include <qrcode/pipeline/bounded_queue.h>
+#include <qrcode/pipeline/worker_thread.h>
+#include <qrcode/qr/qr.h>
+
+namespace qrcode::qr
+{
+    enum class pipeline_stage { encode, code_bits, place, mask, render };
+
+    inline constexpr auto pipeline_stage_count = 5;
+
+    struct pipeline_options
+    {
+        // capacity of each queue between two stages, a full queue holds back the stage before
+        std::size_t queue_capacity = 64;
+        // worker threads of every stage, results come out of order if any stage has more than one
+        std::array<int, pipeline_stage_count> threads{1, 1, 1, 1, 1};
+        // every worker thread is bound to its own cpu (linux only)
+        bool pin_threads = false;
+        // stack of every worker thread, generating a symbol of a large version takes about 2 MB
+        std::size_t stack_size = qrcode::pipeline::default_stack_size;
+    };
+
+    struct keep_symbol
+    {
+        template<class Symbol>
+        [[nodiscard]] constexpr auto operator()(Symbol symbol) const noexcept
+        {
+            return symbol;
+        }
+    };
+}
+
+namespace qrcode::qr::detail
+{
+    using qrcode::structure::matrix;
+
+    // one message on its way through the stages, every stage consumes what the one before produced;
+    // items are large, so they are allocated once and the queues only pass on pointers to them
+    template<class Module>
+    struct pipeline_item
+    {
+        std::size_t index = 0;
+        std::string message{};
+        std::optional<symbol_designator> designator{};
+        std::vector<bool> bits{};
+        matrix<Module> code{{0,0}};
+        std::optional<symbol<Module, symbol_designator>> masked{};
+    };
+
+    template<std::ranges::input_range Bits>
+    [[nodiscard]] constexpr auto collect_bits(Bits&& bits)
+    {
+        auto collected = std::vector<bool>{};
+        for (bool i : bits)
+            collected.push_back(i);
+        return collected;
+    }
+
+    // messages which fit into no version leave the item without designator, later stages pass it on
+    template<class Module>
+    constexpr auto encode_stage(pipeline_item<Module>& item, error_correction error_level)
+    {
+        auto const version = fit_version(item.message, error_level);
+        if (!version)
+            return;
+
+        item.designator = symbol_designator{*version, error_level};
+        item.bits = collect_bits(encode_data(item.message, make_version_category(*version)).get());
+        item.message = std::string{};
+    }
+
+    template<class Module>
+    constexpr auto code_bits_stage(pipeline_item<Module>& item)
+    {
+        if (item.designator)
+            item.bits = collect_bits(code_bits(item.bits, make_code_capacity(*item.designator)));
+    }
+
+    template<class Module>
+    constexpr auto place_stage(pipeline_item<Module>& item)
+    {
+        if (!item.designator)
+            return;
+
+        item.code = make_raw_code<Module>(version(*item.designator), item.bits);
+        item.bits = std::vector<bool>{};
+    }
+
+    template<class Module>
+    constexpr auto mask_stage(pipeline_item<Module>& item)
+    {
+        if (item.designator)
+            item.masked = finalize(std::move(item.code), *item.designator);
+    }
+
+    inline auto pin_to_cpu([[maybe_unused]] qrcode::pipeline::worker_thread& thread, [[maybe_unused]] unsigned cpu) noexcept
+    {
+#if defined(__linux__)
+        auto cpus = cpu_set_t{};
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+#endif
+    }
+}
+
+namespace qrcode::qr
+{
+    // every stage runs on its own threads and hands its items to the next stage through a bounded
+    // lock-free queue: while one message is masked, the next one is already placed and encoded
+    template<class Module = module, class Render = keep_symbol>
+    class symbol_pipeline
+    {
+    public:
+        using symbol_type = symbol<Module, symbol_designator>;
+        using output_type = std::invoke_result_t<Render const&, symbol_type>;
+
+        struct output
+        {
+            std::size_t index;
+            result<output_type> value;
+        };
+
+        class output_range;
+
+        explicit symbol_pipeline(
+            error_correction error_level, pipeline_options options = {}, Render render = {})
+        : error_level{error_level}
+        , render{std::move(render)}
+        , queues{make_queues(options.queue_capacity)}
+        , outputs{options.queue_capacity}
+        {
+            auto cpu = 0u;
+            auto const cpu_count = std::max(std::thread::hardware_concurrency(), 1u);
+            for (auto stage = 0; stage != pipeline_stage_count; ++stage)
+            {
+                running[stage].store(std::max(options.threads[stage], 1));
+                for (auto i = 0; i != std::max(options.threads[stage], 1); ++i)
+                {
+                    workers.emplace_back([this, stage] { run(static_cast<pipeline_stage>(stage)); }, options.stack_size);
+                    if (options.pin_threads)
+                        qrcode::qr::detail::pin_to_cpu(workers.back(), cpu++ % cpu_count);
+                }
+            }
+        }
+
+        symbol_pipeline(symbol_pipeline const&) = delete;
+        auto operator=(symbol_pipeline const&) -> symbol_pipeline& = delete;
+
+        // stops every stage, results which have not been popped yet are dropped
+        ~symbol_pipeline()
+        {
+            for (auto& i : queues)
+                i->close();
+            outputs.close();
+        }
+
+        // waits while the first stage is busy, returns the index of the message or nothing once closed
+        auto push(std::string message) -> std::optional<std::size_t>
+        {
+            auto item = std::make_unique<item_type>();
+            item->index = next_index.fetch_add(1, std::memory_order_relaxed);
+            item->message = std::move(message);
+            
+            auto const index = item->index;
+            if (!queues.front()->push(std::move(item)))
+                return std::nullopt;
+            return index;
+        }
+
+        // no more messages follow, the stages finish the pending ones
+        auto close() noexcept
+        {
+            queues.front()->close();
+        }
+
+        // waits for the next result; nothing once the pipeline is closed and every message has come out
+        [[nodiscard]] auto pop() -> std::optional<output>
+        {
+            auto result = outputs.pop();
+            if (!result)
+                return std::nullopt;
+            return std::move(**result);
+        }
+
+        // results as they are finished, to be consumed like a generator by a range-based for loop
+        [[nodiscard]] auto results() noexcept
+        {
+            return output_range{*this};
+        }
+
+    private:
+        using item_type = qrcode::qr::detail::pipeline_item<Module>;
+        using queue_type = qrcode::pipeline::bounded_queue<std::unique_ptr<item_type>>;
+
+        // the render stage has no queue of its own, it writes to the outputs
+        using queue_array = std::array<std::unique_ptr<queue_type>, pipeline_stage_count>;
+
+        [[nodiscard]] static auto make_queues(std::size_t capacity)
+        {
+            auto queues = queue_array{};
+            for (auto& i : queues)
+                i = std::make_unique<queue_type>(capacity);
+            return queues;
+        }
+
+        auto run(pipeline_stage stage)
+        {
+            using namespace qrcode::qr::detail;
+
+            auto const index = static_cast<int>(stage);
+            auto& input = *queues[index];
+            while (auto item = input.pop())
+            {
+                auto const forwarded = [&]
+                {
+                    switch (stage)
+                    {
+                        case pipeline_stage::encode: encode_stage(**item, error_level); break;
+                        case pipeline_stage::code_bits: code_bits_stage(**item); break;
+                        case pipeline_stage::place: place_stage(**item); break;
+                        case pipeline_stage::mask: mask_stage(**item); break;
+                        case pipeline_stage::render: 
+                            return outputs.push(std::make_unique<output>(make_output(std::move(**item))));
+                    }
+                    return queues[index + 1]->push(std::move(*item));
+                }();
+
+                if (!forwarded)
+                    break;
+            }
+
+            // the last worker of a stage lets the next stage know that nothing follows
+            if (running[index].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                if (stage == pipeline_stage::render)
+                    outputs.close();
+                else
+                    queues[index + 1]->close();
+            }
+        }
+
+        [[nodiscard]] auto make_output(item_type&& item) const
+        {
+            if (!item.masked)
+                return output{item.index, result<output_type>{error_code::data_too_large}};
+            return output{item.index, result<output_type>{render(std::move(*item.masked))}};
+        }
+
+        error_correction error_level;
+        Render render;
+        std::atomic<std::size_t> next_index{0};
+        std::array<std::atomic<int>, pipeline_stage_count> running{};
+        queue_array queues;
+        qrcode::pipeline::bounded_queue<std::unique_ptr<output>> outputs;
+
+        // declared last, so the workers are joined before the queues go away
+        std::vector<qrcode::pipeline::worker_thread> workers{};
+    };
+
+    template<class Module, class Render>
+    class symbol_pipeline<Module, Render>::output_range
+    {
+    public:
+        class iterator
+        {
+        public:
+            using value_type = output;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() noexcept = default;
+
+            explicit iterator(symbol_pipeline& pipeline)
+            : pipeline{&pipeline}
+            , current{pipeline.pop()}
+            {
+            }
+
+            [[nodiscard]] auto operator*() const -> output const& { return *current; }
+
+            auto operator++() -> iterator&
+            {
+                current = pipeline->pop();
+                return *this;
+            }
+
+            auto operator++(int) { ++*this; }
+
+            [[nodiscard]] friend auto operator==(iterator const& i, std::default_sentinel_t) noexcept
+            {
+                return !i.current.has_value();
+            }
+
+        private:
+            symbol_pipeline* pipeline = nullptr;
+            std::optional<output> current{};
+        };
+
+        explicit output_range(symbol_pipeline& pipeline) noexcept 
+        : pipeline{&pipeline} 
+        {
+        }
+
+        [[nodiscard]] auto begin() const { return iterator{*pipeline}; }
+        [[nodiscard]] auto end() const noexcept { return std::default_sentinel; }
+
+    private:
+        symbol_pipeline* pipeline;
+    };
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
+
+#if defined(__cpp_lib_constexpr_vector) && defined(__cpp_lib_constexpr_string)
+namespace qrcode::qr::detail::test
+{
+    constexpr auto pipeline_stages_make_the_same_symbol_as_make_symbol()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            constexpr auto any_message = "ABRACADABRA"sv;
+            constexpr auto any_error_level = error_correction::level_M;
+
+            auto item = pipeline_item<char>{};
+            item.message = std::string{any_message};
+            encode_stage(item, any_error_level);
+            code_bits_stage(item);
+            place_stage(item);
+            mask_stage(item);
+
+            return item.masked == make_symbol<char>(any_message, any_error_level).value();
+        };
+        static_assert(f());
+    }
+
+    constexpr auto pipeline_stages_pass_on_messages_which_do_not_fit()
+    {
+        auto f = []
+        {
+            auto item = pipeline_item<char>{};
+            item.message = std::string(3000, 'x');
+            encode_stage(item, error_correction::level_H);
+            code_bits_stage(item);
+            place_stage(item);
+            mask_stage(item);
+
+            return !item.designator && !item.masked;
+        };
+        static_assert(f());
+    }
+}
+#endif
+#endif
@@ -31,8 +31,8 @@ namespace qrcode::qr
 {
     using qrcode::structure::matrix;
 
-    template<class T>
-    [[nodiscard]] constexpr auto place_timing_patterns(matrix<T>& matrix) noexcept
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto place_timing_patterns(matrix<T, Capacity>& matrix) noexcept
     {
         auto const timing_location = 6;
         using qrcode::structure::place_horizontal_timing_pattern;
@@ -0,0 +1,129 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <ranges>
+#include <string_view>
+
+#include <qrcode/data/shift_jis.h>
+#include <qrcode/eci/view.h>
+#include <qrcode/qr/qr.h>
+
+namespace qrcode::qr::detail
+{
+    [[nodiscard]] constexpr auto all_ascii(std::string_view message) noexcept
+    {
+        return std::ranges::all_of(message, [](auto c) { return static_cast<std::uint8_t>(c) < 0x80u; });
+    }
+
+    // messages which are shift jis as a whole keep their kanji in kanji mode, 
+    // all others are utf-8 bytes behind an ECI header
+    template<class Message, class Make>
+    [[nodiscard]] constexpr auto make_from_utf8(Message const& message, Make make) noexcept
+    {
+        using qrcode::data::transcode_to_shift_jis;
+        using qrcode::eci::shift_jis_assignment_number;
+        using qrcode::eci::utf8_assignment_number;
+
+        if (auto const transcoded = transcode_to_shift_jis(message))
+        {
+            auto const bytes = std::string_view{transcoded->begin(), transcoded->end()};
+            return all_ascii(bytes) 
+                ? make(bytes) 
+                : make(eci::view{shift_jis_assignment_number, bytes});
+        }
+        return make(eci::view{utf8_assignment_number, message});
+    }
+}
+
+namespace qrcode::qr
+{
+    template<class Module = module, std::ranges::forward_range Message>
+    requires std::convertible_to<std::ranges::range_value_t<Message>, char>
+    [[nodiscard]] constexpr auto make_utf8_symbol(
+        Message const& message, error_correction error_level) noexcept
+    {
+        using qrcode::qr::detail::make_from_utf8;
+        return make_from_utf8(message, [&](auto const& encoded) 
+        { 
+            return make_symbol<Module>(encoded, error_level); 
+        });
+    }
+
+    template<class Module = module, std::ranges::forward_range Message>
+    requires std::convertible_to<std::ranges::range_value_t<Message>, char>
+    [[nodiscard]] constexpr auto make_utf8_symbol(
+        Message const& message, symbol_version version, error_correction error_level) noexcept
+    {
+        using qrcode::qr::detail::make_from_utf8;
+        return make_from_utf8(message, [&](auto const& encoded) 
+        { 
+            return make_symbol<Module>(encoded, version, error_level); 
+        });
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+namespace qrcode::qr::test
+{
+    constexpr auto make_utf8_symbol_encodes_japanese_text_in_kanji_mode()
+    {
+        using namespace std::literals;
+        // "日本語のテキスト" fits into 1-M as shift jis kanji, whereas its utf-8 bytes need version 2
+        constexpr auto utf8 = "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE"
+            "\xE3\x83\x86\xE3\x82\xAD\xE3\x82\xB9\xE3\x83\x88"sv;
+        constexpr auto shift_jis = "\x93\xFA\x96\x7B\x8C\xEA\x82\xCC\x83\x65\x83\x4C\x83\x58\x83\x67"sv;
+        constexpr auto any_error_level = error_correction::level_M;
+
+        constexpr auto s = make_utf8_symbol<char>(utf8, any_error_level);
+        constexpr auto nominal = make_symbol<char>(
+            eci::view{eci::shift_jis_assignment_number, shift_jis}, any_error_level);
+
+        static_assert(s.value() == nominal.value());
+        static_assert(designator(s.value()).version == symbol_version{1});
+    }
+
+    constexpr auto make_utf8_symbol_keeps_ascii_messages_without_eci_header()
+    {
+        using namespace std::literals;
+        constexpr auto any_error_level = error_correction::level_M;
+        static_assert(
+            make_utf8_symbol<char>("ABRACADABRA"sv, any_error_level).value() == 
+            make_symbol<char>("ABRACADABRA"sv, any_error_level).value());
+    }
+
+    constexpr auto make_utf8_symbol_puts_messages_outside_of_shift_jis_into_utf8_bytes()
+    {
+        using namespace std::literals;
+        constexpr auto utf8 = "caf\xC3\xA9 \xE6\x97\xA5"sv;
+        constexpr auto any_version = symbol_version{2};
+        constexpr auto any_error_level = error_correction::level_M;
+        static_assert(
+            make_utf8_symbol<char>(utf8, any_version, any_error_level).value() == 
+            make_symbol<char>(eci::view{eci::utf8_assignment_number, utf8}, any_version, any_error_level).value());
+    }
+}
+#endif
@@ -23,6 +23,10 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <bit>
+#include <optional>
+
 #include <qrcode/qr/symbol_version.h>
 
 #include <qrcode/code/error_correction_code.h>
@@ -90,9 +94,9 @@ namespace qrcode::qr
 {
     using qrcode::structure::matrix;
 
-    template<class T>
+    template<class T, int Capacity>
     [[nodiscard]] constexpr auto place_version_information(
-        matrix<T>& matrix, symbol_version version)
+        matrix<T, Capacity>& matrix, symbol_version version)
     {
         using std::ranges::begin;
         using std::ranges::end;
@@ -122,6 +126,55 @@ namespace qrcode::qr
             *j = function_module;
         }
     }
+
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto read_version_information(matrix<T, Capacity> const& matrix) noexcept
+    {
+        using std::ranges::begin;
+        using std::ranges::end;
+        using qrcode::qr::detail::version_information_bits;
+        using qrcode::qr::detail::vertical_version_information;
+        using qrcode::qr::detail::horizontal_version_information;
+        using qrcode::structure::module_traits;
+        using result_type = std::optional<symbol_version>;
+
+        // the code has a minimum distance of 8, the nearest codeword is unique up to 3 errors
+        constexpr auto max_errors = 3;
+        auto is_set = module_traits<T>::is_set;
+
+        auto const [horizontal_start, horizontal_size]=horizontal_version_information(size(matrix));
+        auto const [vertical_start, vertical_size] = vertical_version_information(size(matrix));
+
+        auto range1 = views::horizontal(horizontal_start, horizontal_size) | views::element(matrix);
+        auto range2 = views::vertical(vertical_start, vertical_size) | views::element(matrix);
+
+        auto first = 0;
+        auto second = 0;
+        auto mask = 0b1;
+        auto i = begin(range1);
+        auto j = begin(range2);
+        for (; i != end(range1); ++i, ++j, mask <<= 1)
+        {
+            first |= is_set(*i) ? mask : 0;
+            second |= is_set(*j) ? mask : 0;
+        }
+
+        auto nearest = result_type{};
+        auto nearest_errors = max_errors + 1;
+        for (auto v = 7; v <= 40; ++v)
+        {
+            auto const bits = version_information_bits(symbol_version{v});
+            auto const errors = std::min(
+                std::popcount(static_cast<unsigned>(first ^ bits)), 
+                std::popcount(static_cast<unsigned>(second ^ bits)));
+            if (errors < nearest_errors)
+            {
+                nearest = symbol_version{v};
+                nearest_errors = errors;
+            }
+        }
+        return nearest;
+    }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
@@ -274,5 +327,27 @@ namespace qrcode::qr::test
         };
         static_assert(f());
     }
+
+    constexpr auto read_version_information_returns_the_placed_version_even_if_damaged()
+    {
+        auto f = [](auto version)
+        {
+            using namespace qrcode::structure;
+            auto any_matrix = matrix<char>{size(version), module_traits<char>::make_free()};
+            place_version_information(any_matrix, version);
+
+            auto const intact = read_version_information(any_matrix) == version;
+
+            for (auto i : {position{0,0}, position{2,3}, position{1,5}})
+            {
+                auto& module = element_at(any_matrix, {width(any_matrix) - 11 + i.x, i.y});
+                module = module_traits<char>::make_function(!module_traits<char>::is_set(module));
+            }
+            return intact && read_version_information(any_matrix) == version;
+        };
+        static_assert(f(symbol_version{7}));
+        static_assert(f(symbol_version{23}));
+        static_assert(f(symbol_version{40}));
+    }
 }
 #endif
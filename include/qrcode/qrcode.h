@@ -24,4 +24,11 @@
 #pragma once
 
 #include <qrcode/qr/qr.h>
+#include <qrcode/qr/decode.h>
+#include <qrcode/qr/static_symbol.h>
+#include <qrcode/qr/structured_append.h>
+#include <qrcode/qr/utf8.h>
+#include <qrcode/qr/verify.h>
 #include <qrcode/micro_qr/micro_qr.h>
+#include <qrcode/micro_qr/decode.h>
+#include <qrcode/micro_qr/verify.h>
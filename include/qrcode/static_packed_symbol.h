@@ -0,0 +1,138 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#include <qrcode/symbol.h>
+#include <qrcode/micro_qr/raw_code.h>
+#include <qrcode/qr/raw_code.h>
+
+#include <qrcode/structure/dimension.h>
+#include <qrcode/structure/module_traits.h>
+#include <qrcode/structure/position.h>
+
+namespace qrcode
+{
+    // string literal usable as template argument
+    template<std::size_t N>
+    struct fixed_string
+    {
+        consteval fixed_string(char const (&text)[N]) noexcept
+        {
+            std::copy_n(text, N, characters.begin());
+        }
+
+        [[nodiscard]] constexpr auto view() const noexcept
+        {
+            return std::string_view{characters.data(), N - 1};
+        }
+
+        std::array<char, N> characters{};
+    };
+
+    // bit-packed symbol without any heap memory, one bit per module and rows of whole words,
+    // so a constant of this type can be placed in read-only data
+    template<Symbol_Designator Designator, int Width>
+    struct static_packed_symbol
+    {
+        using position = qrcode::structure::position;
+        using word = std::uint64_t;
+        static constexpr auto bits_per_word = 64;
+        static constexpr auto words_per_row = (Width + bits_per_word - 1) / bits_per_word;
+
+        Designator designator;
+        int mask_pattern = 0;
+        std::array<word, Width * words_per_row> words{};
+
+        [[nodiscard]] constexpr auto operator==(static_packed_symbol const&) const noexcept -> bool = default;
+        [[nodiscard]] constexpr auto operator!=(static_packed_symbol const&) const noexcept -> bool = default;
+
+        [[nodiscard]] friend constexpr auto size(static_packed_symbol const&) noexcept
+        {
+            return dimension{Width, Width};
+        }
+
+        [[nodiscard]] friend constexpr auto is_set(static_packed_symbol const& packed, position index) noexcept
+        {
+            auto const word = packed.words[address(index)];
+            return ((word >> (index.x % bits_per_word)) & 1) != 0;
+        }
+
+        [[nodiscard]] friend constexpr auto row(static_packed_symbol const& packed, int y) noexcept
+        {
+            return std::span<word const, words_per_row>{
+                packed.words.data() + y * words_per_row, words_per_row};
+        }
+
+        [[nodiscard]] static constexpr auto address(position index) noexcept
+        {
+            return static_cast<std::size_t>(index.y * words_per_row + index.x / bits_per_word);
+        }
+    };
+
+    template<int Width, class Module, Symbol_Designator Designator>
+    [[nodiscard]] constexpr auto pack_static(symbol<Module, Designator> const& symbol) noexcept
+    {
+        using qrcode::structure::module_traits;
+        using packed_type = static_packed_symbol<Designator, Width>;
+
+        assert(width(size(symbol)) == Width && height(size(symbol)) == Width);
+
+        auto packed = packed_type{designator(symbol), mask_pattern(symbol)};
+        for (auto y = 0; y != Width; ++y)
+        for (auto x = 0; x != Width; ++x)
+            if (module_traits<Module>::is_set(element_at(modules(symbol), {x, y})))
+                packed.words[packed_type::address(qrcode::structure::position{x, y})] |= std::uint64_t{1} << (x % packed_type::bits_per_word);
+        return packed;
+    }
+
+    // function and data modules are told apart by the function layout of the designated version
+    template<class Module, Symbol_Designator Designator, int Width>
+    [[nodiscard]] constexpr auto unpack(static_packed_symbol<Designator, Width> const& packed) noexcept
+    {
+        using qrcode::structure::module_traits;
+        using qrcode::qr::make_function_layout;
+        using qrcode::micro_qr::make_function_layout;
+
+        auto code = make_function_layout<Module>(version(packed.designator));
+        for (auto y = 0; y != Width; ++y)
+        for (auto x = 0; x != Width; ++x)
+        {
+            auto& module = element_at(code, {x, y});
+            auto const bit = is_set(packed, {x, y});
+            module = module_traits<Module>::is_free(module)
+                ? module_traits<Module>::make_data(bit)
+                : module_traits<Module>::make_function(bit);
+        }
+        return symbol<Module, Designator>{packed.designator, packed.mask_pattern, std::move(code)};
+    }
+}
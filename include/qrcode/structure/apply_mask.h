@@ -25,7 +25,6 @@
 
 #include <concepts>
 
-#include <qrcode/structure/horizontal_view.h>
 #include <qrcode/structure/matrix.h>
 #include <qrcode/structure/module_traits.h>
 
@@ -55,15 +54,16 @@ namespace qrcode::structure
     requires std::convertible_to<std::invoke_result_t<Mask, int, int>, bool>
     [[nodiscard]] constexpr auto apply_mask_functor(Mask mask) noexcept
     {
-        return [mask]<class T>(matrix<T> matrix)
+        return [mask]<class T, int Capacity>(matrix<T, Capacity> matrix)
         {
             auto is_data = module_traits<T>::is_data;
             auto apply_mask = module_traits<T>::apply_mask;
-            for (auto i : views::horizontal({0,0}, size(matrix)))
+            for (auto y = 0; y != height(matrix); ++y)
             {
-                auto& module = element_at(matrix, i);
-                if (is_data(module))
-                    module = apply_mask(module, mask(i.y, i.x)); //sic!: y and x are swapped!
+                auto const line = row(matrix, y);
+                for (auto x = 0; x != width(matrix); ++x)
+                    if (is_data(line[x]))
+                        line[x] = apply_mask(line[x], mask(y, x)); //sic!: y and x are swapped!
             }
             return matrix;
         };
@@ -23,7 +23,11 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <ranges>
+#include <utility>
 #include <qrcode/structure/matrix.h>
 
 namespace qrcode::structure
@@ -31,10 +35,10 @@ namespace qrcode::structure
     template<class T>
     concept less_comparable = std::relation<std::less<T>, T, T>;
 
-    template<class T, std::ranges::range Masks, class Penalty_Score>
-    requires less_comparable<std::invoke_result_t<Penalty_Score, matrix<T> const&>>
+    template<class T, int Capacity, std::ranges::range Masks, class Penalty_Score>
+    requires less_comparable<std::invoke_result_t<Penalty_Score, matrix<T, Capacity> const&>>
     [[nodiscard]] constexpr auto data_masking(
-        matrix<T>& data, Masks&& masks, Penalty_Score&& penalty_score) noexcept
+        matrix<T, Capacity>& data, Masks&& masks, Penalty_Score&& penalty_score) noexcept
         -> std::ranges::borrowed_iterator_t<Masks>
     {
         auto const original = data;
@@ -57,6 +61,52 @@ namespace qrcode::structure
         }
         return best_mask;
     }
+
+    template<class Matrix, class F>
+    concept budgeted_penalty_score = std::is_invocable_r_v<int, F, Matrix const&, int>;
+
+    // Selects the same mask as the exhaustive search above (first mask with the lowest score),
+    // but visits the masks ordered by given pre score and stops scoring a candidate as soon 
+    // as it cannot beat the best one found so far. The pre score must be a lower bound of 
+    // the penalty score and the penalty score has to be exact when below given budget.
+    // The pre score gets the unmasked matrix and the mask, so only the candidates which
+    // are scored in full are ever masked.
+    template<class T, int Capacity, class Mask, std::size_t N, class Penalty_Score, class Pre_Score>
+    requires budgeted_penalty_score<matrix<T, Capacity>, Penalty_Score> 
+        && std::is_invocable_r_v<int, Pre_Score, matrix<T, Capacity> const&, Mask const&>
+    [[nodiscard]] constexpr auto data_masking(
+        matrix<T, Capacity>& data, std::array<Mask,N> const& masks, 
+        Penalty_Score&& penalty_score, Pre_Score&& pre_score) noexcept
+    {
+        auto const original = data;
+
+        auto order = std::array<std::pair<int,int>, N>{};
+        for (auto i = 0; i != static_cast<int>(N); ++i)
+            order[i] = {pre_score(original, masks[i]), i};
+        std::ranges::sort(order);
+
+        auto best_index = -1;
+        auto best_score = std::numeric_limits<int>::max();
+
+        for (auto [lower_bound, index] : order)
+        {
+            if (lower_bound > best_score)
+                break;
+
+            // ties are only won by masks preceding the current best one
+            auto const budget = index < best_index ? best_score + 1 : best_score;
+            auto const masked = masks[index](original);
+            auto const current_score = penalty_score(masked, budget);
+
+            if (current_score < budget)
+            {
+                best_score = current_score;
+                best_index = index;
+                data = masked;
+            }
+        }
+        return begin(masks) + best_index;
+    }
 }
 
 #ifdef QRCODE_TESTS_ENABLED
@@ -86,5 +136,37 @@ namespace qrcode::structure::test
         };
         static_assert(f());
     }
+
+    constexpr auto budgeted_data_masking_selects_the_same_mask_as_exhaustive_data_masking()
+    {
+        auto f = []() constexpr
+        {
+            struct mask_stub
+            {
+                constexpr auto operator()(matrix<int> const&) const noexcept 
+                { 
+                    return matrix<int>{{type,rank}}; 
+                }
+
+                int type = -1;
+                int rank = 0;
+            };
+
+            constexpr auto mask_types = std::array<mask_stub, 4>{{{5,1}, {3,1}, {3,2}, {4,3}}};
+            constexpr auto penalty_score = [](auto const& matrix){ return width(matrix); };
+            constexpr auto budgeted_score = [](auto const& matrix, int) { return width(matrix); };
+            constexpr auto pre_score = [](auto const& matrix, auto const& mask){ return -height(mask(matrix)); };
+
+            auto any_matrix = matrix<int>{{10,10}};
+            auto other_matrix = matrix<int>{{10,10}};
+            auto const used_mask = data_masking(any_matrix, mask_types, budgeted_score, pre_score);
+            auto const nominal_mask = data_masking(other_matrix, mask_types, penalty_score);
+
+            return any_matrix == other_matrix 
+                && used_mask == nominal_mask 
+                && used_mask->type == 3 && used_mask->rank == 1;
+        };
+        static_assert(f());
+    }
 }
 #endif
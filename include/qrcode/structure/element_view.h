@@ -30,8 +30,8 @@
 
 namespace qrcode::structure::views
 {
-    template<class T>
-    [[nodiscard]] constexpr auto element(matrix<T>& matrix) noexcept
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto element(matrix<T, Capacity>& matrix) noexcept
     {
         return std::views::transform([&matrix](position point) -> auto& 
         { 
@@ -39,8 +39,8 @@ namespace qrcode::structure::views
         });
     }
 
-    template<class T>
-    [[nodiscard]] constexpr auto element(matrix<T> const& matrix) noexcept
+    template<class T, int Capacity>
+    [[nodiscard]] constexpr auto element(matrix<T, Capacity> const& matrix) noexcept
     {
         return std::views::transform([&matrix](position point) -> auto& 
         { 
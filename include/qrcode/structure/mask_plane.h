@@ -0,0 +1,183 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <span>
+
+#include <qrcode/structure/dimension.h>
+#include <qrcode/structure/horizontal_view.h>
+#include <qrcode/structure/matrix.h>
+#include <qrcode/structure/module_traits.h>
+#include <qrcode/structure/position.h>
+
+namespace qrcode::structure
+{
+    // bit-packed mask which only covers the data modules of a symbol
+    template<int Max_Size>
+    class mask_plane
+    {
+        using word = std::uint64_t;
+        static constexpr auto bits_per_word = 64;
+        static constexpr auto words_per_row = (Max_Size + bits_per_word - 1) / bits_per_word;
+
+    public:
+        constexpr mask_plane() noexcept = default;
+
+        template<class T, int Capacity>
+        explicit constexpr mask_plane(matrix<T, Capacity> const& code) noexcept
+        : extend{size(code)}
+        {
+            assert(width(code) <= Max_Size && height(code) <= Max_Size);
+            for (auto i : views::horizontal({0,0}, extend))
+                if (module_traits<T>::is_data(element_at(code, i)))
+                    set(i);
+        }
+
+        template<class Mask>
+        requires std::convertible_to<std::invoke_result_t<Mask, int, int>, bool>
+        constexpr mask_plane(mask_plane const& region, Mask mask) noexcept
+        : extend{region.extend}
+        {
+            for (auto i : views::horizontal({0,0}, extend))
+                if (is_masked(region, i) && mask(i.y, i.x)) //sic!: y and x are swapped!
+                    set(i);
+        }
+
+        [[nodiscard]] constexpr auto operator==(mask_plane const&) const noexcept -> bool = default;
+        [[nodiscard]] constexpr auto operator!=(mask_plane const&) const noexcept -> bool = default;
+
+        [[nodiscard]] friend constexpr auto size(mask_plane const& plane) noexcept 
+        { 
+            return plane.extend; 
+        }
+
+        [[nodiscard]] friend constexpr auto is_masked(mask_plane const& plane, position index) noexcept
+        {
+            auto const bit = plane.words[address(index)] >> (index.x % bits_per_word);
+            return (bit & 1) != 0;
+        }
+
+        [[nodiscard]] friend constexpr auto row(mask_plane const& plane, int y) noexcept
+        {
+            return std::span<word const, words_per_row>{
+                plane.words.data() + y * words_per_row, words_per_row};
+        }
+
+        template<class T, int Capacity>
+        [[nodiscard]] constexpr auto operator()(matrix<T, Capacity> matrix) const noexcept
+        {
+            auto apply_mask = module_traits<T>::apply_mask;
+            for (auto y = 0; y != height(extend); ++y)
+            {
+                auto x = 0;
+                for (auto bits : row(*this, y))
+                {
+                    for (; bits != 0; bits &= bits - 1)
+                    {
+                        auto& module = element_at(matrix, {x + std::countr_zero(bits), y});
+                        module = apply_mask(module, true);
+                    }
+                    x += bits_per_word;
+                }
+            }
+            return matrix;
+        }
+
+    private:
+        [[nodiscard]] static constexpr auto address(position index) noexcept
+        {
+            return index.y * words_per_row + index.x / bits_per_word;
+        }
+
+        constexpr auto set(position index) noexcept
+        {
+            words[address(index)] |= word{1} << (index.x % bits_per_word);
+        }
+
+        dimension extend{0,0};
+        std::array<word, Max_Size * words_per_row> words{};
+    };
+
+    template<int Max_Size, class Mask, std::size_t N>
+    [[nodiscard]] constexpr auto make_mask_planes(
+        mask_plane<Max_Size> const& region, std::array<Mask,N> const& masks) noexcept
+    {
+        auto planes = std::array<mask_plane<Max_Size>, N>{};
+        for (auto i = 0; i != static_cast<int>(N); ++i)
+            planes[i] = mask_plane<Max_Size>{region, masks[i]};
+        return planes;
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
+#include <qrcode/structure/apply_mask.h>
+#include <qrcode/structure/make_matrix.h>
+
+namespace qrcode::structure::test
+{
+    constexpr auto mask_planes_only_cover_the_data_modules_of_given_matrix()
+    {
+        using namespace std::literals;
+        constexpr auto any_mask = [](int i, int j) { return (i + j) % 2 == 0; };
+        constexpr auto any_matrix = make_matrix<char>({5,3}, 
+            "*-,+,"
+            ",+.*+"
+            "-+,,*"sv
+        );
+
+        constexpr auto region = mask_plane<70>{any_matrix};
+        constexpr auto plane = mask_plane<70>{region, any_mask};
+
+        static_assert(size(plane) == dimension{5,3});
+        static_assert(!is_masked(region, {0,0}) && !is_masked(region, {1,0}) && !is_masked(region, {2,1}));
+        static_assert(is_masked(region, {2,0}) && is_masked(region, {3,0}) && is_masked(region, {4,0}));
+        static_assert(is_masked(plane, {2,0}) && !is_masked(plane, {3,0}) && is_masked(plane, {4,0}));
+        static_assert(!is_masked(plane, {0,1}) && is_masked(plane, {1,1}) && !is_masked(plane, {2,1}));
+        static_assert(row(plane, 0)[0] == 0b10100 && row(plane, 0)[1] == 0);
+        static_assert(row(plane, 2)[0] == 0b00100);
+    }
+
+    constexpr auto mask_planes_mask_given_matrix_like_the_mask_functor()
+    {
+        using namespace std::literals;
+        constexpr auto any_mask = [](int i, int j) { return (i / 2 + j / 3) % 2 == 0; };
+        constexpr auto any_matrix = make_matrix<char>({7,4}, 
+            "*-,+,++"
+            ",+-*+,,"
+            "-+,,*,+"
+            "+,,*,,,"sv
+        );
+
+        constexpr auto plane = mask_plane<7>{mask_plane<7>{any_matrix}, any_mask};
+
+        static_assert(plane(any_matrix) == apply_mask_functor(any_mask)(any_matrix));
+    }
+}
+#endif
@@ -25,6 +25,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <ranges>
+#include <span>
 #include <cx/vector.h>
 #include <qrcode/structure/position.h>
 #include <qrcode/structure/dimension.h>
@@ -39,10 +42,12 @@ namespace qrcode::structure::detail
 
 namespace qrcode::structure
 {
-    template<class T>
+    // the capacity defaults to the largest symbol, a symbol size known at compile time may
+    // bound it so copies of the matrix only move the modules this size can have
+    template<class T, int Capacity = cx::default_capacity>
     class matrix
     {
-        using container = cx::vector<T>;
+        using container = cx::vector<T, Capacity>;
 
     public:
         template<class U>
@@ -58,6 +63,15 @@ namespace qrcode::structure
         {
         }
 
+        template<int Other_Capacity>
+        requires (Other_Capacity != Capacity)
+        explicit constexpr matrix(matrix<T, Other_Capacity> const& other) noexcept
+        : matrix{size(other)}
+        {
+            for (auto y = 0; y != height(other); ++y)
+                std::ranges::copy(row(other, y), row(*this, y).begin());
+        }
+
         using value_type = T;
         
         [[nodiscard]] constexpr auto operator==(matrix const&) const noexcept -> bool = default;
@@ -81,6 +95,44 @@ namespace qrcode::structure
             return *(begin(matrix.elements) + detail::relative_address(size(matrix), index));
         }
 
+        // rows are stored contiguously, so loops over a row are plain pointer walks
+        [[nodiscard]] friend constexpr auto row(matrix& matrix, int y) noexcept -> std::span<value_type>
+        {
+            using std::ranges::begin;
+            assert(y >= 0 && y < height(matrix));
+            return {begin(matrix.elements) + width(matrix) * y, static_cast<std::size_t>(width(matrix))};
+        }
+
+        [[nodiscard]] friend constexpr auto row(matrix const& matrix, int y) noexcept -> std::span<value_type const>
+        {
+            using std::ranges::begin;
+            assert(y >= 0 && y < height(matrix));
+            return {begin(matrix.elements) + width(matrix) * y, static_cast<std::size_t>(width(matrix))};
+        }
+
+        // the elements of a column are a row width apart
+        [[nodiscard]] friend constexpr auto column(matrix& matrix, int x) noexcept
+        {
+            using std::ranges::begin;
+            assert(x >= 0 && x < width(matrix));
+            return std::views::iota(0, height(matrix)) 
+                | std::views::transform([first = begin(matrix.elements) + x, stride = width(matrix)](int y) -> value_type&
+                {
+                    return first[y * stride];
+                });
+        }
+
+        [[nodiscard]] friend constexpr auto column(matrix const& matrix, int x) noexcept
+        {
+            using std::ranges::begin;
+            assert(x >= 0 && x < width(matrix));
+            return std::views::iota(0, height(matrix)) 
+                | std::views::transform([first = begin(matrix.elements) + x, stride = width(matrix)](int y) -> value_type const&
+                {
+                    return first[y * stride];
+                });
+        }
+
         [[nodiscard]] friend constexpr auto contains(matrix const& matrix, position index) noexcept
         { 
             return index.x >= 0 && index.x < width(matrix)
@@ -92,14 +144,14 @@ namespace qrcode::structure
         container elements;
     };
 
-    template<class T> 
-    [[nodiscard]] constexpr auto width(matrix<T> const& matrix) noexcept 
+    template<class T, int Capacity> 
+    [[nodiscard]] constexpr auto width(matrix<T, Capacity> const& matrix) noexcept 
     { 
         return width(size(matrix)); 
     }
 
-    template<class T> 
-    [[nodiscard]] constexpr auto height(matrix<T> const& matrix) noexcept 
+    template<class T, int Capacity> 
+    [[nodiscard]] constexpr auto height(matrix<T, Capacity> const& matrix) noexcept 
     { 
         return height(size(matrix)); 
     }
@@ -219,6 +271,40 @@ namespace qrcode::structure::test
         static_assert(f());
     }
 
+    constexpr auto matrices_provide_their_rows_as_contiguous_spans()
+    {
+        auto f = []
+        {
+            auto any_matrix = matrix<int>{dimension{3,2}};
+            element_at(any_matrix, {0,1}) = 4;
+            element_at(any_matrix, {2,1}) = 5;
+            row(any_matrix, 0)[1] = 7;
+
+            auto const& const_matrix = any_matrix;
+            auto const line = row(const_matrix, 1);
+            return line.size() == 3 && line[0] == 4 && line[1] == 0 && line[2] == 5
+                && element_at(any_matrix, {1,0}) == 7
+                && line.data() == row(const_matrix, 0).data() + 3;
+        };
+        static_assert(f());
+    }
+
+    constexpr auto matrices_provide_their_columns_as_strided_views()
+    {
+        auto f = []
+        {
+            auto any_matrix = matrix<int>{dimension{2,3}};
+            element_at(any_matrix, {1,0}) = 4;
+            element_at(any_matrix, {1,2}) = 5;
+            column(any_matrix, 0)[1] = 7;
+
+            auto const& const_matrix = any_matrix;
+            return std::ranges::equal(column(const_matrix, 1), std::array{4,0,5})
+                && std::ranges::equal(column(const_matrix, 0), std::array{0,7,0});
+        };
+        static_assert(f());
+    }
+
     constexpr auto matrix_can_be_asked_whether_a_point_lies_inside()
     {
         constexpr auto any_size = dimension{3, 2};
@@ -234,5 +320,22 @@ namespace qrcode::structure::test
         static_assert(contains(any_matrix, {0,1}));
         static_assert(!contains(any_matrix, {0,10}));
     }    
+
+    constexpr auto matrices_can_be_converted_between_capacities()
+    {
+        auto f = []
+        {
+            auto bounded = matrix<int, 6>{{3,2}};
+            element_at(bounded, {1,0}) = 4;
+            element_at(bounded, {2,1}) = 5;
+
+            auto const unbounded = matrix<int>{bounded};
+            return size(unbounded) == dimension{3,2}
+                && std::ranges::equal(row(unbounded, 0), std::array{0,4,0})
+                && std::ranges::equal(row(unbounded, 1), std::array{0,0,5})
+                && matrix<int, 6>{unbounded} == bounded;
+        };
+        static_assert(f());
+    }
 }
 #endif
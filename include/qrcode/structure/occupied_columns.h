@@ -26,22 +26,20 @@
 #include <ranges>
 #include <algorithm>
 
-#include <qrcode/structure/vertical_view.h>
-#include <qrcode/structure/element_view.h>
+#include <qrcode/structure/matrix.h>
 #include <qrcode/structure/module_traits.h>
 
 namespace qrcode::structure
 {
-    template<class T> 
+    template<class T, int Capacity> 
     requires std::is_same_v<std::invoke_result_t<decltype(module_traits<T>::is_free), T const&>, bool>
-    [[nodiscard]] constexpr auto occupied_columns(matrix<T> const& matrix) noexcept
+    [[nodiscard]] constexpr auto occupied_columns(matrix<T, Capacity> const& matrix) noexcept
     {
         auto is_free = module_traits<T>::is_free;
         cx::vector<int> columns;
         for (auto x = 0; x != width(matrix); ++x)
         {
-            auto const range = views::vertical({x,0}, {1,height(matrix)}) | views::element(matrix);
-            if (std::ranges::none_of(range, is_free))
+            if (std::ranges::none_of(column(matrix, x), is_free))
                 columns.push_back(x);
         }
         return columns;
@@ -0,0 +1,170 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <qrcode/structure/dimension.h>
+#include <qrcode/structure/horizontal_view.h>
+#include <qrcode/structure/matrix.h>
+#include <qrcode/structure/module_traits.h>
+#include <qrcode/structure/position.h>
+
+namespace qrcode::structure
+{
+    // two bits per module: whether it is set and whether it is a data module
+    class packed_matrix
+    {
+        using word = std::uint64_t;
+        static constexpr auto bits_per_word = 64;
+
+    public:
+        constexpr packed_matrix() noexcept = default;
+
+        template<class T>
+        explicit constexpr packed_matrix(matrix<T> const& code)
+        : extend{size(code)}
+        , words_per_row{(width(code) + bits_per_word - 1) / bits_per_word}
+        , set_bits(static_cast<std::size_t>(words_per_row * height(code)))
+        , data_bits(static_cast<std::size_t>(words_per_row * height(code)))
+        {
+            for (auto i : views::horizontal({0,0}, extend))
+            {
+                auto const& module = element_at(code, i);
+                if (module_traits<T>::is_set(module))
+                    set_bits[address(i)] |= mask_of(i);
+                if (module_traits<T>::is_data(module))
+                    data_bits[address(i)] |= mask_of(i);
+            }
+        }
+
+        [[nodiscard]] constexpr auto operator==(packed_matrix const&) const noexcept -> bool = default;
+        [[nodiscard]] constexpr auto operator!=(packed_matrix const&) const noexcept -> bool = default;
+
+        [[nodiscard]] friend constexpr auto size(packed_matrix const& packed) noexcept
+        {
+            return packed.extend;
+        }
+
+        [[nodiscard]] friend constexpr auto is_set(packed_matrix const& packed, position index) noexcept
+        {
+            return (packed.set_bits[packed.address(index)] & mask_of(index)) != 0;
+        }
+
+        [[nodiscard]] friend constexpr auto is_data(packed_matrix const& packed, position index) noexcept
+        {
+            return (packed.data_bits[packed.address(index)] & mask_of(index)) != 0;
+        }
+
+        // heap memory held by the matrix
+        [[nodiscard]] friend constexpr auto byte_size(packed_matrix const& packed) noexcept
+        {
+            return (size(packed.set_bits) + size(packed.data_bits)) * sizeof(word);
+        }
+
+    private:
+        [[nodiscard]] constexpr auto address(position index) const noexcept -> std::size_t
+        {
+            return static_cast<std::size_t>(index.y * words_per_row + index.x / bits_per_word);
+        }
+
+        [[nodiscard]] static constexpr auto mask_of(position index) noexcept -> word
+        {
+            return word{1} << (index.x % bits_per_word);
+        }
+
+        dimension extend{0,0};
+        int words_per_row{0};
+        std::vector<word> set_bits;
+        std::vector<word> data_bits;
+    };
+
+    // modules which are no data modules are restored as function modules
+    template<class T>
+    [[nodiscard]] constexpr auto unpack(packed_matrix const& packed) noexcept
+    {
+        using traits = module_traits<T>;
+
+        auto result = matrix<T>{size(packed)};
+        for (auto i : views::horizontal({0,0}, size(packed)))
+            element_at(result, i) = is_data(packed, i) 
+                ? traits::make_data(is_set(packed, i)) 
+                : traits::make_function(is_set(packed, i));
+        return result;
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
+#include <qrcode/structure/make_matrix.h>
+
+// packed matrices allocate, so they can only be checked at compile time by a constexpr vector
+#if defined(__cpp_lib_constexpr_vector)
+namespace qrcode::structure::test
+{
+    constexpr auto packed_matrices_keep_the_value_and_the_kind_of_every_module()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            auto const any_matrix = make_matrix<char>({3,2}, 
+                "*-+"
+                ",+*"sv
+            );
+            auto const packed = packed_matrix{any_matrix};
+
+            return size(packed) == dimension{3,2}
+                && is_set(packed, {0,0}) && !is_data(packed, {0,0})
+                && !is_set(packed, {1,0}) && !is_data(packed, {1,0})
+                && is_set(packed, {2,0}) && is_data(packed, {2,0})
+                && !is_set(packed, {0,1}) && is_data(packed, {0,1});
+        };
+        static_assert(f());
+    }
+
+    constexpr auto packed_matrices_use_one_word_per_row_and_plane_up_to_a_width_of_64_modules()
+    {
+        static_assert(byte_size(packed_matrix{matrix<char>{{21,21}, '-'}}) == 2 * 21 * 8);
+        static_assert(byte_size(packed_matrix{matrix<char>{{64,3}, '-'}}) == 2 * 3 * 8);
+        static_assert(byte_size(packed_matrix{matrix<char>{{65,3}, '-'}}) == 2 * 6 * 8);
+    }
+
+    constexpr auto unpacked_matrices_equal_the_packed_ones()
+    {
+        auto f = []
+        {
+            using namespace std::literals;
+            auto const any_matrix = make_matrix<char>({70,2}, 
+                "*-+,*-+,*-+,*-+,*-+,*-+,*-+,*-+,*-+,*-+,*-+,*-+,*-+,*-+,*-+,*-+,*-+,*-"
+                ",+-*,+-*,+-*,+-*,+-*,+-*,+-*,+-*,+-*,+-*,+-*,+-*,+-*,+-*,+-*,+-*,+-*,+"sv
+            );
+            return unpack<char>(packed_matrix{any_matrix}) == any_matrix;
+        };
+        static_assert(f());
+    }
+}
+#endif
+#endif
@@ -23,41 +23,62 @@
  */
 #pragma once
 
-#include <ranges>
+#include <algorithm>
+#include <cassert>
 #include <concepts>
+#include <ranges>
 #include <qrcode/structure/matrix.h>
 #include <qrcode/structure/module.h>
 #include <qrcode/structure/module_traits.h>
 #include <qrcode/structure/occupied_columns.h>
-#include <qrcode/structure/skip_column_view.h>
-#include <qrcode/structure/zigzag_view.h>
 
 namespace qrcode::structure
 {
-    template<class T, std::ranges::range Range> 
+    template<class T, int Capacity, std::ranges::range Range> 
     requires std::convertible_to<std::ranges::range_value_t<Range>, T>
         && std::is_same_v<std::invoke_result_t<decltype(module_traits<T>::is_free), T const&>, bool>
-    [[nodiscard]] constexpr auto place_data(matrix<T>& matrix, Range&& data) noexcept
+    [[nodiscard]] constexpr auto place_data(matrix<T, Capacity>& matrix, Range&& data) noexcept
     {
-        using std::ranges::size;
         using std::ranges::begin;
         using std::ranges::end;
 
         auto const columns = occupied_columns(matrix);
+        auto const data_column = [&columns](int x)
+        {
+            while (x >= 0 && std::ranges::find(columns, x) != end(columns))
+                --x;
+            return x;
+        };
 
-        auto range = 
-              views::zigzag({width(matrix)-static_cast<int>(size(columns)), height(matrix)})
-            | views::skip_column(columns)
-            | views::element(matrix)
-            | std::views::filter(module_traits<T>::is_free);
-
-        auto i = begin(range);
         auto d = begin(data);
-        for (; i != end(range) && d != end(data); ++i, ++d)
-            *i = *d;
+        auto const place = [&d, &data](T& module)
+        {
+            if (!module_traits<T>::is_free(module))
+                return;
+            
+            if (d != end(data))
+                module = *(d++);
+            else
+                module = module_traits<T>::make_data(0);
+        };
 
+        // same order as views::zigzag over the columns without any free module,
+        // but each step is a row span access instead of a position computation
+        auto upwards = true;
+        for (auto right = data_column(width(matrix)-1); right >= 0; upwards = !upwards)
+        {
+            auto const left = data_column(right-1);
+            assert(left >= 0);
+
+            for (auto i = 0; i != height(matrix); ++i)
+            {
+                auto const line = row(matrix, upwards ? height(matrix)-1-i : i);
+                place(line[right]);
+                place(line[left]);
+            }
+            right = data_column(left-1);
+        }
         assert(d == end(data));
-        std::fill(i, end(range), module_traits<T>::make_data(0));
     }
 }
 
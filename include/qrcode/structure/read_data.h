@@ -0,0 +1,217 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <ranges>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <cx/vector.h>
+
+#include <qrcode/structure/mask_plane.h>
+#include <qrcode/structure/matrix.h>
+#include <qrcode/structure/module_traits.h>
+#include <qrcode/structure/occupied_columns.h>
+#include <qrcode/structure/position.h>
+#include <qrcode/structure/skip_column_view.h>
+#include <qrcode/structure/zigzag_view.h>
+
+namespace qrcode::structure
+{
+    // the free modules of given layout in the order place_data fills them, sized by their count
+    template<class T> 
+    requires std::is_same_v<std::invoke_result_t<decltype(module_traits<T>::is_free), T const&>, bool>
+    [[nodiscard]] constexpr auto make_placement_map(matrix<T> const& layout) noexcept
+    {
+        using std::ranges::size;
+        using std::ranges::begin;
+        using std::ranges::end;
+
+        auto columns = occupied_columns(layout);
+
+        // a span keeps the pipeline from copying the column storage
+        auto range = 
+              views::zigzag({width(layout)-static_cast<int>(size(columns)), height(layout)})
+            | views::skip_column(std::span{begin(columns), end(columns)})
+            | std::views::filter([&layout](position point) 
+              { 
+                  return module_traits<T>::is_free(element_at(layout, point)); 
+              });
+
+        auto placement = std::vector<position>{};
+        for (auto i : range)
+            placement.push_back(i);
+        return placement;
+    }
+
+    template<class U, class Mask> 
+    requires std::convertible_to<std::invoke_result_t<Mask, int, int>, bool>
+    [[nodiscard]] constexpr auto read_data(
+        std::span<position const> placement, matrix<U> const& code, Mask mask) noexcept
+    {
+        auto is_set = module_traits<U>::is_set;
+
+        auto bits = cx::vector<bool>{};
+        for (auto i : placement)
+            bits.push_back(static_cast<bool>(is_set(element_at(code, i))) != static_cast<bool>(mask(i.y, i.x)));
+        return bits;
+    }
+
+    template<class U, int Max_Size> 
+    [[nodiscard]] constexpr auto read_data(
+        std::span<position const> placement, matrix<U> const& code, mask_plane<Max_Size> const& mask) noexcept
+    {
+        auto is_set = module_traits<U>::is_set;
+
+        auto bits = cx::vector<bool>{};
+        for (auto i : placement)
+            bits.push_back(static_cast<bool>(is_set(element_at(code, i))) != is_masked(mask, i));
+        return bits;
+    }
+
+    // packs the bits of the first given number of codewords without collecting the bits first,
+    // the remainder bits behind them are never read
+    template<int Max_Codewords, class U, int Max_Size> 
+    [[nodiscard]] constexpr auto read_codewords(
+        std::span<position const> placement, matrix<U> const& code, mask_plane<Max_Size> const& mask, 
+        int count) noexcept
+    {
+        auto is_set = module_traits<U>::is_set;
+
+        auto codewords = cx::vector<std::byte, Max_Codewords>{};
+        for (auto i = begin(placement); count != 0; --count)
+        {
+            auto codeword = 0u;
+            for (auto const last = i + 8; i != last; ++i)
+                codeword = (codeword << 1) | (static_cast<bool>(is_set(element_at(code, *i))) != is_masked(mask, *i));
+            codewords.push_back(std::byte{static_cast<unsigned char>(codeword)});
+        }
+        return codewords;
+    }
+
+    template<class T, class U, class Mask> 
+    requires std::is_same_v<std::invoke_result_t<decltype(module_traits<T>::is_free), T const&>, bool>
+        && std::convertible_to<std::invoke_result_t<Mask, int, int>, bool>
+    [[nodiscard]] constexpr auto read_data(
+        matrix<T> const& layout, matrix<U> const& code, Mask mask) noexcept
+    {
+        return read_data(make_placement_map(layout), code, mask);
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <array>
+#include <qrcode/code/byte_view.h>
+#include <qrcode/structure/place_data.h>
+
+namespace qrcode::structure::test
+{
+    constexpr auto read_data_returns_the_bits_placed_in_the_free_modules_of_given_layout()
+    {
+        auto f = []
+        {
+            auto any_layout = matrix<char>{{5,2}, '.'};
+            auto make_function = module_traits<char>::make_function;
+            element_at(any_layout, {3,0}) = make_function(1); 
+            element_at(any_layout, {3,1}) = make_function(1); 
+            element_at(any_layout, {1,0}) = make_function(0); 
+
+            auto const any_bits = std::array{true,false,false,true,true,false,true};
+            auto code = any_layout;
+            place_data(code, any_bits | std::views::transform(module_traits<char>::make_data));
+
+            auto const no_mask = [](int, int) { return false; };
+            auto const bits = read_data(any_layout, code, no_mask);
+
+            return std::ranges::equal(bits, any_bits);
+        };
+        static_assert(f());
+    }
+
+    constexpr auto placement_maps_list_the_free_modules_in_placement_order()
+    {
+        auto f = []
+        {
+            auto any_layout = matrix<char>{{4,2}, '.'};
+            element_at(any_layout, {2,1}) = module_traits<char>::make_function(1);
+
+            return std::ranges::equal(make_placement_map(any_layout), std::array<position,7>{{
+                {3,1}, {3,0}, {2,0}, {1,0}, {0,0}, {1,1}, {0,1}
+            }});
+        };
+        static_assert(f());
+    }
+
+    constexpr auto read_data_removes_given_mask_from_the_read_bits()
+    {
+        auto f = []
+        {
+            auto const any_layout = matrix<char>{{4,2}, '.'};
+            auto const code = matrix<char>{{4,2}, '+'};
+
+            auto const row_mask = [](int i, int) { return i == 0; };
+            auto const bits = read_data(any_layout, code, row_mask);
+
+            return std::ranges::equal(bits, std::array{true,true,false,false,false,false,true,true});
+        };
+        static_assert(f());
+    }
+
+    constexpr auto read_data_removes_the_mask_of_given_mask_plane()
+    {
+        auto f = []
+        {
+            auto const any_layout = matrix<char>{{4,2}, '.'};
+            auto const code = matrix<char>{{4,2}, '+'};
+
+            auto const row_mask = [](int i, int) { return i == 0; };
+            auto const plane = mask_plane<4>{mask_plane<4>{matrix<char>{{4,2}, ','}}, row_mask};
+            auto const placement = make_placement_map(any_layout);
+
+            return read_data(placement, code, plane) == read_data(placement, code, row_mask);
+        };
+        static_assert(f());
+    }
+
+    constexpr auto read_codewords_packs_the_unmasked_bits_in_placement_order()
+    {
+        auto f = []
+        {
+            auto const any_layout = matrix<char>{{6,3}, '.'};
+            auto const code = matrix<char>{{6,3}, '+'};
+
+            auto const row_mask = [](int i, int) { return i == 1; };
+            auto const plane = mask_plane<6>{mask_plane<6>{matrix<char>{{6,3}, ','}}, row_mask};
+            auto const placement = make_placement_map(any_layout);
+
+            // 18 modules, the remainder bits of the last two are not part of any codeword
+            return std::ranges::equal(read_codewords<2>(placement, code, plane, 2), 
+                read_data(placement, code, row_mask) | qrcode::views::byte | std::views::take(2));
+        };
+        static_assert(f());
+    }
+}
+#endif
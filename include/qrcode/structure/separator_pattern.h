@@ -32,11 +32,11 @@
 
 namespace qrcode::structure
 {
-    template<class T>
+    template<class T, int Capacity>
     requires std::convertible_to<std::invoke_result_t<
         decltype(module_traits<T>::make_function), bool>, T>
     [[nodiscard]] constexpr auto place_separator_pattern(
-        matrix<T>& matrix, position finder_position, dimension finder_size) noexcept
+        matrix<T, Capacity>& matrix, position finder_position, dimension finder_size) noexcept
     {
         auto const pattern_size = dimension{width(finder_size)+2, height(finder_size)+2};
         auto index = std::views::iota(0, 2*width(pattern_size)+2*height(pattern_size));
@@ -57,11 +57,11 @@ namespace qrcode::structure
             i = make_function(*(p++));
     }
 
-    template<class T>
+    template<class T, int Capacity>
     requires std::convertible_to<std::invoke_result_t<decltype(module_traits<T>::is_free), T>, bool>
         && std::convertible_to<std::invoke_result_t<decltype(module_traits<T>::make_function), bool>, T>
     [[nodiscard]] constexpr auto place_horizontal_timing_pattern(
-        matrix<T>& matrix, int row) noexcept
+        matrix<T, Capacity>& matrix, int row) noexcept
     {
         auto range = 
             views::horizontal({0,row}, {width(matrix),1}) 
@@ -71,11 +71,11 @@ namespace qrcode::structure
         place_timing_pattern(range, module_traits<T>::make_function);
     }
 
-    template<class T>
+    template<class T, int Capacity>
     requires std::convertible_to<std::invoke_result_t<decltype(module_traits<T>::is_free), T>, bool>
         && std::convertible_to<std::invoke_result_t<decltype(module_traits<T>::make_function), bool>, T>
     [[nodiscard]] constexpr auto place_vertical_timing_pattern(
-        matrix<T>& matrix, int column) noexcept
+        matrix<T, Capacity>& matrix, int column) noexcept
     {
         auto range = 
             views::vertical({column,0}, {1,height(matrix)}) 
@@ -24,6 +24,8 @@
 
 #pragma once
 #include <qrcode/symbol.h>
+#include <qrcode/packed_symbol.h>
+#include <qrcode/static_packed_symbol.h>
 #include <qrcode/structure/module_traits.h>
 
 namespace qrcode::detail
@@ -51,9 +53,22 @@ namespace qrcode::detail
     {
         using qrcode::structure::module_traits;
 
-        for (auto i : views::horizontal({0,0}, size(modules)))
+        for (auto y = 0; y != height(modules); ++y)
         {
-            if (module_traits<Module>::is_set(element_at(modules, i)))
+            auto const line = row(modules, y);
+            for (auto x = 0; x != width(modules); ++x)
+                if (module_traits<Module>::is_set(line[x]))
+                    stream << "<path d=\"M" << x << " " << y << " h1 v1 h-1 z\" />\n";
+        }
+    }
+
+    // static packed symbols and packed matrices keep their own bit order, they are read module by module
+    template<class Stream, class Packed>
+    [[nodiscard]] constexpr auto content(Stream& stream, Packed const& packed)
+    {
+        for (auto i : views::horizontal({0,0}, size(packed)))
+        {
+            if (is_set(packed, i))
                 stream << "<path d=\"M" << i.x << " " << i.y << " h1 v1 h-1 z\" />\n";
         }
     }
@@ -75,4 +90,24 @@ namespace qrcode
         qrcode::detail::content(stream, modules(symbol));
         qrcode::detail::footer(stream);
     }
+
+    // symbols generated while compiling are written without unpacking them first
+    template<class Stream, Symbol_Designator Designator, int Width>
+    [[nodiscard]] constexpr auto svg(Stream& stream, static_packed_symbol<Designator, Width> const& packed)
+    {
+        qrcode::detail::header(stream);
+        qrcode::detail::white_background(stream);
+        qrcode::detail::content(stream, packed);
+        qrcode::detail::footer(stream);
+    }
+
+    // cached symbols are written without unpacking them first
+    template<class Stream, Symbol_Designator Designator>
+    [[nodiscard]] constexpr auto svg(Stream& stream, packed_symbol<Designator> const& packed)
+    {
+        qrcode::detail::header(stream);
+        qrcode::detail::white_background(stream);
+        qrcode::detail::content(stream, packed.modules);
+        qrcode::detail::footer(stream);
+    }
 }
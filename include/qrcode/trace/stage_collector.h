@@ -0,0 +1,270 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+#include <qrcode/trace/tracer.h>
+
+namespace qrcode::trace
+{
+    // durations are counted in power of two buckets, bucket i holds [2^(i-1), 2^i) ns
+    class histogram
+    {
+    public:
+        static constexpr auto bucket_count = 48;
+
+        constexpr auto add(std::int64_t ns) noexcept -> void
+        {
+            auto const value = static_cast<std::uint64_t>(std::max<std::int64_t>(ns, 0));
+            auto const bucket = std::min(static_cast<int>(std::bit_width(value)), bucket_count-1);
+            ++buckets[static_cast<std::size_t>(bucket)];
+            ++samples;
+            sum += static_cast<std::int64_t>(value);
+            smallest = std::min(smallest, static_cast<std::int64_t>(value));
+            largest = std::max(largest, static_cast<std::int64_t>(value));
+        }
+
+        constexpr auto operator+=(histogram const& other) noexcept -> histogram&
+        {
+            for (auto i = 0; i != bucket_count; ++i)
+                buckets[static_cast<std::size_t>(i)] += other.buckets[static_cast<std::size_t>(i)];
+            samples += other.samples;
+            sum += other.sum;
+            smallest = std::min(smallest, other.smallest);
+            largest = std::max(largest, other.largest);
+            return *this;
+        }
+
+        [[nodiscard]] friend constexpr auto count(histogram const& h) noexcept { return h.samples; }
+        [[nodiscard]] friend constexpr auto total_ns(histogram const& h) noexcept { return h.sum; }
+        [[nodiscard]] friend constexpr auto min_ns(histogram const& h) noexcept
+        {
+            return h.samples == 0 ? std::int64_t{0} : h.smallest;
+        }
+        [[nodiscard]] friend constexpr auto max_ns(histogram const& h) noexcept { return h.largest; }
+        [[nodiscard]] friend constexpr auto bucket(histogram const& h, int i) noexcept
+        {
+            return h.buckets[static_cast<std::size_t>(i)];
+        }
+
+        // upper bound of the bucket holding the given quantile
+        [[nodiscard]] friend constexpr auto quantile_ns(histogram const& h, double q) noexcept -> std::int64_t
+        {
+            auto const rank = static_cast<std::uint64_t>(q * static_cast<double>(h.samples));
+            auto seen = std::uint64_t{0};
+            for (auto i = 0; i != bucket_count; ++i)
+            {
+                seen += h.buckets[static_cast<std::size_t>(i)];
+                if (seen > rank)
+                    return std::min((std::int64_t{1} << i) - 1, h.largest);
+            }
+            return h.largest;
+        }
+
+    private:
+        std::array<std::uint64_t, bucket_count> buckets = {};
+        std::uint64_t samples = 0;
+        std::int64_t sum = 0;
+        std::int64_t smallest = std::numeric_limits<std::int64_t>::max();
+        std::int64_t largest = 0;
+    };
+
+    // aggregates the events of any number of symbols, one collector per thread,
+    // the collectors of several threads are merged with +=
+    class stage_collector
+    {
+    public:
+        constexpr auto begin(stage_event const& e) noexcept -> void
+        {
+            started[index(e.stage)] = e.timestamp_ns;
+        }
+
+        constexpr auto end(stage_event const& e) noexcept -> void
+        {
+            durations[index(e.stage)].add(e.timestamp_ns - started[index(e.stage)]);
+            bits[index(e.stage)] += static_cast<std::uint64_t>(e.bit_count);
+        }
+
+        constexpr auto segment(segment_event const& e) noexcept -> void
+        {
+            ++segments[static_cast<std::size_t>(e.mode)];
+            characters[static_cast<std::size_t>(e.mode)] += static_cast<std::uint64_t>(e.character_count);
+        }
+
+        constexpr auto version(version_event const& e) noexcept -> void
+        {
+            ++versions[static_cast<std::size_t>(e.version-1)];
+        }
+
+        constexpr auto masks(mask_event const& e) noexcept -> void
+        {
+            ++chosen_masks[static_cast<std::size_t>(e.chosen)];
+            for (auto i = std::size_t{0}; i != e.scores.size(); ++i)
+                mask_scores[i] += static_cast<std::uint64_t>(e.scores[i]);
+        }
+
+        constexpr auto operator+=(stage_collector const& other) noexcept -> stage_collector&
+        {
+            for (auto i = std::size_t{0}; i != durations.size(); ++i)
+            {
+                durations[i] += other.durations[i];
+                bits[i] += other.bits[i];
+            }
+            for (auto i = std::size_t{0}; i != segments.size(); ++i)
+            {
+                segments[i] += other.segments[i];
+                characters[i] += other.characters[i];
+            }
+            for (auto i = std::size_t{0}; i != versions.size(); ++i)
+                versions[i] += other.versions[i];
+            for (auto i = std::size_t{0}; i != chosen_masks.size(); ++i)
+            {
+                chosen_masks[i] += other.chosen_masks[i];
+                mask_scores[i] += other.mask_scores[i];
+            }
+            return *this;
+        }
+
+        [[nodiscard]] friend constexpr auto durations_of(stage_collector const& c, stage s) noexcept
+            -> histogram const&
+        {
+            return c.durations[index(s)];
+        }
+
+        [[nodiscard]] friend constexpr auto bit_count(stage_collector const& c, stage s) noexcept
+        {
+            return c.bits[index(s)];
+        }
+
+        [[nodiscard]] friend constexpr auto segment_count(stage_collector const& c, mode m) noexcept
+        {
+            return c.segments[static_cast<std::size_t>(m)];
+        }
+
+        [[nodiscard]] friend constexpr auto character_count(stage_collector const& c, mode m) noexcept
+        {
+            return c.characters[static_cast<std::size_t>(m)];
+        }
+
+        [[nodiscard]] friend constexpr auto version_count(stage_collector const& c, int version) noexcept
+        {
+            return c.versions[static_cast<std::size_t>(version-1)];
+        }
+
+        [[nodiscard]] friend constexpr auto mask_count(stage_collector const& c, int mask) noexcept
+        {
+            return c.chosen_masks[static_cast<std::size_t>(mask)];
+        }
+
+        [[nodiscard]] friend constexpr auto mask_score_sum(stage_collector const& c, int mask) noexcept
+        {
+            return c.mask_scores[static_cast<std::size_t>(mask)];
+        }
+
+    private:
+        [[nodiscard]] static constexpr auto index(stage s) noexcept -> std::size_t
+        {
+            return static_cast<std::size_t>(number(s));
+        }
+
+        std::array<std::int64_t, stage_count> started = {};
+        std::array<histogram, stage_count> durations = {};
+        std::array<std::uint64_t, stage_count> bits = {};
+        std::array<std::uint64_t, 5> segments = {};
+        std::array<std::uint64_t, 5> characters = {};
+        std::array<std::uint64_t, 40> versions = {};
+        std::array<std::uint64_t, 8> chosen_masks = {};
+        std::array<std::uint64_t, 8> mask_scores = {};
+    };
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+namespace qrcode::trace::test
+{
+    constexpr auto histograms_count_durations_in_power_of_two_buckets()
+    {
+        constexpr auto h = []
+        {
+            auto h = histogram{};
+            h.add(0);
+            h.add(1);
+            h.add(700);
+            h.add(1000);
+            h.add(1500);
+            return h;
+        }();
+
+        static_assert(count(h) == 5);
+        static_assert(total_ns(h) == 3201);
+        static_assert(min_ns(h) == 0);
+        static_assert(max_ns(h) == 1500);
+        static_assert(bucket(h, 0) == 1);
+        static_assert(bucket(h, 1) == 1);
+        static_assert(bucket(h, 10) == 2);
+        static_assert(bucket(h, 11) == 1);
+        static_assert(quantile_ns(h, 0.5) == 1023);
+        static_assert(quantile_ns(h, 1.0) == 1500);
+        static_assert(min_ns(histogram{}) == 0);
+    }
+
+    constexpr auto stage_collectors_aggregate_events_and_can_be_merged()
+    {
+        constexpr auto c = []
+        {
+            auto collect = []
+            {
+                auto c = stage_collector{};
+                c.begin(stage_event{stage::code_bits, 100});
+                c.end(stage_event{stage::code_bits, 400, 208});
+                c.segment(segment_event{mode::numeric, 8});
+                c.version(version_event{1, 1});
+                c.masks(mask_event{{10, 20, 30, 40, 50, 60, 70, 80}, 0});
+                return c;
+            };
+            auto c = collect();
+            c += collect();
+            return c;
+        }();
+
+        static_assert(Tracer<stage_collector>);
+        static_assert(detail::reports_segments<stage_collector>);
+        static_assert(detail::reports_masks<stage_collector>);
+
+        static_assert(count(durations_of(c, stage::code_bits)) == 2);
+        static_assert(total_ns(durations_of(c, stage::code_bits)) == 600);
+        static_assert(count(durations_of(c, stage::data_masking)) == 0);
+        static_assert(bit_count(c, stage::code_bits) == 416);
+        static_assert(segment_count(c, mode::numeric) == 2);
+        static_assert(character_count(c, mode::numeric) == 16);
+        static_assert(version_count(c, 1) == 2);
+        static_assert(mask_count(c, 0) == 2);
+        static_assert(mask_score_sum(c, 7) == 160);
+    }
+}
+#endif
@@ -0,0 +1,185 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
+#include <qrcode/data/optimizer/mode.h>
+
+namespace qrcode::trace
+{
+    using qrcode::data::optimizer::mode;
+
+    enum class stage {fit_version, encode_data, code_bits, make_raw_code, data_masking};
+
+    inline constexpr auto stage_count = 5;
+
+    [[nodiscard]] constexpr auto number(stage s) noexcept
+    {
+        return static_cast<int>(s);
+    }
+
+    // timestamps are taken from the steady clock, constant evaluation has no clock and reports 0
+    struct stage_event
+    {
+        trace::stage stage;
+        std::int64_t timestamp_ns = 0;
+        int bit_count = 0;
+
+        friend constexpr auto operator==(stage_event const&, stage_event const&) noexcept -> bool = default;
+    };
+
+    struct segment_event
+    {
+        trace::mode mode;
+        int character_count;
+
+        friend constexpr auto operator==(segment_event const&, segment_event const&) noexcept -> bool = default;
+    };
+
+    // the error level is given by its format information bits
+    struct version_event
+    {
+        int version;
+        int error_level;
+
+        friend constexpr auto operator==(version_event const&, version_event const&) noexcept -> bool = default;
+    };
+
+    // the scores are the full penalty scores of all masks, computed after the masking stage ended
+    struct mask_event
+    {
+        std::array<int, 8> scores;
+        int chosen;
+
+        friend constexpr auto operator==(mask_event const&, mask_event const&) noexcept -> bool = default;
+    };
+
+    // a tracer observes stage begin and end events, the segment, version and mask events
+    // are optional and only reported to tracers with matching members
+    template<class T>
+    concept Tracer = requires(std::remove_cvref_t<T>& tracer, stage_event const& event)
+    {
+        tracer.begin(event);
+        tracer.end(event);
+    };
+
+    struct null_tracer
+    {
+        constexpr auto begin(stage_event const&) const noexcept {}
+        constexpr auto end(stage_event const&) const noexcept {}
+    };
+
+    template<class T>
+    inline constexpr auto enabled = !std::same_as<std::remove_cvref_t<T>, null_tracer>;
+}
+
+namespace qrcode::trace::detail
+{
+    [[nodiscard]] constexpr auto now_ns() noexcept -> std::int64_t
+    {
+        if (std::is_constant_evaluated())
+            return 0;
+
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    template<class T>
+    constexpr auto begin_stage(T& tracer, stage s) noexcept
+    {
+        if constexpr (enabled<T>)
+            tracer.begin(stage_event{s, now_ns()});
+    }
+
+    template<class T>
+    constexpr auto end_stage(T& tracer, stage s, int bit_count = 0) noexcept
+    {
+        if constexpr (enabled<T>)
+            tracer.end(stage_event{s, now_ns(), bit_count});
+    }
+
+    template<class T>
+    constexpr auto report_version(T& tracer, int version, int error_level) noexcept
+    {
+        if constexpr (requires { tracer.version(version_event{}); })
+            tracer.version(version_event{version, error_level});
+    }
+
+    template<class T>
+    constexpr auto report_segment(T& tracer, mode m, int character_count) noexcept
+    {
+        if constexpr (requires { tracer.segment(segment_event{}); })
+            tracer.segment(segment_event{m, character_count});
+    }
+
+    template<class T>
+    inline constexpr auto reports_segments = requires(T& tracer) { tracer.segment(segment_event{}); };
+
+    template<class T>
+    inline constexpr auto reports_masks = requires(T& tracer) { tracer.masks(mask_event{}); };
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+namespace qrcode::trace::test
+{
+    constexpr auto the_null_tracer_is_a_disabled_tracer()
+    {
+        static_assert(Tracer<null_tracer>);
+        static_assert(Tracer<null_tracer&>);
+        static_assert(!enabled<null_tracer>);
+        static_assert(!enabled<null_tracer const&>);
+        static_assert(!detail::reports_segments<null_tracer>);
+        static_assert(!detail::reports_masks<null_tracer>);
+        static_assert(!Tracer<int>);
+    }
+
+    constexpr auto stage_events_carry_no_timestamp_during_constant_evaluation()
+    {
+        struct last_event
+        {
+            constexpr auto begin(stage_event const& e) noexcept { begun = e; }
+            constexpr auto end(stage_event const& e) noexcept { ended = e; }
+            stage_event begun{stage::fit_version};
+            stage_event ended{stage::fit_version};
+        };
+        static_assert(Tracer<last_event>);
+        static_assert(enabled<last_event&>);
+
+        constexpr auto events = []
+        {
+            auto tracer = last_event{};
+            detail::begin_stage(tracer, stage::code_bits);
+            detail::end_stage(tracer, stage::code_bits, 208);
+            return tracer;
+        }();
+        static_assert(events.begun == stage_event{stage::code_bits, 0, 0});
+        static_assert(events.ended == stage_event{stage::code_bits, 0, 208});
+    }
+}
+#endif
@@ -0,0 +1,73 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace qrcode::zlib
+{
+    // running checksum of the uncompressed data which closes a zlib stream
+    class adler32
+    {
+    public:
+        constexpr auto update(std::uint8_t byte) noexcept
+        {
+            a = (a + byte) % modulus;
+            b = (b + a) % modulus;
+        }
+
+        [[nodiscard]] constexpr auto value() const noexcept
+        {
+            return b << 16 | a;
+        }
+
+    private:
+        static constexpr auto modulus = std::uint32_t{65521};
+
+        std::uint32_t a = 1;
+        std::uint32_t b = 0;
+    };
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#include <string_view>
+
+namespace qrcode::zlib::test
+{
+    constexpr auto adler32_sums_up_the_bytes_passed()
+    {
+        auto f = [](std::string_view text)
+        {
+            auto checksum = adler32{};
+            for (auto c : text)
+                checksum.update(static_cast<std::uint8_t>(c));
+            return checksum.value();
+        };
+
+        static_assert(f("") == 0x00000001u);
+        static_assert(f("a") == 0x00620062u);
+        static_assert(f("Wikipedia") == 0x11E60398u);
+    }
+}
+#endif
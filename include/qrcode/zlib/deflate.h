@@ -0,0 +1,374 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <qrcode/zlib/adler32.h>
+
+namespace qrcode::zlib::detail
+{
+    [[nodiscard]] constexpr auto reverse_bits(std::uint32_t code, int length) noexcept
+    {
+        auto reversed = std::uint32_t{0};
+        for (auto i = 0; i != length; ++i, code >>= 1)
+            reversed = reversed << 1 | (code & 1);
+        return reversed;
+    }
+
+    // deflate streams are filled starting at the least significant bit of every byte
+    template<class Sink>
+    class bit_writer
+    {
+    public:
+        explicit constexpr bit_writer(Sink sink_) noexcept
+        : out{std::move(sink_)}
+        {
+        }
+
+        constexpr auto write(std::uint32_t value, int count) noexcept
+        {
+            buffer |= std::uint64_t{value} << pending;
+            pending += count;
+            for (; pending >= 8; pending -= 8, buffer >>= 8)
+                out(static_cast<std::uint8_t>(buffer & 0xFF));
+        }
+
+        // huffman codes are the only values stored with their most significant bit first
+        constexpr auto write_code(std::uint32_t code, int length) noexcept
+        {
+            write(reverse_bits(code, length), length);
+        }
+
+        constexpr auto flush() noexcept
+        {
+            if (pending > 0)
+                out(static_cast<std::uint8_t>(buffer & 0xFF));
+            buffer = 0;
+            pending = 0;
+        }
+
+        [[nodiscard]] constexpr auto sink() noexcept -> Sink&
+        {
+            return out;
+        }
+
+    private:
+        Sink out;
+        std::uint64_t buffer = 0;
+        int pending = 0;
+    };
+
+    inline constexpr auto length_bases = std::array{
+        3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258};
+    inline constexpr auto length_extra_bits = std::array{
+        0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0};
+
+    inline constexpr auto distance_bases = std::array{
+        1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,
+        1025,1537,2049,3073,4097,6145,8193,12289,16385,24577};
+    inline constexpr auto distance_extra_bits = std::array{
+        0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13};
+
+    // index of the last base not above given value
+    template<std::size_t N>
+    [[nodiscard]] constexpr auto base_index(std::array<int,N> const& bases, int value) noexcept
+    {
+        auto const i = std::ranges::upper_bound(bases, value) - begin(bases);
+        return static_cast<int>(i) - 1;
+    }
+
+    // codes of the fixed huffman table, see RFC 1951 3.2.6
+    template<class Sink>
+    constexpr auto write_literal(bit_writer<Sink>& bits, int symbol) noexcept
+    {
+        if (symbol < 144)
+            bits.write_code(0x30 + symbol, 8);
+        else if (symbol < 256)
+            bits.write_code(0x190 + (symbol - 144), 9);
+        else if (symbol < 280)
+            bits.write_code(symbol - 256, 7);
+        else
+            bits.write_code(0xC0 + (symbol - 280), 8);
+    }
+
+    template<class Sink>
+    constexpr auto write_match(bit_writer<Sink>& bits, int length, int distance) noexcept
+    {
+        auto const l = base_index(length_bases, length);
+        write_literal(bits, 257 + l);
+        bits.write(static_cast<std::uint32_t>(length - length_bases[l]), length_extra_bits[l]);
+
+        auto const d = base_index(distance_bases, distance);
+        bits.write_code(static_cast<std::uint32_t>(d), 5);
+        bits.write(static_cast<std::uint32_t>(distance - distance_bases[d]), distance_extra_bits[d]);
+    }
+}
+
+namespace qrcode::zlib
+{
+    // raw deflate stream (RFC 1951) using the fixed huffman codes;
+    // the input may be passed piece by piece and matches are only searched within
+    // a sliding window, so the memory used does not grow with the size of the input
+    template<class Sink>
+    requires std::is_invocable_v<Sink&, std::uint8_t>
+    class deflater
+    {
+        static constexpr auto window_size = 32768;
+        static constexpr auto buffer_size = 2 * window_size;
+        static constexpr auto min_match = 3;
+        static constexpr auto max_match = 258;
+        static constexpr auto hash_size = 1 << 15;
+        static constexpr auto max_chain = 32;
+        static constexpr auto end_of_block = 256;
+
+    public:
+        explicit constexpr deflater(Sink sink) noexcept
+        : bits{std::move(sink)}
+        , buffer(buffer_size)
+        , head(hash_size, -1)
+        , previous(buffer_size, -1)
+        {
+            bits.write(0b010, 3); // non-final block, fixed huffman codes
+        }
+
+        constexpr auto write(std::span<std::uint8_t const> data) noexcept
+        {
+            while (!data.empty())
+            {
+                auto const count = std::min(data.size(), static_cast<std::size_t>(buffer_size - end));
+                std::ranges::copy(data.first(count), begin(buffer) + end);
+                end += static_cast<int>(count);
+                data = data.subspan(count);
+
+                if (end == buffer_size)
+                {
+                    compress(end - max_match);
+                    slide();
+                }
+            }
+        }
+
+        // the stream is closed by an empty final block
+        constexpr auto finish() noexcept
+        {
+            compress(end);
+            detail::write_literal(bits, end_of_block);
+            bits.write(0b011, 3);
+            detail::write_literal(bits, end_of_block);
+            bits.flush();
+        }
+
+        [[nodiscard]] constexpr auto sink() noexcept -> Sink&
+        {
+            return bits.sink();
+        }
+
+    private:
+        [[nodiscard]] constexpr auto hash(int at) const noexcept
+        {
+            return ((buffer[at] << 10) ^ (buffer[at+1] << 5) ^ buffer[at+2]) & (hash_size - 1);
+        }
+
+        constexpr auto insert(int at) noexcept
+        {
+            if (at + min_match > end)
+                return;
+            auto& bucket = head[hash(at)];
+            previous[at] = bucket;
+            bucket = at;
+        }
+
+        [[nodiscard]] constexpr auto longest_match(int at) const noexcept
+        {
+            auto best = std::pair{0, 0};
+            if (at + min_match > end)
+                return best;
+
+            auto const limit = std::min(max_match, end - at);
+            auto candidate = head[hash(at)];
+            for (auto chain = 0; candidate >= 0 && at - candidate <= window_size && chain != max_chain; ++chain)
+            {
+                auto length = 0;
+                while (length != limit && buffer[candidate + length] == buffer[at + length])
+                    ++length;
+
+                if (length > best.first)
+                    best = {length, at - candidate};
+                if (length == limit)
+                    break;
+
+                candidate = previous[candidate];
+            }
+            return best;
+        }
+
+        constexpr auto compress(int limit) noexcept
+        {
+            while (position < limit)
+            {
+                auto const [length, distance] = longest_match(position);
+                if (length >= min_match)
+                {
+                    detail::write_match(bits, length, distance);
+                    for (auto i = 0; i != length; ++i)
+                        insert(position++);
+                }
+                else
+                {
+                    detail::write_literal(bits, buffer[position]);
+                    insert(position++);
+                }
+            }
+        }
+
+        // the second half of the buffer becomes the history of the following input
+        constexpr auto slide() noexcept
+        {
+            auto const shifted = [](int at) { return at >= window_size ? at - window_size : -1; };
+
+            std::copy(begin(buffer) + window_size, begin(buffer) + buffer_size, begin(buffer));
+            std::ranges::transform(head, begin(head), shifted);
+            std::transform(begin(previous) + window_size, begin(previous) + buffer_size, begin(previous), shifted);
+            std::fill(begin(previous) + window_size, begin(previous) + buffer_size, -1);
+
+            end -= window_size;
+            position -= window_size;
+        }
+
+        detail::bit_writer<Sink> bits;
+        std::vector<std::uint8_t> buffer;
+        std::vector<int> head;
+        std::vector<int> previous;
+        int end = 0;
+        int position = 0;
+    };
+
+    // zlib stream (RFC 1950): a deflate stream framed by a header and the adler-32 checksum
+    template<class Sink>
+    requires std::is_invocable_v<Sink&, std::uint8_t>
+    class zlib_deflater
+    {
+    public:
+        explicit constexpr zlib_deflater(Sink sink) noexcept
+        : deflate{header(std::move(sink))}
+        {
+        }
+
+        constexpr auto write(std::span<std::uint8_t const> data) noexcept
+        {
+            for (auto byte : data)
+                checksum.update(byte);
+            deflate.write(data);
+        }
+
+        constexpr auto finish() noexcept
+        {
+            deflate.finish();
+            auto const value = checksum.value();
+            for (auto shift = 24; shift >= 0; shift -= 8)
+                deflate.sink()(static_cast<std::uint8_t>(value >> shift));
+        }
+
+    private:
+        [[nodiscard]] static constexpr auto header(Sink sink) noexcept
+        {
+            sink(std::uint8_t{0x78}); // deflate with a 32K window
+            sink(std::uint8_t{0x01}); // fastest compression level, no dictionary
+            return sink;
+        }
+
+        deflater<Sink> deflate;
+        adler32 checksum;
+    };
+
+    [[nodiscard]] constexpr auto compress(std::span<std::uint8_t const> data)
+    {
+        auto compressed = std::vector<std::uint8_t>{};
+        auto stream = zlib_deflater{[&compressed](std::uint8_t byte) { compressed.push_back(byte); }};
+        stream.write(data);
+        stream.finish();
+        return compressed;
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#if defined(__cpp_lib_constexpr_vector)
+namespace qrcode::zlib::detail::test
+{
+    constexpr auto bit_writer_fills_bytes_from_the_least_significant_bit()
+    {
+        auto f = []
+        {
+            auto bytes = std::vector<std::uint8_t>{};
+            auto bits = bit_writer{[&bytes](std::uint8_t byte) { bytes.push_back(byte); }};
+            bits.write(0b1, 1);
+            bits.write(0b10, 2);
+            bits.write_code(0b1100, 4);
+            bits.write(0xAB, 8);
+            bits.flush();
+            return bytes == std::vector<std::uint8_t>{0b1'0011'101, 0b0101'0101};
+        };
+        static_assert(f());
+    }
+
+    constexpr auto base_index_finds_the_code_of_lengths_and_distances()
+    {
+        static_assert(base_index(length_bases, 3) == 0);
+        static_assert(base_index(length_bases, 12) == 8);
+        static_assert(base_index(length_bases, 257) == 27);
+        static_assert(base_index(length_bases, 258) == 28);
+        static_assert(base_index(distance_bases, 1) == 0);
+        static_assert(base_index(distance_bases, 32768) == 29);
+    }
+}
+
+namespace qrcode::zlib::test
+{
+    constexpr auto compress_writes_a_zlib_stream_with_fixed_huffman_codes()
+    {
+        static_assert(compress(std::vector<std::uint8_t>{}) 
+            == std::vector<std::uint8_t>{0x78, 0x01, 0x02, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x01});
+        static_assert(compress(std::vector<std::uint8_t>{'a'}) 
+            == std::vector<std::uint8_t>{0x78, 0x01, 0x4A, 0x04, 0x0C, 0x00, 0x00, 0x62, 0x00, 0x62});
+    }
+
+    constexpr auto compress_replaces_repetitions_by_matches()
+    {
+        auto f = []
+        {
+            auto const zeros = std::vector<std::uint8_t>(1000, 0);
+            return compress(zeros).size() < 20;
+        };
+        static_assert(f());
+    }
+}
+#endif
+#endif
@@ -0,0 +1,380 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <qrcode/packed_symbol.h>
+#include <qrcode/static_packed_symbol.h>
+#include <qrcode/symbol.h>
+#include <qrcode/structure/dimension.h>
+#include <qrcode/structure/module_traits.h>
+#include <qrcode/zlib/deflate.h>
+
+namespace qrcode
+{
+    enum class zpl_compression
+    {
+        ascii_hex,  // run-length compressed hexadecimal digits
+        z64         // zlib compressed and base64 encoded
+    };
+
+    struct zpl_format
+    {
+        int magnification = 1;  // printer dots per module
+        int quiet_zone = 4;     // light modules around the symbol
+        zpl_compression compression = zpl_compression::ascii_hex;
+    };
+}
+
+namespace qrcode::detail
+{
+    using qrcode::structure::dimension;
+
+    [[nodiscard]] constexpr auto hex_digit(int nibble) noexcept
+    {
+        return "0123456789ABCDEF"[nibble];
+    }
+
+    // repetitions of the following digit: G to Y count 1 to 19, g to z count 20 to 400
+    template<class Stream>
+    constexpr auto zpl_repeat_count(Stream& stream, int count)
+    {
+        if (count == 1)
+            return;
+
+        for (; count >= 20; count -= std::min(count / 20, 20) * 20)
+            stream << static_cast<char>('g' + std::min(count / 20, 20) - 1);
+
+        if (count > 0)
+            stream << static_cast<char>('G' + count - 1);
+    }
+
+    // ',' and '!' fill the rest of a row with 0 or F, ':' repeats the previous row
+    template<class Stream>
+    constexpr auto zpl_ascii_row(Stream& stream, std::span<std::uint8_t const> bytes, std::span<std::uint8_t const> previous)
+    {
+        if (std::ranges::equal(bytes, previous))
+        {
+            stream << ':';
+            return;
+        }
+
+        auto const nibble = [bytes](int i) { return i % 2 == 0 ? bytes[i/2] >> 4 : bytes[i/2] & 0xF; };
+        auto const nibbles = static_cast<int>(bytes.size()) * 2;
+
+        for (auto i = 0; i != nibbles;)
+        {
+            auto run = 1;
+            while (i + run != nibbles && nibble(i + run) == nibble(i))
+                ++run;
+
+            if (i + run == nibbles && (nibble(i) == 0x0 || nibble(i) == 0xF))
+            {
+                stream << (nibble(i) == 0x0 ? ',' : '!');
+                return;
+            }
+
+            zpl_repeat_count(stream, run);
+            stream << hex_digit(nibble(i));
+            i += run;
+        }
+    }
+
+    // CRC-16 with the CCITT polynomial over the base64 text, closing a Z64 field
+    [[nodiscard]] constexpr auto crc16(std::uint16_t crc, char c) noexcept
+    {
+        crc ^= static_cast<std::uint16_t>(static_cast<std::uint8_t>(c) << 8);
+        for (auto bit = 0; bit != 8; ++bit)
+            crc = static_cast<std::uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1);
+        return crc;
+    }
+
+    template<class Stream>
+    class base64_writer
+    {
+    public:
+        explicit constexpr base64_writer(Stream& stream_) noexcept
+        : stream{&stream_}
+        {
+        }
+
+        constexpr auto operator()(std::uint8_t byte)
+        {
+            group = group << 8 | byte;
+            if (++count == 3)
+                flush();
+        }
+
+        constexpr auto flush()
+        {
+            if (count == 0)
+                return;
+
+            group <<= 8 * (3 - count);
+            for (auto i = 0; i != 4; ++i)
+                put(i <= count ? digit((group >> (18 - 6 * i)) & 0x3F) : '=');
+            group = 0;
+            count = 0;
+        }
+
+        [[nodiscard]] constexpr auto checksum() const noexcept
+        {
+            return crc;
+        }
+
+    private:
+        [[nodiscard]] static constexpr auto digit(std::uint32_t value) noexcept
+        {
+            return "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[value];
+        }
+
+        constexpr auto put(char c)
+        {
+            *stream << c;
+            crc = crc16(crc, c);
+        }
+
+        Stream* stream;
+        std::uint32_t group = 0;
+        int count = 0;
+        std::uint16_t crc = 0;
+    };
+
+    // one printer row of dots, the most significant bit is the leftmost dot
+    template<class Is_Set>
+    constexpr auto zpl_dot_row(std::span<std::uint8_t> bytes, dimension extend, int y, Is_Set&& is_set, zpl_format const& format)
+    {
+        std::ranges::fill(bytes, std::uint8_t{0});
+        if (y < 0 || y >= height(extend))
+            return;
+
+        for (auto x = 0; x != width(extend); ++x)
+        {
+            if (!is_set(x, y))
+                continue;
+
+            auto const first = (format.quiet_zone + x) * format.magnification;
+            for (auto dot = first; dot != first + format.magnification; ++dot)
+                bytes[dot / 8] |= static_cast<std::uint8_t>(0x80 >> (dot % 8));
+        }
+    }
+
+    // ^GF graphic field of given modules; rows are converted one after another,
+    // so only two printer rows are held in memory besides the compression window
+    template<class Stream, class Is_Set>
+    constexpr auto zpl_graphic_field(Stream& stream, dimension extend, Is_Set&& is_set, zpl_format const& format)
+    {
+        auto const modules_per_row = width(extend) + 2 * format.quiet_zone;
+        auto const module_rows = height(extend) + 2 * format.quiet_zone;
+        auto const bytes_per_row = (modules_per_row * format.magnification + 7) / 8;
+        auto const total_bytes = bytes_per_row * module_rows * format.magnification;
+
+        stream << "^GFA," << total_bytes << "," << total_bytes << "," << bytes_per_row << ",";
+
+        auto current = std::vector<std::uint8_t>(static_cast<std::size_t>(bytes_per_row));
+        auto previous = std::vector<std::uint8_t>{};
+
+        if (format.compression == zpl_compression::ascii_hex)
+        {
+            for (auto y = 0; y != module_rows; ++y)
+            for (auto repeat = 0; repeat != format.magnification; ++repeat)
+            {
+                zpl_dot_row(current, extend, y - format.quiet_zone, is_set, format);
+                zpl_ascii_row(stream, current, previous);
+                previous = current;
+            }
+        }
+        else
+        {
+            auto base64 = base64_writer<Stream>{stream};
+            auto zlib = zlib::zlib_deflater{[&base64](std::uint8_t byte) { base64(byte); }};
+
+            stream << ":Z64:";
+            for (auto y = 0; y != module_rows; ++y)
+            {
+                zpl_dot_row(current, extend, y - format.quiet_zone, is_set, format);
+                for (auto repeat = 0; repeat != format.magnification; ++repeat)
+                    zlib.write(current);
+            }
+            zlib.finish();
+            base64.flush();
+
+            auto const crc = base64.checksum();
+            stream << ':';
+            for (auto shift = 12; shift >= 0; shift -= 4)
+                stream << hex_digit((crc >> shift) & 0xF);
+        }
+        stream << "^FS\n";
+    }
+
+    template<class Stream, class Is_Set>
+    constexpr auto zpl_label(Stream& stream, dimension extend, Is_Set&& is_set, zpl_format const& format)
+    {
+        stream << "^XA\n^FO0,0";
+        zpl_graphic_field(stream, extend, is_set, format);
+        stream << "^XZ\n";
+    }
+}
+
+namespace qrcode
+{
+    // label for thermal printers speaking ZPL, the symbol is sent as a graphic field
+    //
+    // example:
+    //
+    // auto symbol = ...;
+    // std::ofstream file{"qrcode.zpl", std::ofstream::out};
+    // zpl(file, symbol, {.magnification = 4, .compression = zpl_compression::z64});
+    //
+    template<class Stream, class Module, Symbol_Designator Designator>
+    constexpr auto zpl(Stream& stream, symbol<Module, Designator> const& symbol, zpl_format const& format = zpl_format{})
+    {
+        using qrcode::structure::module_traits;
+        auto const& code = modules(symbol);
+        qrcode::detail::zpl_label(stream, size(code), 
+            [&code](int x, int y) { return module_traits<Module>::is_set(row(code, y)[x]); }, format);
+    }
+
+    template<class Stream, Symbol_Designator Designator>
+    constexpr auto zpl(Stream& stream, packed_symbol<Designator> const& packed, zpl_format const& format = zpl_format{})
+    {
+        qrcode::detail::zpl_label(stream, size(packed.modules), 
+            [&packed](int x, int y) { return is_set(packed.modules, {x, y}); }, format);
+    }
+
+    template<class Stream, Symbol_Designator Designator, int Width>
+    constexpr auto zpl(Stream& stream, static_packed_symbol<Designator, Width> const& packed, zpl_format const& format = zpl_format{})
+    {
+        qrcode::detail::zpl_label(stream, size(packed), 
+            [&packed](int x, int y) { return is_set(packed, {x, y}); }, format);
+    }
+}
+
+#ifdef QRCODE_TESTS_ENABLED
+#if defined(__cpp_lib_constexpr_string)
+#include <string>
+
+namespace qrcode::detail::test
+{
+    struct string_stream
+    {
+        std::string text;
+
+        constexpr auto operator<<(char c) -> string_stream& { text += c; return *this; }
+        constexpr auto operator<<(char const* s) -> string_stream& { text += s; return *this; }
+        constexpr auto operator<<(int value) -> string_stream&
+        {
+            auto digits = std::string{};
+            do { digits.insert(digits.begin(), static_cast<char>('0' + value % 10)); value /= 10; } while (value != 0);
+            text += digits;
+            return *this;
+        }
+    };
+
+    constexpr auto zpl_repeat_counts_combine_both_letter_ranges()
+    {
+        auto f = [](int count)
+        {
+            auto stream = string_stream{};
+            zpl_repeat_count(stream, count);
+            return stream.text;
+        };
+
+        static_assert(f(1) == "");
+        static_assert(f(2) == "H");
+        static_assert(f(19) == "Y");
+        static_assert(f(20) == "g");
+        static_assert(f(41) == "hG");
+        static_assert(f(400) == "z");
+        static_assert(f(425) == "zgK");
+    }
+
+    constexpr auto zpl_ascii_rows_are_run_length_compressed()
+    {
+        auto f = [](std::vector<std::uint8_t> row, std::vector<std::uint8_t> previous)
+        {
+            auto stream = string_stream{};
+            zpl_ascii_row(stream, row, previous);
+            return stream.text;
+        };
+
+        static_assert(f({0x00, 0x00}, {}) == ",");
+        static_assert(f({0xFF, 0xFF}, {}) == "!");
+        static_assert(f({0xF0, 0x0F}, {0xF0, 0x0F}) == ":");
+        static_assert(f({0xF0, 0x0F}, {}) == "FH0!");
+        static_assert(f({0x0F, 0xF0, 0x00}, {}) == "0HF,");
+        static_assert(f({0x12, 0xFF}, {}) == "12!");
+    }
+
+    constexpr auto base64_writer_encodes_groups_of_three_bytes()
+    {
+        auto f = [](std::string_view bytes)
+        {
+            auto stream = string_stream{};
+            auto base64 = base64_writer{stream};
+            for (auto c : bytes)
+                base64(static_cast<std::uint8_t>(c));
+            base64.flush();
+            return stream.text;
+        };
+
+        static_assert(f("") == "");
+        static_assert(f("M") == "TQ==");
+        static_assert(f("Ma") == "TWE=");
+        static_assert(f("Man") == "TWFu");
+        static_assert(f("Many") == "TWFueQ==");
+    }
+
+    constexpr auto crc16_uses_the_ccitt_polynomial()
+    {
+        auto f = [](std::string_view text)
+        {
+            auto crc = std::uint16_t{0};
+            for (auto c : text)
+                crc = crc16(crc, c);
+            return crc;
+        };
+
+        static_assert(f("123456789") == 0x31C3);
+    }
+
+    constexpr auto zpl_graphic_fields_scale_the_symbol_and_add_a_quiet_zone()
+    {
+        auto f = []
+        {
+            auto stream = string_stream{};
+            auto const checker = [](int x, int y) { return (x + y) % 2 == 0; };
+            zpl_graphic_field(stream, dimension{2,2}, checker, zpl_format{.magnification = 2, .quiet_zone = 1});
+            return stream.text;
+        };
+        // 8 dots per row: 00 11 00 00 and 00 00 11 00
+        static_assert(f() == "^GFA,8,8,1,,:3,:0C:,:^FS\n");
+    }
+}
+#endif
+#endif
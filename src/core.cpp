@@ -0,0 +1,77 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string_view>
+
+#include <qrcode/core/core.h>
+#include <qrcode/micro_qr/micro_qr.h>
+#include <qrcode/qr/qr.h>
+
+namespace qrcode::core
+{
+    namespace
+    {
+        [[nodiscard]] auto as_chars(std::span<std::byte const> bytes) noexcept
+        {
+            return std::string_view{reinterpret_cast<char const*>(bytes.data()), bytes.size()};
+        }
+
+        template<class Symbol>
+        [[nodiscard]] auto pack_result(result<Symbol> const& symbol)
+        {
+            using packed_type = decltype(pack(symbol.value()));
+            if (!symbol)
+                return result<packed_type>{symbol.error()};
+            return result<packed_type>{pack(symbol.value())};
+        }
+    }
+
+    auto make_qr_symbol(
+        std::span<std::byte const> message, 
+        std::optional<std::int32_t> eci_assignment_number,
+        qr::error_correction error_level,
+        std::optional<qr::symbol_version> version) -> result<qr_symbol>
+    {
+        auto const make = [&](auto const& text)
+        {
+            return pack_result(version 
+                ? qr::make_symbol(text, *version, error_level) 
+                : qr::make_symbol(text, error_level));
+        };
+
+        if (eci_assignment_number)
+            return make(eci::view{eci::assignment_number{*eci_assignment_number}, as_chars(message)});
+        return make(as_chars(message));
+    }
+
+    auto make_micro_qr_symbol(
+        std::span<std::byte const> message, 
+        std::optional<micro_qr::error_correction> error_level,
+        std::optional<micro_qr::symbol_version> version) -> result<micro_qr_symbol>
+    {
+        return pack_result(version 
+            ? micro_qr::make_symbol(as_chars(message), *version, error_level) 
+            : micro_qr::make_symbol(as_chars(message), error_level));
+    }
+}
@@ -30,7 +30,13 @@
 
 #include <qrcode/result.h>
 #include <qrcode/svg.h>
+#include <qrcode/pbm.h>
+#include <qrcode/zpl.h>
+#include <qrcode/pdf.h>
 #include <qrcode/symbol.h>
+#include <qrcode/decoded_symbol.h>
+#include <qrcode/packed_symbol.h>
+#include <qrcode/static_packed_symbol.h>
 
 #include <qrcode/code/bit_view.h>
 #include <qrcode/code/block_info.h>
@@ -39,6 +45,7 @@
 #include <qrcode/code/code_capacity.h>
 #include <qrcode/code/codeword_view.h>
 #include <qrcode/code/error_correction_code.h>
+#include <qrcode/code/error_correction_decoder.h>
 #include <qrcode/code/error_correction_polynomial.h>
 #include <qrcode/code/extended_remainder.h>
 #include <qrcode/code/format_encoding.h>
@@ -47,14 +54,21 @@
 #include <qrcode/code/padding_view.h>
 #include <qrcode/code/polynomial.h>
 #include <qrcode/code/polynomial_view.h>
+#include <qrcode/code/power_table.h>
 #include <qrcode/code/sequence.h>
+#include <qrcode/code/sequence_blocks.h>
 #include <qrcode/code/sequence_description.h>
 #include <qrcode/code/sequence_permutation.h>
 #include <qrcode/code/sequence_view.h>
+#include <qrcode/code/syndrome.h>
 
 #include <qrcode/data/alphanumeric.h>
 #include <qrcode/data/alphanumeric_encoding.h>
 #include <qrcode/data/alphanumeric_encoder.h>
+#include <qrcode/data/bit_reader.h>
+#include <qrcode/data/segment_decoding.h>
+#include <qrcode/data/segment_stream.h>
+#include <qrcode/data/structured_append.h>
 #include <qrcode/data/bit_stream.h>
 #include <qrcode/data/byte.h>
 #include <qrcode/data/byte_encoder.h>
@@ -63,11 +77,14 @@
 #include <qrcode/data/kanji.h>
 #include <qrcode/data/kanji_encoding.h>
 #include <qrcode/data/kanji_encoder.h>
+#include <qrcode/data/shift_jis.h>
+#include <qrcode/data/shift_jis_table.h>
 #include <qrcode/data/numeric.h>
 #include <qrcode/data/numeric_encoding.h>
 #include <qrcode/data/numeric_encoder.h>
 
 #include <qrcode/data/best_fit/best_encoder.h>
+#include <qrcode/data/best_fit/character_classes.h>
 #include <qrcode/data/best_fit/data_encoding.h>
 #include <qrcode/data/best_fit/data_length.h>
 
@@ -76,6 +93,7 @@
 #include <qrcode/data/optimizer/dispatch_mode.h>
 #include <qrcode/data/optimizer/mode.h>
 #include <qrcode/data/optimizer/optimizer_state.h>
+#include <qrcode/data/optimizer/streaming_state.h>
 #include <qrcode/data/optimizer/optimize.h>
 
 #include <qrcode/structure/apply_mask.h>
@@ -85,12 +103,15 @@
 #include <qrcode/structure/element_view.h>
 #include <qrcode/structure/horizontal_view.h>
 #include <qrcode/structure/make_matrix.h>
+#include <qrcode/structure/mask_plane.h>
+#include <qrcode/structure/packed_matrix.h>
 #include <qrcode/structure/matrix.h>
 #include <qrcode/structure/module.h>
 #include <qrcode/structure/module_traits.h>
 #include <qrcode/structure/occupied_columns.h>
 #include <qrcode/structure/place_data.h>
 #include <qrcode/structure/position.h>
+#include <qrcode/structure/read_data.h>
 #include <qrcode/structure/separator_pattern.h>
 #include <qrcode/structure/skip_column_view.h>
 #include <qrcode/structure/timing_pattern.h>
@@ -100,6 +121,19 @@
 #include <qrcode/eci/assignment_number.h>
 #include <qrcode/eci/message_header.h>
 #include <qrcode/eci/view.h>
+#include <qrcode/core/core.h>
+#include <qrcode/cache/fnv_hash.h>
+#include <qrcode/cache/clock_shard.h>
+#include <qrcode/cache/sharded_cache.h>
+#include <qrcode/archive/symbol_archive.h>
+#include <qrcode/archive/symbol_view.h>
+#include <qrcode/archive/symbol_record.h>
+#include <qrcode/pipeline/bounded_queue.h>
+#include <qrcode/pipeline/worker_thread.h>
+#include <qrcode/trace/tracer.h>
+#include <qrcode/trace/stage_collector.h>
+#include <qrcode/zlib/adler32.h>
+#include <qrcode/zlib/deflate.h>
 
 #include <qrcode/qr/qr.h>
 #include <qrcode/qr/adjacent_score.h>
@@ -108,12 +142,15 @@
 #include <qrcode/qr/code_bits.h>
 #include <qrcode/qr/code_capacity.h>
 #include <qrcode/qr/dark_module_score.h>
+#include <qrcode/qr/data_decoding.h>
+#include <qrcode/qr/decode.h>
 #include <qrcode/qr/data_encoding.h>
 #include <qrcode/qr/data_length.h>
 #include <qrcode/qr/symbol_designator.h>
 #include <qrcode/qr/encoders.h>
 #include <qrcode/qr/error_correction.h>
 #include <qrcode/qr/finalize_symbol.h>
+#include <qrcode/qr/finder_like_pattern.h>
 #include <qrcode/qr/finder_like_score.h>
 #include <qrcode/qr/finder_pattern.h>
 #include <qrcode/qr/format_information.h>
@@ -126,16 +163,26 @@
 #include <qrcode/qr/same_color_score.h>
 #include <qrcode/qr/raw_code.h>
 #include <qrcode/qr/separator_pattern.h>
+#include <qrcode/qr/static_penalty.h>
+#include <qrcode/qr/static_segments.h>
+#include <qrcode/qr/static_symbol.h>
 #include <qrcode/qr/symbol_version.h>
+#include <qrcode/qr/symbol_cache.h>
+#include <qrcode/qr/symbol_pipeline.h>
+#include <qrcode/qr/structured_append.h>
+#include <qrcode/qr/utf8.h>
 #include <qrcode/qr/timing_pattern.h>
 #include <qrcode/qr/total_data_bits.h>
 #include <qrcode/qr/total_blocks.h>
 #include <qrcode/qr/version_information.h>
+#include <qrcode/qr/verify.h>
 
 #include <qrcode/micro_qr/micro_qr.h>
 #include <qrcode/micro_qr/best_version.h>
 #include <qrcode/micro_qr/code_bits.h>
 #include <qrcode/micro_qr/code_capacity.h>
+#include <qrcode/micro_qr/data_decoding.h>
+#include <qrcode/micro_qr/decode.h>
 #include <qrcode/micro_qr/symbol_designator.h>
 #include <qrcode/micro_qr/encoders.h>
 #include <qrcode/micro_qr/error_correction.h>
@@ -151,6 +198,7 @@
 #include <qrcode/micro_qr/symbol_version.h>
 #include <qrcode/micro_qr/timing_pattern.h>
 #include <qrcode/micro_qr/total_data_bits.h>
+#include <qrcode/micro_qr/verify.h>
 
 #include <qrcode/qrcode.h>
 
@@ -0,0 +1,239 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string_view>
+
+#include <qrcode/cache/clock_shard.h>
+#include <qrcode/qr/symbol_cache.h>
+#include <qrcode/pbm.h>
+#include <qrcode/svg.h>
+
+#include "harness.h"
+
+namespace
+{
+    using qrcode::test::check;
+    using qrcode::test::registration;
+
+    using any_shard = qrcode::cache::clock_shard<int, int, std::hash<int>>;
+
+    [[nodiscard]] auto any_value(int value)
+    {
+        return std::make_shared<int const>(value);
+    }
+
+    auto clock_shards_miss_unknown_keys_and_hit_inserted_ones()
+    {
+        auto shard = any_shard{10};
+        check(shard.find(1) == nullptr);
+
+        auto const value = any_value(7);
+        auto const [stored, evictions] = shard.insert(1, value, 1);
+
+        check(stored == value && evictions == 0);
+        check(shard.find(1) == value);
+        check(shard.find(2) == nullptr);
+        check(size(shard) == 1 && weight(shard) == 1);
+    }
+
+    auto clock_shards_keep_the_first_value_inserted_for_a_key()
+    {
+        auto shard = any_shard{10};
+        auto const first = any_value(1);
+
+        static_cast<void>(shard.insert(1, first, 1));
+        auto const [stored, evictions] = shard.insert(1, any_value(2), 1);
+
+        check(stored == first && evictions == 0);
+        check(size(shard) == 1 && weight(shard) == 1);
+    }
+
+    auto clock_shards_do_not_store_values_heavier_than_the_shard()
+    {
+        auto shard = any_shard{2};
+        auto const value = any_value(1);
+        auto const [stored, evictions] = shard.insert(1, value, 3);
+
+        check(stored == value && evictions == 0);
+        check(shard.find(1) == nullptr && size(shard) == 0 && weight(shard) == 0);
+    }
+
+    auto clock_shards_evict_until_the_weight_limit_is_kept()
+    {
+        auto shard = any_shard{3};
+        static_cast<void>(shard.insert(1, any_value(1), 1));
+        static_cast<void>(shard.insert(2, any_value(2), 1));
+        static_cast<void>(shard.insert(3, any_value(3), 1));
+
+        auto const [stored, evictions] = shard.insert(4, any_value(4), 2);
+
+        check(evictions == 2 && *stored == 4);
+        check(shard.find(1) == nullptr && shard.find(2) == nullptr);
+        check(shard.find(3) != nullptr && shard.find(4) != nullptr);
+        check(size(shard) == 2 && weight(shard) == 3);
+    }
+
+    auto clock_shards_give_referenced_slots_a_second_chance()
+    {
+        auto shard = any_shard{2};
+        static_cast<void>(shard.insert(1, any_value(1), 1));
+        static_cast<void>(shard.insert(2, any_value(2), 1));
+        static_cast<void>(shard.find(1));
+
+        auto const [stored, evictions] = shard.insert(3, any_value(3), 1);
+
+        check(evictions == 1);
+        check(shard.find(1) != nullptr && shard.find(2) == nullptr && shard.find(3) != nullptr);
+    }
+
+    auto clock_shards_reuse_the_slots_of_evicted_entries()
+    {
+        auto shard = any_shard{1};
+        for (auto i = 0; i != 100; ++i)
+            static_cast<void>(shard.insert(i, any_value(i), 1));
+
+        check(size(shard) == 1 && weight(shard) == 1);
+        check(shard.find(99) != nullptr && *shard.find(99) == 99);
+    }
+
+    auto symbol_caches_share_the_symbol_of_a_key_and_count_hits_and_misses()
+    {
+        using namespace std::literals;
+        using qrcode::qr::error_correction;
+
+        auto cache = qrcode::qr::symbol_cache<1>{};
+        auto const first = cache.make_symbol("ABC"sv, error_correction::level_M);
+        auto const second = cache.make_symbol("ABC"sv, error_correction::level_M);
+        auto const other = cache.make_symbol("ABC"sv, error_correction::level_Q);
+
+        check(first && second && other);
+        check(first.value() == second.value() && first.value() != other.value());
+
+        auto const counts = statistics(cache);
+        check(counts.hits == 1 && counts.misses == 2 && counts.evictions == 0 && counts.entries == 2);
+    }
+
+    auto symbol_caches_do_not_cache_failures()
+    {
+        using namespace std::literals;
+        using qrcode::qr::error_correction;
+        using qrcode::qr::symbol_version;
+
+        auto cache = qrcode::qr::symbol_cache<1>{};
+        auto const too_long = "This is way too long for the smallest symbol version."sv;
+
+        check(!cache.make_symbol(too_long, symbol_version{1}, error_correction::level_H));
+        check(!cache.make_symbol(too_long, symbol_version{1}, error_correction::level_H));
+
+        auto const counts = statistics(cache);
+        check(counts.hits == 0 && counts.misses == 2 && counts.entries == 0 && counts.weight == 0);
+    }
+
+    auto symbol_caches_weigh_the_symbol_and_both_copies_of_the_key()
+    {
+        using namespace std::literals;
+        using qrcode::qr::error_correction;
+        using qrcode::qr::symbol_key;
+
+        auto cache = qrcode::qr::symbol_cache<1>{};
+        auto const any_message = "https://example.com"sv;
+        auto const symbol = cache.make_symbol(any_message, error_correction::level_M);
+
+        check(symbol.has_value());
+        check(statistics(cache).weight 
+            == byte_size(*symbol.value()) + 2 * (sizeof(symbol_key) + size(any_message)));
+    }
+
+    auto symbol_caches_evict_entries_beyond_their_capacity()
+    {
+        using namespace std::literals;
+        using qrcode::qr::error_correction;
+
+        auto probe = qrcode::qr::symbol_cache<1>{};
+        static_cast<void>(probe.make_symbol("AAA"sv, error_correction::level_M));
+        auto const entry_weight = statistics(probe).weight;
+
+        auto cache = qrcode::qr::symbol_cache<1>{entry_weight + entry_weight / 2};
+        auto const first = cache.make_symbol("AAA"sv, error_correction::level_M);
+        static_cast<void>(cache.make_symbol("BBB"sv, error_correction::level_M));
+        auto const again = cache.make_symbol("AAA"sv, error_correction::level_M);
+
+        check(first && again && first.value() != again.value());
+
+        auto const counts = statistics(cache);
+        check(counts.hits == 0 && counts.misses == 3 && counts.evictions == 2);
+        check(counts.entries == 1 && counts.weight <= entry_weight + entry_weight / 2);
+    }
+
+    auto cached_symbols_are_written_like_the_symbols_they_pack()
+    {
+        using namespace std::literals;
+        using qrcode::qr::error_correction;
+
+        auto cache = qrcode::qr::symbol_cache<1>{};
+        auto const any_message = "https://example.com"sv;
+        auto const cached = cache.make_symbol(any_message, error_correction::level_M);
+        auto const symbol = qrcode::qr::make_symbol<char>(any_message, error_correction::level_M);
+        check(cached && symbol);
+
+        auto const written = [](auto const& symbol, auto write)
+        {
+            auto stream = std::ostringstream{};
+            write(stream, symbol);
+            return stream.str();
+        };
+        auto const as_svg = [](auto& stream, auto const& symbol) { qrcode::svg(stream, symbol); };
+        auto const as_pbm = [](auto& stream, auto const& symbol) { qrcode::pbm(stream, symbol); };
+
+        check(written(*cached.value(), as_svg) == written(symbol.value(), as_svg));
+        check(written(*cached.value(), as_pbm) == written(symbol.value(), as_pbm));
+    }
+
+    auto const registrations = {
+        registration{"clock shards miss unknown keys and hit inserted ones", 
+            clock_shards_miss_unknown_keys_and_hit_inserted_ones},
+        registration{"clock shards keep the first value inserted for a key", 
+            clock_shards_keep_the_first_value_inserted_for_a_key},
+        registration{"clock shards do not store values heavier than the shard", 
+            clock_shards_do_not_store_values_heavier_than_the_shard},
+        registration{"clock shards evict until the weight limit is kept", 
+            clock_shards_evict_until_the_weight_limit_is_kept},
+        registration{"clock shards give referenced slots a second chance", 
+            clock_shards_give_referenced_slots_a_second_chance},
+        registration{"clock shards reuse the slots of evicted entries", 
+            clock_shards_reuse_the_slots_of_evicted_entries},
+        registration{"symbol caches share the symbol of a key and count hits and misses", 
+            symbol_caches_share_the_symbol_of_a_key_and_count_hits_and_misses},
+        registration{"symbol caches do not cache failures", 
+            symbol_caches_do_not_cache_failures},
+        registration{"symbol caches weigh the symbol and both copies of the key", 
+            symbol_caches_weigh_the_symbol_and_both_copies_of_the_key},
+        registration{"symbol caches evict entries beyond their capacity", 
+            symbol_caches_evict_entries_beyond_their_capacity},
+        registration{"cached symbols are written like the symbols they pack", 
+            cached_symbols_are_written_like_the_symbols_they_pack},
+    };
+}
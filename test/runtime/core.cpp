@@ -0,0 +1,127 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <list>
+#include <string>
+#include <string_view>
+
+#include <qrcode/core/core.h>
+#include <qrcode/eci/view.h>
+#include <qrcode/micro_qr/micro_qr.h>
+#include <qrcode/qr/qr.h>
+
+#include "harness.h"
+
+namespace
+{
+    using namespace std::literals;
+    using qrcode::test::check;
+    using qrcode::test::registration;
+
+    // the compiled core has to make exactly the symbols of the templates
+    template<class Core, class Template>
+    auto check_same_result(Core const& core, Template const& nominal)
+    {
+        check(core.has_value() == nominal.has_value());
+        if (core && nominal)
+            check(core.value() == nominal.value());
+        if (!core && !nominal)
+            check(core.error() == nominal.error());
+    }
+
+    auto the_core_makes_the_qr_symbols_of_plain_messages()
+    {
+        using qrcode::qr::error_correction;
+        using qrcode::qr::symbol_version;
+        auto const any_message = "Hello, world! 0123456789"sv;
+
+        check_same_result(
+            qrcode::core::make_qr_symbol<char>(any_message, error_correction::level_Q),
+            qrcode::qr::make_symbol<char>(any_message, error_correction::level_Q));
+        check_same_result(
+            qrcode::core::make_qr_symbol<char>(any_message, error_correction::level_L, symbol_version{7}),
+            qrcode::qr::make_symbol<char>(any_message, symbol_version{7}, error_correction::level_L));
+        check_same_result(
+            qrcode::core::make_qr_symbol(any_message, error_correction::level_H, symbol_version{1}),
+            qrcode::qr::make_symbol(any_message, symbol_version{1}, error_correction::level_H));
+    }
+
+    auto the_core_makes_the_qr_symbols_of_eci_messages()
+    {
+        using qrcode::eci::assignment_number;
+        using qrcode::qr::error_correction;
+        auto const any_message = qrcode::eci::view{assignment_number{9}, "\xC1\xC2\xC3\xC4\xC5"sv};
+
+        check_same_result(
+            qrcode::core::make_qr_symbol<char>(any_message, error_correction::level_M),
+            qrcode::qr::make_symbol<char>(any_message, error_correction::level_M));
+    }
+
+    auto the_core_makes_the_qr_symbols_of_non_contiguous_messages()
+    {
+        using qrcode::qr::error_correction;
+        auto const any_message = std::list<char>{'A', 'B', 'R', 'A', 'C', 'A', 'D', 'A', 'B', 'R', 'A'};
+        auto const nominal_message = std::string{begin(any_message), end(any_message)};
+
+        check_same_result(
+            qrcode::core::make_qr_symbol<char>(any_message, error_correction::level_M),
+            qrcode::qr::make_symbol<char>(nominal_message, error_correction::level_M));
+    }
+
+    auto the_core_makes_the_micro_qr_symbols_of_messages()
+    {
+        using qrcode::micro_qr::error_correction;
+        using qrcode::micro_qr::symbol_version;
+        auto const any_message = "01234567"sv;
+        auto const other_message = std::list<char>{'A', 'B', 'C', '1', '2', '3'};
+        auto const nominal_other_message = std::string{begin(other_message), end(other_message)};
+        auto const too_long_message = std::string(100, '9');
+
+        check_same_result(
+            qrcode::core::make_micro_qr_symbol<char>(any_message, error_correction::level_L),
+            qrcode::micro_qr::make_symbol<char>(any_message, error_correction::level_L));
+        check_same_result(
+            qrcode::core::make_micro_qr_symbol<char>(any_message),
+            qrcode::micro_qr::make_symbol<char>(any_message, std::nullopt));
+        check_same_result(
+            qrcode::core::make_micro_qr_symbol<char>(any_message, error_correction::level_M, symbol_version::M3),
+            qrcode::micro_qr::make_symbol<char>(any_message, symbol_version::M3, error_correction::level_M));
+        check_same_result(
+            qrcode::core::make_micro_qr_symbol<char>(other_message, error_correction::level_L),
+            qrcode::micro_qr::make_symbol<char>(nominal_other_message, error_correction::level_L));
+        check_same_result(
+            qrcode::core::make_micro_qr_symbol<char>(too_long_message, error_correction::level_L),
+            qrcode::micro_qr::make_symbol<char>(too_long_message, error_correction::level_L));
+    }
+
+    auto const registrations = {
+        registration{"the core makes the qr symbols of plain messages", 
+            the_core_makes_the_qr_symbols_of_plain_messages},
+        registration{"the core makes the qr symbols of eci messages", 
+            the_core_makes_the_qr_symbols_of_eci_messages},
+        registration{"the core makes the qr symbols of non contiguous messages", 
+            the_core_makes_the_qr_symbols_of_non_contiguous_messages},
+        registration{"the core makes the micro qr symbols of messages", 
+            the_core_makes_the_micro_qr_symbols_of_messages},
+    };
+}
@@ -0,0 +1,71 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <iostream>
+#include <source_location>
+#include <string_view>
+#include <vector>
+
+// most of the library is tested at compile time within its headers; whatever needs threads,
+// allocations or a compiled library is registered here and run by the runtime test target
+namespace qrcode::test
+{
+    struct test_case
+    {
+        std::string_view name;
+        void (*run)();
+    };
+
+    [[nodiscard]] inline auto test_cases() -> std::vector<test_case>&
+    {
+        static auto cases = std::vector<test_case>{};
+        return cases;
+    }
+
+    [[nodiscard]] inline auto failure_count() -> int&
+    {
+        static auto failures = 0;
+        return failures;
+    }
+
+    struct registration
+    {
+        registration(std::string_view name, void (*run)())
+        {
+            test_cases().push_back({name, run});
+        }
+    };
+
+    // unlike assert, checks are kept in release builds
+    inline auto check(bool condition, std::source_location location = std::source_location::current())
+    {
+        if (condition)
+            return;
+
+        ++failure_count();
+        std::cerr << location.file_name() << ':' << location.line() << ": check failed in " 
+            << location.function_name() << '\n';
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <sstream>
+#include <string>
+
+#include <qrcode/pdf.h>
+
+#include "harness.h"
+
+namespace
+{
+    using qrcode::test::check;
+    using qrcode::test::registration;
+
+    auto pdf_documents_without_symbols_have_one_empty_page()
+    {
+        auto stream = std::ostringstream{};
+        auto writer = qrcode::pdf_writer{stream};
+        writer.finish();
+
+        auto const document = stream.str();
+        check(document.find("/Kids [4 0 R ] /Count 1 ") != std::string::npos);
+        check(document.find("/Type /Page ") != std::string::npos);
+        check(document.ends_with("%%EOF\n"));
+    }
+
+    auto const registrations = {
+        registration{"pdf documents without symbols have one empty page", 
+            pdf_documents_without_symbols_have_one_empty_page},
+    };
+}
@@ -0,0 +1,88 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <vector>
+
+#include <qrcode/qr/mask_pattern.h>
+#include <qrcode/qr/penalty_score.h>
+#include <qrcode/qr/raw_code.h>
+#include <qrcode/qr/static_penalty.h>
+#include <qrcode/structure/module.h>
+
+#include "harness.h"
+
+namespace
+{
+    using qrcode::structure::matrix;
+    using qrcode::structure::module;
+    using qrcode::test::check;
+    using qrcode::test::registration;
+
+    // the data modules are filled with a fixed pseudo random sequence, large versions only
+    // exist at runtime since their layout is too expensive for constant evaluation
+    [[nodiscard]] auto any_code(qrcode::qr::symbol_version version)
+    {
+        using qrcode::structure::module_traits;
+
+        auto const layout = std::make_unique<matrix<module>>(qrcode::qr::make_function_layout<module>(version));
+        auto free_modules = 0;
+        for (auto y = 0; y != height(*layout); ++y)
+            free_modules += static_cast<int>(std::ranges::count_if(row(*layout, y), module_traits<module>::is_free));
+
+        auto state = std::uint32_t{0x9e3779b9u} + static_cast<std::uint32_t>(version.number);
+        auto bits = std::vector<bool>(static_cast<std::size_t>(free_modules));
+        for (auto&& bit : bits)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            bit = (state & 1) != 0;
+        }
+        return std::make_unique<matrix<module>>(qrcode::qr::make_raw_code(*layout, bits));
+    }
+
+    auto static_penalties_leave_the_penalty_scores_of_every_version_unchanged()
+    {
+        auto const unlimited = std::numeric_limits<int>::max();
+        for (auto i = 1; i <= 40; ++i)
+        {
+            auto const code = any_code(qrcode::qr::symbol_version{i});
+            auto const penalty = std::make_unique<qrcode::qr::static_penalty>(qrcode::qr::make_static_penalty(*code));
+
+            for (auto const& mask : qrcode::qr::available_masks())
+            {
+                auto const masked = std::make_unique<matrix<module>>(mask(*code));
+                check(qrcode::qr::penalty_score(*masked, unlimited, *penalty) == qrcode::qr::penalty_score(*masked));
+            }
+        }
+    }
+
+    auto const registrations = {
+        registration{"static penalties leave the penalty scores of every version unchanged", 
+            static_penalties_leave_the_penalty_scores_of_every_version_unchanged},
+    };
+}
@@ -0,0 +1,258 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 2021 Sebastian Bauer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+
+#include <qrcode/pipeline/bounded_queue.h>
+#include <qrcode/pipeline/worker_thread.h>
+#include <qrcode/qr/qr.h>
+#include <qrcode/qr/symbol_pipeline.h>
+
+#include "harness.h"
+
+namespace
+{
+    using qrcode::pipeline::bounded_queue;
+    using qrcode::pipeline::worker_thread;
+    using qrcode::test::check;
+    using qrcode::test::registration;
+
+    auto bounded_queues_round_their_capacity_up_to_a_power_of_two()
+    {
+        check(capacity(bounded_queue<int>{0}) == 2);
+        check(capacity(bounded_queue<int>{2}) == 2);
+        check(capacity(bounded_queue<int>{5}) == 8);
+        check(capacity(bounded_queue<int>{64}) == 64);
+    }
+
+    auto bounded_queues_pop_values_in_the_order_they_were_pushed()
+    {
+        auto queue = bounded_queue<int>{4};
+        check(queue.push(1) && queue.push(2) && queue.push(3));
+
+        check(queue.pop() == 1);
+        check(queue.push(4) && queue.push(5));
+        check(queue.pop() == 2 && queue.pop() == 3 && queue.pop() == 4 && queue.pop() == 5);
+        check(!queue.try_pop());
+    }
+
+    auto bounded_queues_refuse_values_beyond_their_capacity()
+    {
+        auto queue = bounded_queue<int>{2};
+        auto value = 1;
+        check(queue.try_push(value) && queue.try_push(value));
+        check(!queue.try_push(value));
+
+        check(queue.try_pop() == 1);
+        check(queue.try_push(value));
+    }
+
+    auto bounded_queues_are_drained_after_being_closed()
+    {
+        auto queue = bounded_queue<int>{4};
+        check(queue.push(1) && queue.push(2));
+        queue.close();
+
+        check(!queue.push(3));
+        check(queue.pop() == 1 && queue.pop() == 2);
+        check(!queue.pop());
+    }
+
+    auto bounded_queues_move_only_values()
+    {
+        auto queue = bounded_queue<std::unique_ptr<int>>{2};
+        check(queue.push(std::make_unique<int>(7)));
+
+        auto const value = queue.pop();
+        check(value && *value && **value == 7);
+    }
+
+    auto bounded_queues_wake_waiting_consumers_on_close()
+    {
+        auto queue = bounded_queue<int>{2};
+        auto popped = std::atomic<bool>{false};
+        auto consumer = std::jthread{[&] { popped = queue.pop().has_value(); }};
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        queue.close();
+        consumer.join();
+
+        check(!popped);
+    }
+
+    auto bounded_queues_wake_waiting_producers_on_close()
+    {
+        auto queue = bounded_queue<int>{2};
+        check(queue.push(1) && queue.push(2));
+
+        auto pushed = std::atomic<bool>{true};
+        auto producer = std::jthread{[&] { pushed = queue.push(3); }};
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        queue.close();
+        producer.join();
+
+        check(!pushed);
+    }
+
+    auto bounded_queues_hand_every_value_to_exactly_one_consumer()
+    {
+        constexpr auto producer_count = 4;
+        constexpr auto consumer_count = 4;
+        constexpr auto values_per_producer = 20000;
+
+        auto queue = bounded_queue<int>{8};
+        auto seen = std::vector<std::atomic<int>>(producer_count * values_per_producer);
+        {
+            auto consumers = std::vector<std::jthread>{};
+            for (auto i = 0; i != consumer_count; ++i)
+                consumers.emplace_back([&] 
+                { 
+                    while (auto value = queue.pop())
+                        seen[static_cast<std::size_t>(*value)].fetch_add(1);
+                });
+
+            auto producers = std::vector<std::jthread>{};
+            for (auto i = 0; i != producer_count; ++i)
+                producers.emplace_back([&, i] 
+                { 
+                    for (auto j = 0; j != values_per_producer; ++j)
+                        static_cast<void>(queue.push(i * values_per_producer + j));
+                });
+
+            for (auto& i : producers)
+                i.join();
+            queue.close();
+        }
+
+        check(std::ranges::all_of(seen, [](auto const& count) { return count.load() == 1; }));
+    }
+
+    auto worker_threads_run_their_function_before_they_are_joined()
+    {
+        auto runs = std::atomic<int>{0};
+        {
+            auto workers = std::vector<worker_thread>{};
+            for (auto i = 0; i != 4; ++i)
+                workers.emplace_back([&runs] { ++runs; });
+            workers.front().join();
+            auto moved = std::move(workers.back());
+        }
+        check(runs.load() == 4);
+    }
+
+    auto worker_threads_get_the_requested_stack_size()
+    {
+#if defined(__linux__)
+        auto const requested = std::size_t{4} << 20;
+        auto size = std::size_t{0};
+        {
+            auto const worker = worker_thread{[&size]
+            {
+                auto attributes = pthread_attr_t{};
+                pthread_getattr_np(pthread_self(), &attributes);
+                pthread_attr_getstacksize(&attributes, &size);
+                pthread_attr_destroy(&attributes);
+            }, requested};
+        }
+        check(size >= requested);
+#endif
+    }
+
+    auto worker_threads_make_symbols_of_the_highest_version_on_their_default_stack()
+    {
+        using qrcode::qr::error_correction;
+
+        auto version = 0;
+        {
+            auto const worker = worker_thread{[&version]
+            {
+                auto const symbol = qrcode::qr::make_symbol<char>(std::string(2900, 'x'), error_correction::level_L);
+                version = symbol ? qrcode::version(symbol.value()).number : 0;
+            }};
+        }
+        check(version == 40);
+    }
+
+    auto symbol_pipelines_make_the_same_symbols_as_make_symbol()
+    {
+        using qrcode::qr::error_correction;
+
+        auto const messages = std::vector<std::string>{"ABRACADABRA", "01234567", "Hello, world!", 
+            std::string(3000, 'x')};
+
+        auto pipeline = qrcode::qr::symbol_pipeline<char>{error_correction::level_M, {.queue_capacity = 2}};
+        for (auto const& i : messages)
+            check(pipeline.push(i).has_value());
+        pipeline.close();
+
+        auto count = std::size_t{0};
+        for (auto const& [index, symbol] : pipeline.results())
+        {
+            auto const nominal = qrcode::qr::make_symbol<char>(messages[index], error_correction::level_M);
+            check(symbol.has_value() == nominal.has_value());
+            if (symbol && nominal)
+                check(symbol.value() == nominal.value());
+            ++count;
+        }
+        check(count == messages.size());
+    }
+
+    auto const registrations = {
+        registration{"bounded queues round their capacity up to a power of two", 
+            bounded_queues_round_their_capacity_up_to_a_power_of_two},
+        registration{"bounded queues pop values in the order they were pushed", 
+            bounded_queues_pop_values_in_the_order_they_were_pushed},
+        registration{"bounded queues refuse values beyond their capacity", 
+            bounded_queues_refuse_values_beyond_their_capacity},
+        registration{"bounded queues are drained after being closed", 
+            bounded_queues_are_drained_after_being_closed},
+        registration{"bounded queues move only values", 
+            bounded_queues_move_only_values},
+        registration{"bounded queues wake waiting consumers on close", 
+            bounded_queues_wake_waiting_consumers_on_close},
+        registration{"bounded queues wake waiting producers on close", 
+            bounded_queues_wake_waiting_producers_on_close},
+        registration{"bounded queues hand every value to exactly one consumer", 
+            bounded_queues_hand_every_value_to_exactly_one_consumer},
+        registration{"worker threads run their function before they are joined", 
+            worker_threads_run_their_function_before_they_are_joined},
+        registration{"worker threads get the requested stack size", 
+            worker_threads_get_the_requested_stack_size},
+        registration{"worker threads make symbols of the highest version on their default stack", 
+            worker_threads_make_symbols_of_the_highest_version_on_their_default_stack},
+        registration{"symbol pipelines make the same symbols as make_symbol", 
+            symbol_pipelines_make_the_same_symbols_as_make_symbol},
+    };
+}